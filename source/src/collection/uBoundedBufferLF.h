@@ -0,0 +1,216 @@
+//                              -*- Mode: C++ -*-
+//
+// uC++ Version 7.0.0, Copyright (C) Peter A. Buhr 2026
+//
+// uBoundedBufferLF.h -- Generic bounded buffer using a lock-free ring and semaphores for blocking
+//
+// Author           : agent
+// Created On       : Mon Oct 19 01:37:42 2026
+// Last Modified By : agent
+// Last Modified On : Mon Oct 19 01:37:42 2026
+// Update Count     : 1
+//
+// This  library is free  software; you  can redistribute  it and/or  modify it
+// under the terms of the GNU Lesser General Public License as published by the
+// Free Software  Foundation; either  version 2.1 of  the License, or  (at your
+// option) any later version.
+//
+// This library is distributed in the  hope that it will be useful, but WITHOUT
+// ANY  WARRANTY;  without even  the  implied  warranty  of MERCHANTABILITY  or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+// for more details.
+//
+// You should  have received a  copy of the  GNU Lesser General  Public License
+// along  with this library.
+//
+
+
+#pragma once
+
+
+#include <uSemaphore.h>
+
+
+// A uBoundedBufferLF<ElemType> has the same interface as uBoundedBuffer<ElemType>, but is not a monitor. Producers and
+// consumers claim elements of a circular array with a compare-and-assign on the back or front position, and each
+// element has a sequence number telling whether it is ready to be filled or emptied at the current position (Vyukov).
+// Hence, producers and consumers only contend among themselves, and only on different cache lines.
+
+// A task blocks only when the buffer is actually full or empty: it retries for a short time, and then announces itself
+// in a waiting count and parks on a semaphore. A task that makes progress for the other side only signals the semaphore
+// when the waiting count is non-zero, so the common case makes no kernel calls. The buffer size is rounded up to a
+// power of 2.
+
+template<typename ElemType> class uBoundedBufferLF {
+	enum { CacheLine = 64 };
+	#ifdef __U_MULTI__
+	enum { Spin = 128 };								// retries before parking
+	#else
+	enum { Spin = 0 };									// no other processor can make progress while spinning
+	#endif // __U_MULTI__
+
+	struct Cell {
+		size_t seq;										// position the element is ready for
+		ElemType elem;
+	};
+
+	Cell * cells;
+	size_t mask;										// buffer size - 1
+	size_t back __attribute__(( aligned( CacheLine ) )); // next insert position
+	size_t front __attribute__(( aligned( CacheLine ) )); // next remove position
+	int prodWaiting __attribute__(( aligned( CacheLine ) )), consWaiting; // announced, blocking tasks
+	uSemaphore prodPark, consPark;
+
+	// Unblock up to n of the tasks announced in waiting. Called after a successful operation, which must be ordered
+	// before reading the waiting count to pair with the fence in park.
+	static void wake( int & waiting, uSemaphore & sem, size_t n ) {
+		__atomic_thread_fence( __ATOMIC_SEQ_CST );
+		for ( int w = __atomic_load_n( &waiting, __ATOMIC_RELAXED ); w > 0 && n > 0; w = __atomic_load_n( &waiting, __ATOMIC_RELAXED ) ) {
+			int m = (size_t)w < n ? w : n;
+			if ( uCompareAssign( waiting, w, w - m ) ) { sem.V( m ); break; } // claim m announcements
+		} // for
+	} // uBoundedBufferLF::wake
+
+	// Withdraw an announcement after the operation succeeded. If a waker has already claimed all the announcements,
+	// one of the claims is for this task, so absorb the semaphore signal that is coming.
+	static void withdraw( int & waiting, uSemaphore & sem ) {
+		for ( int w = __atomic_load_n( &waiting, __ATOMIC_RELAXED ); ; w = __atomic_load_n( &waiting, __ATOMIC_RELAXED ) ) {
+			if ( w == 0 ) { sem.P(); break; }
+			if ( uCompareAssign( waiting, w, w - 1 ) ) break;
+		} // for
+	} // uBoundedBufferLF::withdraw
+
+	// Retry operation, then park until the other side makes progress. Retrying after announcing ensures a waker
+	// either sees the announcement or this task sees the waker's progress.
+	template<typename Op> static void park( int & waiting, uSemaphore & sem, Op op ) {
+		for ( ;; ) {
+			for ( unsigned int s = 0; s < Spin; s += 1 ) {
+				if ( op() ) return;
+				uPause();
+			} // for
+			__atomic_fetch_add( &waiting, 1, __ATOMIC_SEQ_CST );
+			__atomic_thread_fence( __ATOMIC_SEQ_CST );
+			if ( op() ) { withdraw( waiting, sem ); return; }
+			sem.P();
+		} // for
+	} // uBoundedBufferLF::park
+  public:
+	uBoundedBufferLF( const uBoundedBufferLF & ) = delete; // no copy
+	uBoundedBufferLF( uBoundedBufferLF && ) = delete;
+	uBoundedBufferLF & operator=( const uBoundedBufferLF & ) = delete; // no assignment
+	uBoundedBufferLF & operator=( uBoundedBufferLF && ) = delete;
+
+	uBoundedBufferLF( const int size = 10 ) : prodPark( 0 ), consPark( 0 ) {
+		size_t cap;
+		for ( cap = 1; cap < (size_t)size; cap *= 2 );
+		mask = cap - 1;
+		cells = new Cell[cap];
+		for ( size_t i = 0; i < cap; i += 1 ) cells[i].seq = i;
+		front = back = 0;
+		prodWaiting = consWaiting = 0;
+	} // uBoundedBufferLF::uBoundedBufferLF
+
+	~uBoundedBufferLF() {
+		delete [] cells;
+	} // uBoundedBufferLF::~uBoundedBufferLF
+
+	// Number of elements in the buffer, which is only a snapshot when there are concurrent operations.
+	int query() const {
+		size_t f = __atomic_load_n( &front, __ATOMIC_RELAXED );
+		size_t b = __atomic_load_n( &back, __ATOMIC_RELAXED );
+		return (ptrdiff_t)(b - f) < 0 ? 0 : (int)(b - f);		// front may be read before back moves
+	} // uBoundedBufferLF::query
+
+	bool tryInsert( ElemType elem );					// false => full
+	bool tryRemove( ElemType & elem );					// false => empty
+	void insert( ElemType elem );
+	ElemType remove();
+	void insert( const ElemType elems[], size_t n );	// insert all
+	size_t remove( ElemType elems[], size_t n );		// remove at least 1 and at most n
+}; // uBoundedBufferLF
+
+
+template<typename ElemType> inline bool uBoundedBufferLF<ElemType>::tryInsert( ElemType elem ) {
+	size_t pos = __atomic_load_n( &back, __ATOMIC_RELAXED );
+	Cell * cell;
+	for ( ;; ) {
+		cell = &cells[pos & mask];
+		ptrdiff_t diff = __atomic_load_n( &cell->seq, __ATOMIC_ACQUIRE ) - pos;
+		if ( diff == 0 ) {								// empty cell ?
+			if ( __atomic_compare_exchange_n( &back, &pos, pos + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED ) ) break;
+		} else if ( diff < 0 ) {						// not yet removed from previous round => full
+			return false;
+		} else {										// another producer claimed pos
+			pos = __atomic_load_n( &back, __ATOMIC_RELAXED );
+		} // if
+	} // for
+	cell->elem = elem;
+	__atomic_store_n( &cell->seq, pos + 1, __ATOMIC_RELEASE ); // ready for removal at pos
+	return true;
+} // uBoundedBufferLF::tryInsert
+
+template<typename ElemType> inline bool uBoundedBufferLF<ElemType>::tryRemove( ElemType & elem ) {
+	size_t pos = __atomic_load_n( &front, __ATOMIC_RELAXED );
+	Cell * cell;
+	for ( ;; ) {
+		cell = &cells[pos & mask];
+		ptrdiff_t diff = __atomic_load_n( &cell->seq, __ATOMIC_ACQUIRE ) - (pos + 1);
+		if ( diff == 0 ) {								// full cell ?
+			if ( __atomic_compare_exchange_n( &front, &pos, pos + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED ) ) break;
+		} else if ( diff < 0 ) {						// not yet inserted => empty
+			return false;
+		} else {										// another consumer claimed pos
+			pos = __atomic_load_n( &front, __ATOMIC_RELAXED );
+		} // if
+	} // for
+	elem = cell->elem;
+	__atomic_store_n( &cell->seq, pos + mask + 1, __ATOMIC_RELEASE ); // ready for insertion in next round
+	return true;
+} // uBoundedBufferLF::tryRemove
+
+template<typename ElemType> inline void uBoundedBufferLF<ElemType>::insert( ElemType elem ) {
+	if ( ! tryInsert( elem ) ) {						// buffer full ?
+		park( prodWaiting, prodPark, [this, &elem]() { return tryInsert( elem ); } );
+	} // if
+	wake( consWaiting, consPark, 1 );
+} // uBoundedBufferLF::insert
+
+template<typename ElemType> inline ElemType uBoundedBufferLF<ElemType>::remove() {
+	ElemType elem;
+
+	if ( ! tryRemove( elem ) ) {						// buffer empty ?
+		park( consWaiting, consPark, [this, &elem]() { return tryRemove( elem ); } );
+	} // if
+	wake( prodWaiting, prodPark, 1 );
+	return elem;
+} // uBoundedBufferLF::remove
+
+// Consumers are woken once for each run of insertions rather than once per element.
+template<typename ElemType> void uBoundedBufferLF<ElemType>::insert( const ElemType elems[], size_t n ) {
+	size_t i = 0;
+	for ( ;; ) {
+		size_t start = i;
+		for ( ; i < n && tryInsert( elems[i] ); i += 1 );
+		wake( consWaiting, consPark, i - start );
+	  if ( i == n ) break;
+		insert( elems[i] );								// buffer full, block
+		i += 1;
+	} // for
+} // uBoundedBufferLF::insert
+
+// Producers are woken once for all the removed elements.
+template<typename ElemType> size_t uBoundedBufferLF<ElemType>::remove( ElemType elems[], size_t n ) {
+	if ( n == 0 ) return 0;
+	if ( ! tryRemove( elems[0] ) ) {					// buffer empty ?
+		park( consWaiting, consPark, [this, elems]() { return tryRemove( elems[0] ); } );
+	} // if
+	size_t i;
+	for ( i = 1; i < n && tryRemove( elems[i] ); i += 1 );
+	wake( prodWaiting, prodPark, i );
+	return i;
+} // uBoundedBufferLF::remove
+
+
+// Local Variables: //
+// compile-command: "make install" //
+// End: //
@@ -0,0 +1,305 @@
+//                              -*- Mode: C++ -*-
+//
+// uC++ Version 7.0.0, Copyright (C) Peter A. Buhr 2026
+//
+// uHashMap.h -- Concurrent hash map with lock-free reads and incremental resizing
+//
+// Author           : agent
+// Created On       : Mon Oct 19 01:51:27 2026
+// Last Modified By : agent
+// Last Modified On : Mon Oct 19 01:51:27 2026
+// Update Count     : 1
+//
+// This  library is free  software; you  can redistribute  it and/or  modify it
+// under the terms of the GNU Lesser General Public License as published by the
+// Free Software  Foundation; either  version 2.1 of  the License, or  (at your
+// option) any later version.
+//
+// This library is distributed in the  hope that it will be useful, but WITHOUT
+// ANY  WARRANTY;  without even  the  implied  warranty  of MERCHANTABILITY  or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+// for more details.
+//
+// You should  have received a  copy of the  GNU Lesser General  Public License
+// along  with this library.
+//
+
+
+#pragma once
+
+
+#include <uEpoch.h>
+#include <functional>									// hash
+#include <cstdint>										// uintptr_t, uint64_t
+
+
+// A uHashMap<K,V> is a hash table with separate chaining shared by tasks on any number of processors. Lookups take no
+// locks: they traverse a chain inside a uEpoch::Guard, and nodes are never modified after they are linked, so a
+// replaced or erased node is unlinked and retired to uEpoch. Hence, copying a V must not block. Updates lock one of a
+// fixed number of stripes, chosen by the low-order bits of the hash. A stripe is held briefly, so a task that finds it
+// locked spins for a short time and then yields to the uC++ scheduler rather than spinning on the processor.
+
+// When the table is too full, a table twice the size is linked to the current table and updates move the buckets to it
+// a chunk at a time, so no operation waits for the whole table to be copied. A moved bucket is marked, and operations
+// finding the mark continue in the next table. The number of buckets is never less than the number of stripes, so a
+// bucket and the buckets it moves to are covered by the same stripe.
+
+template<typename K, typename V, typename Hash = std::hash<K>> class uHashMap {
+	struct Node : public uReclaimable {
+		Node * volatile next;
+		const size_t hash;
+		const K key;
+		const V value;
+
+		Node( size_t hash, const K & key, const V & value ) : next( nullptr ), hash( hash ), key( key ), value( value ) {}
+	}; // Node
+
+	struct Table : public uReclaimable {
+		const size_t mask;								// buckets - 1
+		Node * volatile * const buckets;
+		Table * volatile next;							// larger table during resizing
+		volatile size_t claimed, done;					// buckets claimed and finished moving to next
+
+		Table( size_t size ) : mask( size - 1 ), buckets( new Node * volatile[size]() ), next( nullptr ), claimed( 0 ), done( 0 ) {}
+		~Table() { delete [] buckets; }
+	}; // Table
+
+	struct __attribute__(( aligned( 64 ) )) Stripe {
+		volatile bool locked;
+		size_t count;									// elements in the stripe's buckets
+	}; // Stripe
+
+	enum { Chunk = 16 };								// buckets moved at a time
+	#ifdef __U_MULTI__
+	enum { Spin = 64 };									// lock attempts before yielding
+	#else
+	enum { Spin = 0 };									// no other processor can release the lock
+	#endif // __U_MULTI__
+
+	static Node * moved() { return (Node *)(uintptr_t)1; } // bucket moved to next table
+
+	Hash hasher;
+	Table * volatile table;								// current table
+	Stripe * stripes;
+	size_t stripeMask;
+
+	size_t hash( const K & key ) const {				// spread bits for masking (murmur3 finalizer)
+		uint64_t h = hasher( key );
+		h ^= h >> 33;
+		h *= 0xff51afd7ed558ccdULL;
+		h ^= h >> 33;
+		h *= 0xc4ceb9fe1a85ec53ULL;
+		h ^= h >> 33;
+		return h;
+	} // uHashMap::hash
+
+	Stripe & stripe( size_t h ) const { return stripes[h & stripeMask]; }
+
+	static void acquire( Stripe & s ) {
+		for ( unsigned int spin = 0; __atomic_test_and_set( &s.locked, __ATOMIC_ACQUIRE ); spin += 1 ) {
+			if ( spin < Spin ) uPause();
+			else uThisTask().yield();
+		} // for
+	} // uHashMap::acquire
+
+	static void release( Stripe & s ) {
+		__atomic_clear( &s.locked, __ATOMIC_RELEASE );
+	} // uHashMap::release
+
+	// Return the link to the bucket for h in the first table where the bucket has not moved. Pre: in guard and stripe
+	// for h locked, so the bucket cannot move.
+	Node * volatile & bucket( size_t h ) const {
+		Table * t = __atomic_load_n( &table, __ATOMIC_ACQUIRE );
+		for ( ;; ) {
+			Node * volatile & b = t->buckets[h & t->mask];
+		  if ( __atomic_load_n( &b, __ATOMIC_ACQUIRE ) != moved() ) return b;
+			t = __atomic_load_n( &t->next, __ATOMIC_ACQUIRE );
+		} // for
+	} // uHashMap::bucket
+
+	// Return the link to the node with key in the chain starting at link, or the last link.
+	static Node * volatile * search( Node * volatile * link, size_t h, const K & key ) {
+		for ( Node * n; ( n = *link ) != nullptr; link = &n->next ) {
+		  if ( n->hash == h && n->key == key ) break;
+		} // for
+		return link;
+	} // uHashMap::search
+
+	// Copy a bucket of table t into the two buckets of the next table it splits into, and mark it moved. The copies are
+	// new nodes, so tasks traversing the old chain are unaffected, and the old nodes are retired.
+	void move( Table * t, size_t i ) {
+		Table * next = t->next;
+		Stripe & s = stripe( i );						// stripe(i) == stripe(hash) for the bucket's nodes
+		acquire( s );
+		Node * old = t->buckets[i], * lists[2] = { nullptr, nullptr };
+		for ( Node * n = old; n != nullptr; n = n->next ) {
+			Node * c = new Node( n->hash, n->key, n->value );
+			unsigned int half = ( n->hash & ( t->mask + 1 ) ) != 0;
+			c->next = lists[half];
+			lists[half] = c;
+		} // for
+		__atomic_store_n( &next->buckets[i], lists[0], __ATOMIC_RELEASE );
+		__atomic_store_n( &next->buckets[i + t->mask + 1], lists[1], __ATOMIC_RELEASE );
+		__atomic_store_n( &t->buckets[i], moved(), __ATOMIC_RELEASE ); // publish after copies
+		release( s );
+		for ( Node * n = old; n != nullptr; ) {
+			Node * nn = n->next;
+			uEpoch::retire( n );
+			n = nn;
+		} // for
+	} // uHashMap::move
+
+	// Move a chunk of buckets if a resize is in progress. The task moving the last chunk makes the next table current
+	// and retires the old one, which cannot happen while any chunk is claimed but unfinished.
+	void help() {
+		Table * t;
+		size_t start;
+		{
+			uEpoch::Guard guard;
+			t = __atomic_load_n( &table, __ATOMIC_ACQUIRE );
+		  if ( __atomic_load_n( &t->next, __ATOMIC_ACQUIRE ) == nullptr ) return; // not resizing ?
+		  if ( __atomic_load_n( &t->claimed, __ATOMIC_RELAXED ) > t->mask ) return; // all claimed ?
+			start = __atomic_fetch_add( &t->claimed, (size_t)Chunk, __ATOMIC_ACQ_REL );
+		  if ( start > t->mask ) return;
+		}
+		size_t end = start + Chunk <= t->mask + 1 ? start + Chunk : t->mask + 1;
+		for ( size_t i = start; i < end; i += 1 ) move( t, i );
+		if ( __atomic_add_fetch( &t->done, end - start, __ATOMIC_ACQ_REL ) == t->mask + 1 ) { // last chunk ?
+			__atomic_store_n( &table, t->next, __ATOMIC_RELEASE );
+			uEpoch::retire( t );
+		} // if
+	} // uHashMap::help
+
+	// Start doubling the table if the stripe's share of the elements exceeds its share of the current table.
+	void grow( size_t count ) {
+		size_t size;
+		{
+			uEpoch::Guard guard;
+			Table * t = __atomic_load_n( &table, __ATOMIC_ACQUIRE );
+		  if ( count * ( stripeMask + 1 ) <= t->mask + 1 || __atomic_load_n( &t->next, __ATOMIC_RELAXED ) != nullptr ) return;
+			size = t->mask + 1;
+		}
+		Table * next = new Table( size * 2 ), * none = nullptr;
+		bool started = false;
+		{
+			uEpoch::Guard guard;
+			Table * t = __atomic_load_n( &table, __ATOMIC_ACQUIRE );
+			if ( t->mask + 1 == size ) {				// table not replaced meanwhile ?
+				started = __atomic_compare_exchange_n( &t->next, &none, next, false, __ATOMIC_RELEASE, __ATOMIC_RELAXED );
+			} // if
+		}
+		if ( ! started ) delete next;					// another task started resizing
+	} // uHashMap::grow
+  public:
+	uHashMap( const uHashMap & ) = delete;				// no copy
+	uHashMap( uHashMap && ) = delete;
+	uHashMap & operator=( const uHashMap & ) = delete;	// no assignment
+	uHashMap & operator=( uHashMap && ) = delete;
+
+	// Initial buckets and stripes, both rounded up to a power of 2.
+	uHashMap( size_t size = 64, size_t noOfStripes = 64 ) {
+		for ( stripeMask = 1; stripeMask < noOfStripes; stripeMask *= 2 );
+		size_t buckets;
+		for ( buckets = stripeMask; buckets < size; buckets *= 2 );
+		stripes = new Stripe[stripeMask]();
+		stripeMask -= 1;
+		table = new Table( buckets );
+	} // uHashMap::uHashMap
+
+	~uHashMap() {										// pre: no concurrent operations
+		for ( Table * t = table; t != nullptr; ) {
+			for ( size_t i = 0; i <= t->mask; i += 1 ) {
+			  if ( t->buckets[i] == moved() ) continue;
+				for ( Node * n = t->buckets[i]; n != nullptr; ) {
+					Node * next = n->next;
+					delete n;
+					n = next;
+				} // for
+			} // for
+			Table * next = t->next;
+			delete t;
+			t = next;
+		} // for
+		delete [] stripes;
+	} // uHashMap::~uHashMap
+
+	// Number of elements, which is only a snapshot when there are concurrent updates.
+	size_t size() const {
+		size_t cnt = 0;
+		for ( size_t i = 0; i <= stripeMask; i += 1 ) cnt += __atomic_load_n( &stripes[i].count, __ATOMIC_RELAXED );
+		return cnt;
+	} // uHashMap::size
+
+	bool empty() const {
+		return size() == 0;
+	} // uHashMap::empty
+
+	bool find( const K & key, V & value ) const {		// false => key not present
+		size_t h = hash( key );
+		uEpoch::Guard guard;
+		Table * t = __atomic_load_n( &table, __ATOMIC_ACQUIRE );
+		Node * n;
+		for ( ;; ) {
+			n = __atomic_load_n( &t->buckets[h & t->mask], __ATOMIC_ACQUIRE );
+		  if ( n != moved() ) break;
+			t = __atomic_load_n( &t->next, __ATOMIC_ACQUIRE );
+		} // for
+		for ( ; n != nullptr; n = __atomic_load_n( &n->next, __ATOMIC_ACQUIRE ) ) {
+			if ( n->hash == h && n->key == key ) {
+				value = n->value;
+				return true;
+			} // if
+		} // for
+		return false;
+	} // uHashMap::find
+
+	bool contains( const K & key ) const {
+		V value;
+		return find( key, value );
+	} // uHashMap::contains
+
+	bool insert( const K & key, const V & value ) {		// add or replace, true => added
+		size_t h = hash( key );
+		Node * n = new Node( h, key, value ), * old;
+		Stripe & s = stripe( h );
+		acquire( s );
+		{
+			uEpoch::Guard guard;
+			Node * volatile * link = search( &bucket( h ), h, key );
+			old = *link;
+			n->next = old != nullptr ? old->next : nullptr;
+			__atomic_store_n( link, n, __ATOMIC_RELEASE ); // publish complete node
+		}
+		if ( old == nullptr ) s.count += 1;
+		size_t count = s.count;
+		release( s );
+		if ( old != nullptr ) uEpoch::retire( old );
+		help();
+		grow( count );
+		return old == nullptr;
+	} // uHashMap::insert
+
+	bool erase( const K & key ) {						// false => key not present
+		size_t h = hash( key );
+		Node * old;
+		Stripe & s = stripe( h );
+		acquire( s );
+		{
+			uEpoch::Guard guard;
+			Node * volatile * link = search( &bucket( h ), h, key );
+			old = *link;
+			if ( old != nullptr ) __atomic_store_n( link, old->next, __ATOMIC_RELEASE ); // unlink
+		}
+		if ( old != nullptr ) s.count -= 1;
+		release( s );
+	  if ( old == nullptr ) return false;
+		uEpoch::retire( old );
+		help();
+		return true;
+	} // uHashMap::erase
+}; // uHashMap
+
+
+// Local Variables: //
+// compile-command: "make install" //
+// End: //
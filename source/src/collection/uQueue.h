@@ -37,6 +37,7 @@
 // instead of being null.
 
 template<typename T> class uQueue : public uCollection<T> {
+	template<typename U> friend class uStack;			// access: root, last
   protected:
 	using uCollection<T>::root;
 
@@ -0,0 +1,172 @@
+//                              -*- Mode: C++ -*-
+//
+// uC++ Version 7.0.0, Copyright (C) Peter A. Buhr 2026
+//
+// uQueueLF.h -- Lock-free queue and stack of values with safe memory reclamation
+//
+// Author           : agent
+// Created On       : Mon Oct 19 01:49:07 2026
+// Last Modified By : agent
+// Last Modified On : Mon Oct 19 01:49:07 2026
+// Update Count     : 1
+//
+// This  library is free  software; you  can redistribute  it and/or  modify it
+// under the terms of the GNU Lesser General Public License as published by the
+// Free Software  Foundation; either  version 2.1 of  the License, or  (at your
+// option) any later version.
+//
+// This library is distributed in the  hope that it will be useful, but WITHOUT
+// ANY  WARRANTY;  without even  the  implied  warranty  of MERCHANTABILITY  or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+// for more details.
+//
+// You should  have received a  copy of the  GNU Lesser General  Public License
+// along  with this library.
+//
+
+
+#pragma once
+
+
+#include <uEpoch.h>
+
+
+// A uQueueLF<T> is a FIFO queue of values of type T (Michael and Scott). The head node is a dummy, whose successor holds
+// the first value, and a removed dummy is retired to uEpoch, so other tasks can still traverse it. T must be default
+// constructible for the dummy, and copying a T must not block, because the value is copied inside a uEpoch::Guard.
+
+template<typename T> class uQueueLF {
+	struct Node : public uReclaimable {
+		Node * volatile next;
+		T value;
+
+		Node() : next( nullptr ) {}
+		Node( const T & value ) : next( nullptr ), value( value ) {}
+	}; // Node
+
+	enum { CacheLine = 64 };
+	Node * volatile head __attribute__(( aligned( CacheLine ) )); // dummy node
+	Node * volatile tail __attribute__(( aligned( CacheLine ) ));
+  public:
+	uQueueLF( const uQueueLF & ) = delete;				// no copy
+	uQueueLF( uQueueLF && ) = delete;
+	uQueueLF & operator=( const uQueueLF & ) = delete;	// no assignment
+	uQueueLF & operator=( uQueueLF && ) = delete;
+
+	uQueueLF() {
+		head = tail = new Node;
+	} // uQueueLF::uQueueLF
+
+	~uQueueLF() {										// pre: no concurrent operations
+		for ( Node * n = head; n != nullptr; ) {
+			Node * next = n->next;
+			delete n;
+			n = next;
+		} // for
+	} // uQueueLF::~uQueueLF
+
+	bool empty() const {
+		uEpoch::Guard guard;
+		return __atomic_load_n( &__atomic_load_n( &head, __ATOMIC_ACQUIRE )->next, __ATOMIC_ACQUIRE ) == nullptr;
+	} // uQueueLF::empty
+
+	void push( const T & value ) {
+		Node * n = new Node( value );
+		uEpoch::Guard guard;
+		for ( ;; ) {
+			Node * t = __atomic_load_n( &tail, __ATOMIC_ACQUIRE );
+			Node * next = __atomic_load_n( &t->next, __ATOMIC_ACQUIRE );
+		  if ( t != __atomic_load_n( &tail, __ATOMIC_ACQUIRE ) ) continue; // tail moved ?
+			if ( next == nullptr ) {					// t is last ?
+				if ( uCompareAssign( t->next, next, n ) ) { // link at end
+					uCompareAssign( tail, t, n );		// failure => another task advanced tail
+					return;
+				} // if
+			} else {
+				uCompareAssign( tail, t, next );		// help advance lagging tail
+			} // if
+		} // for
+	} // uQueueLF::push
+
+	bool pop( T & value ) {								// false => empty
+		Node * h;
+		{
+			uEpoch::Guard guard;
+			for ( ;; ) {
+				h = __atomic_load_n( &head, __ATOMIC_ACQUIRE );
+				Node * t = __atomic_load_n( &tail, __ATOMIC_ACQUIRE );
+				Node * next = __atomic_load_n( &h->next, __ATOMIC_ACQUIRE );
+			  if ( h != __atomic_load_n( &head, __ATOMIC_ACQUIRE ) ) continue; // head moved ?
+			  if ( next == nullptr ) return false;		// empty ?
+				if ( h == t ) {							// tail lagging ?
+					uCompareAssign( tail, t, next );
+					continue;
+				} // if
+				value = next->value;					// copy before next can become a retired dummy
+			  if ( uCompareAssign( head, h, next ) ) break; // next is new dummy
+			} // for
+		}
+		uEpoch::retire( h );							// outside guard, so reclaiming can delete
+		return true;
+	} // uQueueLF::pop
+}; // uQueueLF
+
+
+// A uStackLFR<T> is a LIFO stack of values of type T (Treiber). Unlike StackLF, nodes are allocated by the stack and
+// deleted after they are popped, which is safe because a task protects the top node with a hazard pointer before
+// reading its link, and a protected node is neither deleted nor reused, which also prevents ABA.
+
+template<typename T> class uStackLFR {
+	struct Node : public uReclaimable {
+		Node * next;
+		T value;
+
+		Node( const T & value ) : value( value ) {}
+	}; // Node
+
+	Node * volatile top;
+  public:
+	uStackLFR( const uStackLFR & ) = delete;			// no copy
+	uStackLFR( uStackLFR && ) = delete;
+	uStackLFR & operator=( const uStackLFR & ) = delete; // no assignment
+	uStackLFR & operator=( uStackLFR && ) = delete;
+
+	uStackLFR() : top( nullptr ) {}
+
+	~uStackLFR() {										// pre: no concurrent operations
+		for ( Node * n = top; n != nullptr; ) {
+			Node * next = n->next;
+			delete n;
+			n = next;
+		} // for
+	} // uStackLFR::~uStackLFR
+
+	bool empty() const {
+		return __atomic_load_n( &top, __ATOMIC_RELAXED ) == nullptr;
+	} // uStackLFR::empty
+
+	void push( const T & value ) {
+		Node * n = new Node( value );
+		n->next = __atomic_load_n( &top, __ATOMIC_RELAXED );
+		while ( ! __atomic_compare_exchange_n( &top, &n->next, n, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED ) ); // failure updates n->next
+	} // uStackLFR::push
+
+	bool pop( T & value ) {								// false => empty
+		uHazardPointer hazard;
+		Node * t;
+		for ( ;; ) {
+			t = hazard.protect( top );
+		  if ( t == nullptr ) return false;				// empty ?
+		  if ( uCompareAssign( top, t, t->next ) ) break;
+		} // for
+		hazard.clear();
+		value = t->value;								// popping task owns t
+		uHazardPointer::retire( t );
+		return true;
+	} // uStackLFR::pop
+}; // uStackLFR
+
+
+// Local Variables: //
+// compile-command: "make install" //
+// End: //
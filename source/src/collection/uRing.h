@@ -0,0 +1,239 @@
+//                              -*- Mode: C++ -*-
+//
+// uC++ Version 7.0.0, Copyright (C) Peter A. Buhr 2026
+//
+// uRing.h --
+//
+// Author           : agent
+// Created On       : Mon Oct 19 01:31:10 2026
+// Last Modified By : agent
+// Last Modified On : Mon Oct 19 06:02:50 2026
+// Update Count     : 3
+//
+// This  library is free  software; you  can redistribute  it and/or  modify it
+// under the terms of the GNU Lesser General Public License as published by the
+// Free Software  Foundation; either  version 2.1 of  the License, or  (at your
+// option) any later version.
+//
+// This library is distributed in the  hope that it will be useful, but WITHOUT
+// ANY  WARRANTY;  without even  the  implied  warranty  of MERCHANTABILITY  or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+// for more details.
+//
+// You should  have received a  copy of the  GNU Lesser General  Public License
+// along  with this library.
+//
+
+
+#pragma once
+
+
+#include "uSequence.h"
+#include <cstdint>										// uintptr_t
+
+
+// A uRing<T> is a deque of pointers to elements of class T, which must be a public descendant of uSeqable, stored in a
+// circular array. Like a uSequence<T>, elements can be added and removed at either end, and removed anywhere, but
+// scanning the elements reads consecutive array entries rather than following the next pointers through the elements,
+// so the elements ahead of the scan can be prefetched.
+
+// An element's position in the array is stored in its back field, so remove leaves a hole in the array that is skipped
+// when it reaches an end. While an element is in a uRing, its next field points at itself, so listed() is true. Positions
+// increase without wrapping, and the array index is the position modulo the array size, a power of 2. When the array
+// is full, it is compacted, and doubled if more than half full, which changes the positions.
+
+// Costs: adding is amortized O(1), as a full array is compacted in O(array size). Removing is O(1) plus the holes it
+// trims when the element is at an end, and each hole is trimmed once, so removing is amortized O(1). Holes are only
+// reclaimed at the ends or by compaction, so after removals in the middle, iteration is O(elements + holes), and a
+// ring used only at its head and tail (a deque) has no holes.
+
+template<typename T> class uRing : protected uCFriend, protected uSFriend {
+	template<typename U> friend class uRingIter;
+
+	T ** elems;											// circular array
+	size_t mask;										// array size - 1
+	size_t first, last;									// position of head and one past the tail
+	size_t cnt;											// number of elements
+	// class invariant: first == last & empty() | elems[first & mask] != nullptr & elems[(last - 1) & mask] != nullptr
+
+	size_t getpos( T * n ) const {
+		return (uintptr_t)uBack( n );
+	} // uRing::getpos
+
+	void setpos( T * n, size_t pos ) {
+		uBack( n ) = (uSeqable *)(uintptr_t)pos;
+		elems[pos & mask] = n;
+	} // uRing::setpos
+
+	void resize() {										// pre: last - first == mask + 1
+		size_t size = mask + 1;
+		if ( cnt > size / 2 ) size *= 2;				// otherwise compacting frees half the array
+		T ** old = elems;
+		size_t oldmask = mask;
+		elems = new T *[size];
+		mask = size - 1;
+		size_t pos = 0;
+		for ( size_t p = first; p != last; p += 1 ) {
+			T * n = old[p & oldmask];
+			if ( n ) { setpos( n, pos ); pos += 1; }	// skip holes
+		} // for
+		first = 0;
+		last = pos;
+		delete [] old;
+	} // uRing::resize
+
+	void trim() {										// remove holes at the ends
+		while ( first != last && ! elems[first & mask] ) first += 1;
+		while ( first != last && ! elems[(last - 1) & mask] ) last -= 1;
+	} // uRing::trim
+  public:
+	uRing( const uRing & ) = delete;					// no copy
+	uRing( uRing && ) = delete;
+	uRing & operator=( const uRing & ) = delete;		// no assignment
+	uRing & operator=( uRing && ) = delete;
+
+	uRing( size_t size = 64 ) {							// initial size, rounded up to a power of 2
+		for ( mask = 1; mask < size; mask *= 2 );
+		elems = new T *[mask];
+		mask -= 1;
+		first = last = cnt = 0;
+	} // post: empty()
+
+	~uRing() {
+		delete [] elems;
+	} // uRing::~uRing
+
+	bool empty() const {
+		return cnt == 0;
+	} // uRing::empty
+
+	// True if the next add resizes the array, i.e., allocates.
+	bool full() const {
+		return last - first == mask + 1;
+	} // uRing::full
+
+	// True if n is in this ring, where n is in this ring or not on any list in the array, e.g., on a uSequence.
+	bool has( T * n ) const {
+		return elems[getpos( n ) & mask] == n;
+	} // uRing::has
+
+	size_t size() const {
+		return cnt;
+	} // uRing::size
+
+	// Return a pointer to the first element, without removing it.
+	T * head() const {
+		return cnt != 0 ? elems[first & mask] : nullptr;
+	} // post: empty() & head() == nullptr | !empty() & head() in *this
+
+	// Return a pointer to the last element, without removing it.
+	T * tail() const {
+		return cnt != 0 ? elems[(last - 1) & mask] : nullptr;
+	} // post: empty() & tail() == nullptr | !empty() & tail() in *this
+
+	// Add an element to the tail of the ring.
+	T * addTail( T * n ) {								// pre: !n->listed(); post: n->listed() & tail() == n
+		#ifdef __U_DEBUG__
+		if ( n->listed() ) abort( "(uRing &)%p.addTail( %p ) : Node is already on another list.", this, n );
+		#endif // __U_DEBUG__
+		if ( last - first == mask + 1 ) resize();
+		uNext( n ) = n;
+		setpos( n, last );
+		last += 1;
+		cnt += 1;
+		return n;
+	} // uRing::addTail
+
+	// Add an element to the head of the ring.
+	T * addHead( T * n ) {								// pre: !n->listed(); post: n->listed() & head() == n
+		#ifdef __U_DEBUG__
+		if ( n->listed() ) abort( "(uRing &)%p.addHead( %p ) : Node is already on another list.", this, n );
+		#endif // __U_DEBUG__
+		if ( last - first == mask + 1 ) resize();
+		uNext( n ) = n;
+		first -= 1;
+		setpos( n, first );
+		cnt += 1;
+		return n;
+	} // uRing::addHead
+
+	// Add an element to the tail of the ring.
+	T * add( T * n ) {									// pre: !n->listed(); post: n->listed() & tail() == n
+		return addTail( n );
+	} // uRing::add
+
+	T * remove( T * n ) {								// amortized O(1), see costs
+		#ifdef __U_DEBUG__
+		if ( ! n->listed() ) abort( "(uRing &)%p.remove( %p ) : Node is not on a list.", this, n );
+		if ( elems[getpos( n ) & mask] != n ) abort( "(uRing &)%p.remove( %p ) : Node is not on this list.", this, n );
+		#endif // __U_DEBUG__
+		elems[getpos( n ) & mask] = nullptr;			// leave hole
+		cnt -= 1;
+		trim();
+		uNext( n ) = uBack( n ) = nullptr;
+		return n;
+	} // post: !n->listed().
+
+	// Remove and return the head element in the ring.
+	T * dropHead() {
+		T * n = head();
+		return n ? remove( n ), n : nullptr;
+	} // uRing::dropHead
+
+	// Remove and return the head element in the ring.
+	T * drop() {
+		return dropHead();
+	} // uRing::drop
+
+	// Remove and return the tail element in the ring.
+	T * dropTail() {
+		T * n = tail();
+		return n ? remove( n ), n : nullptr;
+	} // uRing::dropTail
+
+	// Transfer the "from" sequence to the end of this ring; the "from" sequence is empty after the transfer.
+	void transfer( uSequence<T> & from ) {
+		for ( T * n = from.dropHead(); n; n = from.dropHead() ) addTail( n );
+	} // uRing::transfer
+}; // uRing
+
+
+// A uRingIter<T> is used to iterate over a uRing<T> in head-to-tail order. Each step prefetches the element Ahead
+// positions further on.
+
+template<typename T> class uRingIter {
+	enum { Ahead = 4 };
+	const uRing<T> * ring;
+	size_t curr;
+  public:
+	uRingIter() {
+		ring = nullptr;
+	} // post: elts = null.
+
+	// Create a iterator active in ring r
+	uRingIter( const uRing<T> & r ) {
+		over( r );
+	} // post: elts = {e in r}.
+
+	// Make the iterator active in ring r.
+	void over( const uRing<T> & r ) {
+		ring = &r;
+		curr = r.first;
+	} // post: elts = {e in r}.
+
+	bool operator>>( T *& tp ) {
+		tp = nullptr;
+		if ( ring ) {
+			for ( ; curr != ring->last && ! tp; curr += 1 ) {
+				tp = ring->elems[curr & ring->mask];	// skip holes
+			} // for
+			if ( ring->last - curr > (size_t)Ahead ) __builtin_prefetch( ring->elems[(curr + Ahead) & ring->mask] );
+		} // if
+		return tp != nullptr;
+	} // uRingIter::operator>>
+}; // uRingIter
+
+
+// Local Variables: //
+// compile-command: "make install" //
+// End: //
@@ -29,6 +29,7 @@
 
 
 #include "uCollection.h"
+#include "uQueue.h"
 
 // A uStack<T> is a uCollection<T> defining the ordering that nodes are returned by drop() in the reverse order from
 // those added by add(). T must be a public descendant of uColable.
@@ -85,6 +86,15 @@ template<typename T> class uStack: public uCollection<T> {
 	T * pop() {
 		return drop();
 	}
+
+	// Push the "from" queue onto the stack in one step, so the head of the queue is the top of the stack and the queue
+	// nodes are dropped in queue order; the "from" queue is empty after the transfer.
+	void transfer( uQueue<T> & from ) {
+		if ( from.empty() ) return;						// "from" list empty ?
+		uNext( from.last ) = root ? root : from.last;	// last node points to itself
+		root = from.root;
+		from.root = from.last = nullptr;				// mark "from" list empty
+	}
 };
 
 // A uStackIter<T> is a subclass of uColIter<T> that generates the elements of a uStack<T>.  It returns the elements in
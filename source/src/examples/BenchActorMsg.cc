@@ -0,0 +1,77 @@
+//                              -*- Mode: C++ -*-
+//
+// uC++ Version 7.0.0, Copyright (C) Peter A. Buhr 2026
+//
+// BenchActorMsg.cc -- Time of actor message churn, where each message is allocated by the sender and deleted by the
+//                     actor system.
+//
+// Author           : agent
+// Created On       : Mon Oct 19 03:13:33 2026
+// Last Modified By : agent
+// Last Modified On : Mon Oct 19 03:13:33 2026
+// Update Count     : 1
+//
+// This  library is free  software; you  can redistribute  it and/or  modify it
+// under the terms of the GNU Lesser General Public License as published by the
+// Free Software  Foundation; either  version 2.1 of  the License, or  (at your
+// option) any later version.
+//
+// This library is distributed in the  hope that it will be useful, but WITHOUT
+// ANY  WARRANTY;  without even  the  implied  warranty  of MERCHANTABILITY  or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+// for more details.
+//
+// You should  have received a  copy of the  GNU Lesser General  Public License
+// along  with this library.
+//
+
+#include <iostream>
+using namespace std;
+#include <uActor.h>
+
+// Pairs of actors pass a count back and forth in a new message each hop. A received message is deleted through its
+// virtual destructor, which calls the sized operator delete. Compile with -fno-sized-deallocation to time the same
+// program with unsized deallocation.
+
+struct Hop : public uActor::SenderMsg {
+	int cnt;
+	Hop( uActor * sender, int cnt ) : SenderMsg( sender ), cnt( cnt ) {}
+}; // Hop
+
+struct BigHop : public Hop {							// message with a payload
+	char payload[200];
+	BigHop( uActor * sender, int cnt ) : Hop( sender, cnt ) {}
+}; // BigHop
+
+template< typename Msg > _Actor Churn {
+	uActor::Allocation receive( uActor::Message & msg ) { // qualified names in template
+		iftype ( Msg, msg ) {
+			if ( msg.cnt > 0 ) { *msg.sender() | *new Msg( this, msg.cnt - 1 ); return uActor::Nodelete; }
+			if ( msg.cnt == 0 ) { *msg.sender() | *new Msg( this, -1 ); } // special case to stop partner
+		} endiftype
+		return uActor::Finished;
+	} // Churn::receive
+}; // Churn
+
+enum { NoOfPairs = 4, NoOfHops = 500'000 };
+
+template< typename Msg > static long int churn() {
+	uTime start = uClock::currTime();
+	uActor::start();									// start actor system
+	Churn<Msg> ping[NoOfPairs], pong[NoOfPairs];
+	for ( int i = 0; i < NoOfPairs; i += 1 ) {
+		ping[i].tell( *new Msg( &pong[i], NoOfHops ), &pong[i] ); // start cycling
+	} // for
+	uActor::stop();										// wait for all actors to terminate
+	return (uClock::currTime() - start).nanoseconds() / ((long int)NoOfPairs * NoOfHops);
+} // churn
+
+int main() {
+	cout << "message (bytes)\tchurn (ns/msg)" << endl;
+	cout << sizeof(Hop) << "\t" << churn<Hop>() << endl;
+	cout << sizeof(BigHop) << "\t" << churn<BigHop>() << endl;
+} // main
+
+// Local Variables: //
+// compile-command: "u++ -O2 -multi -nodebug BenchActorMsg.cc" //
+// End: //
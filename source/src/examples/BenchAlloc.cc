@@ -0,0 +1,156 @@
+//                              -*- Mode: C++ -*-
+//
+// uC++ Version 7.0.0, Copyright (C) Peter A. Buhr 2026
+//
+// BenchAlloc.cc -- Time and footprint of small allocations with and without an allocation header, and time of sized
+//                  and unsized deallocation.
+//
+// Author           : agent
+// Created On       : Mon Oct 19 02:05:59 2026
+// Last Modified By : agent
+// Last Modified On : Mon Oct 19 03:13:33 2026
+// Update Count     : 2
+//
+// This  library is free  software; you  can redistribute  it and/or  modify it
+// under the terms of the GNU Lesser General Public License as published by the
+// Free Software  Foundation; either  version 2.1 of  the License, or  (at your
+// option) any later version.
+//
+// This library is distributed in the  hope that it will be useful, but WITHOUT
+// ANY  WARRANTY;  without even  the  implied  warranty  of MERCHANTABILITY  or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+// for more details.
+//
+// You should  have received a  copy of the  GNU Lesser General  Public License
+// along  with this library.
+//
+
+#include <iostream>
+#include <iomanip>
+using namespace std;
+#include <fcntl.h>										// open
+#include <unistd.h>										// read, close, sysconf
+
+unsigned int uDefaultPreemption() {
+	return 0;
+} // uDefaultPreemption
+
+// Small malloc allocations are headerless, while calloc allocations have a header to remember the zero fill, so the two
+// columns compare the same bucket sizes with and without a header. The delete columns compare C++ unsized and sized
+// deallocation of the same bucket sizes.
+
+enum { NoOfPairs = 5'000'000, NoOfObjs = 500'000, NoOfChases = 20 };
+
+typedef void * (* Alloc)( size_t size );
+static void * headerless( size_t size ) { return malloc( size ); }
+static void * header( size_t size ) { return calloc( 1, size ); }
+
+static size_t resident() {								// resident set size in bytes
+	char buf[128];
+	int fd = open( "/proc/self/statm", O_RDONLY );
+  if ( fd == -1 ) return 0;
+	ssize_t len = read( fd, buf, sizeof(buf) - 1 );
+	close( fd );
+  if ( len <= 0 ) return 0;
+	buf[len] = '\0';
+	unsigned long int size, pages;
+  if ( sscanf( buf, "%lu %lu", &size, &pages ) != 2 ) return 0;
+	return pages * sysconf( _SC_PAGESIZE );
+} // resident
+
+static void * volatile sink;							// prevent dead-code removal
+static void * objs[NoOfObjs];
+
+// Allocation and free of one object.
+static long int pairs( Alloc alloc, size_t size ) {
+	uTime start = uClock::getCPUTime();
+	for ( int i = 0; i < NoOfPairs; i += 1 ) {
+		sink = alloc( size );
+		free( sink );
+	} // for
+	return (uClock::getCPUTime() - start).nanoseconds() / NoOfPairs;
+} // pairs
+
+// Allocation of many objects followed by their frees, and the resident storage per object. Freed objects are reused by
+// later tests, so each size and kind is measured on new storage.
+static long int batch( Alloc alloc, size_t size, size_t & footprint ) {
+	size_t before = resident();
+	uTime start = uClock::getCPUTime();
+	for ( int i = 0; i < NoOfObjs; i += 1 ) {
+		objs[i] = alloc( size );
+		*(char *)objs[i] = 1;							// touch
+	} // for
+	footprint = (resident() - before) / NoOfObjs;
+	for ( int i = 0; i < NoOfObjs; i += 1 ) {
+		free( objs[i] );
+	} // for
+	return (uClock::getCPUTime() - start).nanoseconds() / NoOfObjs;
+} // batch
+
+// Allocation and unsized or sized delete of one object, in picoseconds as the difference is small.
+static long int deletes( size_t size, bool sized ) {
+	uTime start = uClock::getCPUTime();
+	for ( int i = 0; i < NoOfPairs; i += 1 ) {
+		sink = ::operator new( size );
+		if ( sized ) ::operator delete( sink, size );
+		else ::operator delete( sink );
+	} // for
+	return (uClock::getCPUTime() - start).nanoseconds() * 1000 / NoOfPairs;
+} // deletes
+
+// Traversal of a list of 16-byte nodes in allocation order. Denser nodes mean fewer cache lines per node.
+struct Node {
+	Node * next;
+	long int value;
+}; // Node
+
+static long int chase( Alloc alloc ) {
+	Node * head = nullptr, ** tail = &head;
+	for ( int i = 0; i < NoOfObjs; i += 1 ) {
+		Node * n = (Node *)alloc( sizeof(Node) );
+		n->next = nullptr;
+		n->value = i;
+		*tail = n;
+		tail = &n->next;
+	} // for
+
+	long int sum = 0;
+	uTime start = uClock::getCPUTime();
+	for ( int r = 0; r < NoOfChases; r += 1 ) {
+		for ( Node * n = head; n != nullptr; n = n->next ) sum += n->value;
+	} // for
+	long int time = (uClock::getCPUTime() - start).nanoseconds() * 1000 / ((long int)NoOfObjs * NoOfChases);
+	if ( sum != (long int)NoOfObjs * (NoOfObjs - 1) / 2 * NoOfChases ) abort( "chase sum incorrect" );
+
+	for ( Node * n = head; n != nullptr; ) {
+		Node * next = n->next;
+		free( n );
+		n = next;
+	} // for
+	return time;
+} // chase
+
+int main() {
+	static const size_t sizes[] = { 16, 32, 48, 64 };
+	size_t footprint;
+
+	for ( int i = 0; i < NoOfObjs; i += 1 ) objs[i] = &footprint; // touch array so it is not counted as allocation
+
+	cout << "size\tpair (ns)\tbatch (ns)\tresident (bytes)\tdelete (ps)" << endl;
+	cout << "\tno hdr\thdr\tno hdr\thdr\tno hdr\thdr\t\tunsized\tsized" << endl;
+	for ( size_t s : sizes ) {
+		cout << s << "\t" << pairs( headerless, s ) << "\t" << pairs( header, s ) << "\t";
+		long int t = batch( headerless, s, footprint );
+		size_t f = footprint;
+		cout << t << "\t" << batch( header, s, footprint ) << "\t" << f << "\t" << footprint << "\t\t";
+		t = deletes( s, false );
+		cout << t << "\t" << deletes( s, true ) << endl;
+	} // for
+
+	long int t = chase( headerless );
+	cout << "chase (ps/node)\t" << t << "\t" << chase( header ) << endl;
+} // main
+
+// Local Variables: //
+// compile-command: "u++ -O2 -nodebug BenchAlloc.cc" //
+// End: //
@@ -0,0 +1,80 @@
+//                              -*- Mode: C++ -*-
+//
+// uC++ Version 7.0.0, Copyright (C) Peter A. Buhr 2026
+//
+// BenchLock.cc -- Time of contended acquire/release of mutex and owner locks for short and long critical sections.
+//
+// Author           : agent
+// Created On       : Mon Oct 19 04:30:04 2026
+// Last Modified By : agent
+// Last Modified On : Mon Oct 19 04:30:04 2026
+// Update Count     : 1
+//
+// This  library is free  software; you  can redistribute  it and/or  modify it
+// under the terms of the GNU Lesser General Public License as published by the
+// Free Software  Foundation; either  version 2.1 of  the License, or  (at your
+// option) any later version.
+//
+// This library is distributed in the  hope that it will be useful, but WITHOUT
+// ANY  WARRANTY;  without even  the  implied  warranty  of MERCHANTABILITY  or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+// for more details.
+//
+// You should  have received a  copy of the  GNU Lesser General  Public License
+// along  with this library.
+//
+
+#include <iostream>
+using namespace std;
+
+// One task per processor repeatedly acquires a shared lock, works in the critical section and then outside it. A
+// short critical section is shorter than a context switch, so spinning for the lock is cheaper than blocking; a long
+// critical section is not. Times are per critical section over all tasks. Compile with -multi for the spinning path.
+
+enum { NoOfProcessors = 4, NoOfCS = 200'000 };
+enum { Short = 20, Long = 4'000 };						// work iterations in critical section
+
+static volatile unsigned long int shared = 0;
+
+static void work( unsigned int n ) {
+	for ( unsigned int i = 0; i < n; i += 1 ) shared += 1;
+} // work
+
+template< typename Lock > _Task Worker {
+	Lock & lock;
+	unsigned int cs, times;
+
+	void main() {
+		for ( unsigned int i = 0; i < times; i += 1 ) {
+			lock.acquire();
+			work( cs );
+			lock.release();
+			work( cs );									// outside critical section
+		} // for
+	} // Worker::main
+  public:
+	Worker( Lock & lock, unsigned int cs, unsigned int times ) : lock( lock ), cs( cs ), times( times ) {}
+}; // Worker
+
+template< typename Lock > static long int contend( unsigned int cs ) {
+	Lock lock;
+	unsigned int times = cs == Short ? NoOfCS : NoOfCS / 100;
+	uTime start = uClock::currTime();
+	{
+		Worker< Lock > * workers[NoOfProcessors];
+		for ( unsigned int i = 0; i < NoOfProcessors; i += 1 ) workers[i] = new Worker< Lock >( lock, cs, times );
+		for ( unsigned int i = 0; i < NoOfProcessors; i += 1 ) delete workers[i];
+	}
+	return (uClock::currTime() - start).nanoseconds() / ((long int)NoOfProcessors * times);
+} // contend
+
+int main() {
+	uProcessor processors[NoOfProcessors - 1] __attribute__(( unused )); // more than one processor
+	cout << "lock\tshort CS (ns)\tlong CS (ns)" << endl;
+	cout << "mutex\t" << contend< uMutexLock >( Short ) << "\t" << contend< uMutexLock >( Long ) << endl;
+	cout << "owner\t" << contend< uOwnerLock >( Short ) << "\t" << contend< uOwnerLock >( Long ) << endl;
+} // main
+
+// Local Variables: //
+// compile-command: "u++ -O2 -multi -nodebug BenchLock.cc" //
+// End: //
@@ -0,0 +1,86 @@
+//                              -*- Mode: C++ -*-
+//
+// uC++ Version 7.0.0, Copyright (C) Peter A. Buhr 2026
+//
+// BenchRWLock.cc -- Time of read-mostly critical sections with readers/writer locks as processors increase.
+//
+// Author           : agent
+// Created On       : Mon Oct 19 04:35:54 2026
+// Last Modified By : agent
+// Last Modified On : Mon Oct 19 04:35:54 2026
+// Update Count     : 1
+//
+// This  library is free  software; you  can redistribute  it and/or  modify it
+// under the terms of the GNU Lesser General Public License as published by the
+// Free Software  Foundation; either  version 2.1 of  the License, or  (at your
+// option) any later version.
+//
+// This library is distributed in the  hope that it will be useful, but WITHOUT
+// ANY  WARRANTY;  without even  the  implied  warranty  of MERCHANTABILITY  or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+// for more details.
+//
+// You should  have received a  copy of the  GNU Lesser General  Public License
+// along  with this library.
+//
+
+#include <uRWLock.h>
+#include <iostream>
+using namespace std;
+
+// One task per processor performs a fixed share of the operations, of which 1 in WriteRatio writes. Times are per
+// operation over all tasks, so a lock that scales keeps the time falling as processors are added. Compile with -multi.
+
+enum { MaxProcessors = 64, NoOfOps = 2'000'000, WriteRatio = 100, Work = 20 };
+
+static volatile unsigned long int shared[8];				// protected data
+
+template< typename Lock > _Task Worker {
+	Lock & lock;
+	unsigned int ops;
+
+	void main() {
+		unsigned long int sum = 0;
+		for ( unsigned int i = 0; i < ops; i += 1 ) {
+			if ( i % WriteRatio == 0 ) {
+				lock.wracquire();
+				for ( unsigned int w = 0; w < Work; w += 1 ) shared[w % 8] += 1;
+				lock.wrrelease();
+			} else {
+				lock.rdacquire();
+				for ( unsigned int w = 0; w < Work; w += 1 ) sum += shared[w % 8];
+				lock.rdrelease();
+			} // if
+		} // for
+		if ( sum == 1 ) abort();							// prevent dead-code removal
+	} // Worker::main
+  public:
+	Worker( Lock & lock, unsigned int ops ) : lock( lock ), ops( ops ) {}
+}; // Worker
+
+template< typename Lock > static long int readMostly( unsigned int tasks ) {
+	Lock lock;
+	unsigned int ops = NoOfOps / tasks;
+	uTime start = uClock::currTime();
+	{
+		Worker< Lock > * workers[MaxProcessors];
+		for ( unsigned int i = 0; i < tasks; i += 1 ) workers[i] = new Worker< Lock >( lock, ops );
+		for ( unsigned int i = 0; i < tasks; i += 1 ) delete workers[i];
+	}
+	return (uClock::currTime() - start).nanoseconds() / ((long int)tasks * ops);
+} // readMostly
+
+int main() {
+	uProcessor * processors[MaxProcessors];
+	unsigned int added = 0;
+	cout << "processors\tuRWLock (ns)\tuBiasedRWLock (ns)" << endl;
+	for ( unsigned int p = 1; p <= MaxProcessors; p *= 2 ) {
+		for ( ; added < p - 1; added += 1 ) processors[added] = new uProcessor;
+		cout << p << "\t" << readMostly< uRWLock >( p ) << "\t" << readMostly< uBiasedRWLock<> >( p ) << endl;
+	} // for
+	for ( unsigned int i = 0; i < added; i += 1 ) delete processors[i];
+} // main
+
+// Local Variables: //
+// compile-command: "u++ -O2 -multi -nodebug BenchRWLock.cc" //
+// End: //
@@ -0,0 +1,127 @@
+//                              -*- Mode: C++ -*-
+//
+// uC++ Version 7.0.0, Copyright (C) Peter A. Buhr 2026
+//
+// BenchTimeout.cc -- Time of reading the deadline clock and of operations with timeouts that do not expire.
+//
+// Author           : agent
+// Created On       : Mon Oct 19 03:55:39 2026
+// Last Modified By : agent
+// Last Modified On : Mon Oct 19 03:55:39 2026
+// Update Count     : 1
+//
+// This  library is free  software; you  can redistribute  it and/or  modify it
+// under the terms of the GNU Lesser General Public License as published by the
+// Free Software  Foundation; either  version 2.1 of  the License, or  (at your
+// option) any later version.
+//
+// This library is distributed in the  hope that it will be useful, but WITHOUT
+// ANY  WARRANTY;  without even  the  implied  warranty  of MERCHANTABILITY  or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+// for more details.
+//
+// You should  have received a  copy of the  GNU Lesser General  Public License
+// along  with this library.
+//
+
+#include <uSemaphore.h>
+#include <iostream>
+using namespace std;
+
+// Each timed operation reads the deadline clock once to compute its deadline, and the timeout event is added to and
+// removed from the event list. Compile with -DCLOCK=0 (CLOCK_MONOTONIC), -DCLOCK=1 (CLOCK_MONOTONIC_COARSE) or
+// -DCLOCK=2 (time-stamp counter) to compare the clock sources.
+
+#ifndef CLOCK
+#define CLOCK 0
+#endif // CLOCK
+
+unsigned int uDefaultClock() {
+	return CLOCK;
+} // uDefaultClock
+
+enum { NoOfReads = 10'000'000, NoOfWaits = 500'000, NoOfAccepts = 500'000 };
+static const uDuration Long( 10 );						// timeout never expires
+
+static long int clockRead() {
+	uTime start = uClock::currTime(), last;
+	for ( int i = 0; i < NoOfReads; i += 1 ) {
+		last = uClock::monoTime();
+	} // for
+	if ( last == uTime() ) abort();						// prevent dead-code removal
+	return (uClock::currTime() - start).nanoseconds() / NoOfReads;
+} // clockRead
+
+static long int semaphoreTimeout() {					// uncontended, never blocks
+	uSemaphore sem( 1 );
+	uTime start = uClock::currTime();
+	for ( int i = 0; i < NoOfWaits; i += 1 ) {
+		sem.P( Long );
+		sem.V();
+	} // for
+	return (uClock::currTime() - start).nanoseconds() / NoOfWaits;
+} // semaphoreTimeout
+
+_Task Partner {											// alternate with main through a condition lock
+	uOwnerLock & lock;
+	uCondLock & cond;
+	int & turn;
+	int me;
+
+	void main() {
+		lock.acquire();
+		for ( int i = 0; i < NoOfWaits; i += 1 ) {
+			while ( turn != me ) cond.wait( lock, Long );
+			turn = 1 - me;
+			cond.signal();
+		} // for
+		lock.release();
+	} // Partner::main
+  public:
+	Partner( uOwnerLock & lock, uCondLock & cond, int & turn, int me ) : lock( lock ), cond( cond ), turn( turn ), me( me ) {}
+}; // Partner
+
+static long int condTimeout() {							// blocks and is signalled before timeout
+	uOwnerLock lock;
+	uCondLock cond;
+	int turn = 0;
+	uTime start = uClock::currTime();
+	{
+		Partner p0( lock, cond, turn, 0 ), p1( lock, cond, turn, 1 );
+	}
+	return (uClock::currTime() - start).nanoseconds() / (2 * NoOfWaits);
+} // condTimeout
+
+_Task Server {
+  public:
+	void call() {}
+  private:
+	void main() {
+		for ( int i = 0; i < NoOfAccepts; i += 1 ) {
+			_Accept( call ) {
+			} or _Timeout( Long ) {
+				abort( "Server timeout" );
+			} // _Accept
+		} // for
+	} // Server::main
+}; // Server
+
+static long int acceptTimeout() {						// acceptor blocks and is called before timeout
+	uTime start = uClock::currTime();
+	{
+		Server server;
+		for ( int i = 0; i < NoOfAccepts; i += 1 ) server.call();
+	}
+	return (uClock::currTime() - start).nanoseconds() / NoOfAccepts;
+} // acceptTimeout
+
+int main() {
+	static const char * sources[] = { "monotonic", "coarse", "tsc" };
+	cout << "clock\tread (ns)\tP timeout (ns)\twait timeout (ns)\taccept timeout (ns)" << endl;
+	cout << sources[uClock::getSource()] << "\t" << clockRead() << "\t" << semaphoreTimeout() << "\t"
+		 << condTimeout() << "\t" << acceptTimeout() << endl;
+} // main
+
+// Local Variables: //
+// compile-command: "u++ -O2 -nodebug -DCLOCK=2 BenchTimeout.cc" //
+// End: //
@@ -0,0 +1,119 @@
+//                              -*- Mode: C++ -*-
+//
+// uC++ Version 7.0.0, Copyright (C) Peter A. Buhr 2026
+//
+// BlockingCall.cc -- Execute blocking system calls on the blocking I/O cluster.
+//
+// Author           : agent
+// Created On       : Mon Oct 19 01:12:38 2026
+// Last Modified By : agent
+// Last Modified On : Mon Oct 19 01:12:38 2026
+// Update Count     : 1
+//
+// This  library is free  software; you  can redistribute  it and/or  modify it
+// under the terms of the GNU Lesser General Public License as published by the
+// Free Software  Foundation; either  version 2.1 of  the License, or  (at your
+// option) any later version.
+//
+// This library is distributed in the  hope that it will be useful, but WITHOUT
+// ANY  WARRANTY;  without even  the  implied  warranty  of MERCHANTABILITY  or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+// for more details.
+//
+// You should  have received a  copy of the  GNU Lesser General  Public License
+// along  with this library.
+//
+
+#include <uFile.h>
+#include <iostream>
+using namespace std;
+#include <unistd.h>										// pipe, read, write, close, unlink
+
+// Readers block their kernel thread reading blocking pipes inside uBlockingCall, while the writer, on the user cluster
+// with a single processor, must still run to write the data. Without the blocking I/O cluster, the readers would stop
+// the user processor and the program would deadlock. Only the multiprocessor kernel has separate kernel threads.
+
+enum { NoOfReaders = 3 };
+
+unsigned int uDefaultBlockingIOProcessors() { return NoOfReaders; } // replace default
+
+_Task Reader {
+	int fd;
+	unsigned int &errors;
+
+	void main() {
+		uCluster &home = uThisCluster();
+		char c;
+		ssize_t len = uBlockingCall( [&]() {
+			if ( &uThisCluster() == &home ) errors += 1; // not migrated ?
+			return ::read( fd, &c, 1 );					// blocks kernel thread
+		} );
+		if ( len != 1 || c != 'x' || &uThisCluster() != &home ) errors += 1;
+	} // Reader::main
+  public:
+	Reader( int fd, unsigned int &errors ) : fd( fd ), errors( errors ) {}
+}; // Reader
+
+int main() {
+	unsigned int errors = 0;
+	uCluster &home = uThisCluster();
+
+#ifdef __U_MULTI__
+	int fds[NoOfReaders][2];
+	for ( unsigned int i = 0; i < NoOfReaders; i += 1 ) {
+		if ( ::pipe( fds[i] ) == -1 ) abort( "pipe failed" ); // blocking descriptors
+	} // for
+	{
+		Reader * readers[NoOfReaders];
+		for ( unsigned int i = 0; i < NoOfReaders; i += 1 ) readers[i] = new Reader( fds[i][0], errors );
+		uThisTask().yield( 20 );						// let readers block
+		for ( unsigned int i = 0; i < NoOfReaders; i += 1 ) {
+			if ( ::write( fds[i][1], "x", 1 ) != 1 ) errors += 1;
+		} // for
+		for ( unsigned int i = 0; i < NoOfReaders; i += 1 ) delete readers[i];
+	}
+	for ( unsigned int i = 0; i < NoOfReaders; i += 1 ) {
+		::close( fds[i][0] );
+		::close( fds[i][1] );
+	} // for
+#endif // __U_MULTI__
+
+	// Result types and exceptions pass through the call, and the caller always returns to its cluster.
+	if ( uBlockingCall( []() { return 42; } ) != 42 ) errors += 1;
+	try {
+		uBlockingCall( []() { throw 3; } );
+		errors += 1;
+	} catch( int v ) {
+		if ( v != 3 ) errors += 1;
+	} // try
+	if ( &uThisCluster() != &home ) errors += 1;
+
+	// uFile operations execute on the blocking I/O cluster by default.
+	const char *name = "xxx";
+	{
+		uFile::FileAccess out( name, O_WRONLY | O_CREAT | O_TRUNC, 0666 );
+		out.write( "hello\n", 6 );
+		out.fsync();
+		struct stat buf;
+		out.status( buf );
+		if ( buf.st_size != 6 ) errors += 1;
+	}
+	uFile missing( "xxx-does-not-exist" );
+	try {
+		uFile::FileAccess in( missing, O_RDONLY );
+		errors += 1;
+	} catch( uFile::FileAccess::OpenFailure &ex ) {
+		if ( ex.errNo() != ENOENT ) errors += 1;		// errno from blocking I/O processor
+	} // try
+	unlink( name );
+
+	if ( errors != 0 ) {
+		cerr << "Error: " << errors << " failures" << endl;
+		return 1;
+	} // if
+	cout << "successful completion" << endl;
+} // main
+
+// Local Variables: //
+// compile-command: "u++ BlockingCall.cc" //
+// End: //
@@ -0,0 +1,148 @@
+//                              -*- Mode: C++ -*-
+//
+// uC++ Version 7.0.0, Copyright (C) Peter A. Buhr 2026
+//
+// Broadcast.cc -- Broadcast on condition locks and monitor conditions
+//
+// Author           : agent
+// Created On       : Mon Oct 19 04:16:34 2026
+// Last Modified By : agent
+// Last Modified On : Mon Oct 19 04:16:34 2026
+// Update Count     : 1
+//
+// This  library is free  software; you  can redistribute  it and/or  modify it
+// under the terms of the GNU Lesser General Public License as published by the
+// Free Software  Foundation; either  version 2.1 of  the License, or  (at your
+// option) any later version.
+//
+// This library is distributed in the  hope that it will be useful, but WITHOUT
+// ANY  WARRANTY;  without even  the  implied  warranty  of MERCHANTABILITY  or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+// for more details.
+//
+// You should  have received a  copy of the  GNU Lesser General  Public License
+// along  with this library.
+//
+
+#include <iostream>
+using namespace std;
+
+// Waiters on a condition lock, split across two owner locks, are broadcast while one owner lock is held and the other
+// is free, and each waiter checks it holds its owner lock exclusively when it restarts. Then a monitor barrier restarts
+// all waiters with uCondition::broadcast and checks they restart in the order they waited.
+
+enum { NoOfProcessors = 4, NoOfWaiters = 200, NoOfRounds = 100 };
+
+uOwnerLock locks[2];
+uCondLock cond;
+unsigned int waiters = 0, restarted = 0, errors = 0;
+uBaseTask * volatile inside[2] = { nullptr, nullptr };
+
+_Task LockWaiter {
+	uOwnerLock & lock;
+	unsigned int which;
+
+	void main() {
+		for ( unsigned int r = 0; r < NoOfRounds; r += 1 ) {
+			lock.acquire();
+			locks[0].acquire();
+			waiters += 1;								// count waiters under locks[0]
+			locks[0].release();
+			cond.wait( lock );
+			if ( lock.owner() != &uThisTask() ) errors += 1;
+			inside[which] = &uThisTask();				// check mutual exclusion on owner lock
+			yield();
+			if ( inside[which] != &uThisTask() ) errors += 1;
+			locks[0].acquire();
+			restarted += 1;
+			locks[0].release();
+			lock.release();
+		} // for
+	} // LockWaiter::main
+  public:
+	LockWaiter( unsigned int which ) : lock( locks[which] ), which( which ) {}
+}; // LockWaiter
+
+static void condLockBroadcast() {
+	{
+		LockWaiter * w[NoOfWaiters];
+		for ( unsigned int i = 0; i < NoOfWaiters; i += 1 ) w[i] = new LockWaiter( i % 2 );
+		for ( unsigned int r = 1; r <= NoOfRounds; r += 1 ) {
+			for ( ;; ) {								// all waiters blocked ?
+				locks[0].acquire();
+				if ( waiters == r * NoOfWaiters ) {
+					locks[1].acquire();					// waiters on locks[1] blocked
+					locks[1].release();
+					cond.broadcast();					// locks[0] held and locks[1] free
+					locks[0].release();
+					break;
+				} // if
+				locks[0].release();
+				uThisTask().yield();
+			} // for
+		} // for
+		for ( unsigned int i = 0; i < NoOfWaiters; i += 1 ) delete w[i];
+	}
+	if ( restarted != NoOfWaiters * NoOfRounds ) errors += 1;
+	if ( cond.broadcast() ) errors += 1;				// no waiters
+} // condLockBroadcast
+
+_Monitor Barrier {
+	uCondition barrier;
+	unsigned int count = 0, next = 0, restarts = 0, errors = 0;
+  public:
+	void block() {
+		unsigned int order = count;						// arrival order
+		count += 1;
+		if ( count < NoOfWaiters ) {
+			barrier.wait();
+			if ( order != next ) errors += 1;			// restart in arrival order ?
+			next += 1;
+		} else {
+			count = next = 0;
+			if ( ! barrier.broadcast() ) errors += 1;
+			if ( barrier.broadcast() ) errors += 1;		// no waiters
+			restarts += 1;
+		} // if
+	} // Barrier::block
+
+	unsigned int failures() { return errors + (restarts != NoOfRounds); }
+}; // Barrier
+
+_Task BarrierWaiter {
+	Barrier & barrier;
+
+	void main() {
+		for ( unsigned int r = 0; r < NoOfRounds; r += 1 ) {
+			barrier.block();
+			if ( r % 8 == 0 ) yield();					// vary arrival order
+		} // for
+	} // BarrierWaiter::main
+  public:
+	BarrierWaiter( Barrier & barrier ) : barrier( barrier ) {}
+}; // BarrierWaiter
+
+static void conditionBroadcast() {
+	Barrier barrier;
+	{
+		BarrierWaiter * w[NoOfWaiters];
+		for ( unsigned int i = 0; i < NoOfWaiters; i += 1 ) w[i] = new BarrierWaiter( barrier );
+		for ( unsigned int i = 0; i < NoOfWaiters; i += 1 ) delete w[i];
+	}
+	errors += barrier.failures();
+} // conditionBroadcast
+
+int main() {
+	uProcessor processors[NoOfProcessors - 1] __attribute__(( unused )); // more than one processor
+	condLockBroadcast();
+	conditionBroadcast();
+	if ( errors != 0 ) {
+		cerr << "Error: " << errors << " failures" << endl;
+		return 1;
+	} // if
+	cout << "successful completion" << endl;
+} // main
+
+// Local Variables: //
+// compile-command: "u++ Broadcast.cc" //
+// End: //
@@ -0,0 +1,105 @@
+//                              -*- Mode: C++ -*-
+//
+// uC++ Version 7.0.0, Copyright (C) Peter A. Buhr 2026
+//
+// HWCounters.cc -- Test hardware performance counters on processors and tasks.
+//
+// Author           : agent
+// Created On       : Mon Oct 19 00:01:11 2026
+// Last Modified By : agent
+// Last Modified On : Mon Oct 19 00:01:11 2026
+// Update Count     : 1
+//
+// This  library is free  software; you  can redistribute  it and/or  modify it
+// under the terms of the GNU Lesser General Public License as published by the
+// Free Software  Foundation; either  version 2.1 of  the License, or  (at your
+// option) any later version.
+//
+// This library is distributed in the  hope that it will be useful, but WITHOUT
+// ANY  WARRANTY;  without even  the  implied  warranty  of MERCHANTABILITY  or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+// for more details.
+//
+// You should  have received a  copy of the  GNU Lesser General  Public License
+// along  with this library.
+//
+
+#include <iostream>
+using std::cout;
+using std::endl;
+
+// Two tasks with different behaviour share a processor: one executes a tight arithmetic loop, the other chases
+// pointers through a large array. Their counts are attributed separately even though they interleave on the same
+// kernel thread.
+
+volatile double sink;
+
+static void print( const char * who, const uHWCounters::Counts & counts );
+
+_Task Arithmetic {
+	void main() {
+		double sum = 0.0;
+		for ( unsigned int i = 0; i < 50; i += 1 ) {
+			for ( unsigned int j = 0; j < 200000; j += 1 ) sum += j * 0.5;
+			yield();
+		} // for
+		sink = sum;
+	} // Arithmetic::main
+  public:
+	~Arithmetic();
+}; // Arithmetic
+
+_Task Chase {
+	void main() {
+		enum { Size = 4 * 1024 * 1024 };
+		unsigned int * next = new unsigned int[Size];
+		for ( unsigned int i = 0; i < Size; i += 1 ) next[i] = (i * 1103515245u + 12345u) % Size;
+		unsigned int p = 0;
+		for ( unsigned int i = 0; i < 50; i += 1 ) {
+			for ( unsigned int j = 0; j < 20000; j += 1 ) p = next[p];
+			yield();
+		} // for
+		sink = p;
+		delete [] next;
+	} // Chase::main
+  public:
+	~Chase();
+}; // Chase
+
+static void print( const char * who, const uHWCounters::Counts & counts ) {
+	cout << who << ":";
+	for ( unsigned int e = 0; e < uHWCounters::NoOfEvents; e += 1 ) {
+		if ( uHWCounters::available( uThisProcessor(), (uHWCounters::Event)e ) ) {
+			cout << " " << uHWCounters::name( (uHWCounters::Event)e ) << " " << counts[(uHWCounters::Event)e];
+		} // if
+	} // for
+	cout << endl;
+} // print
+
+Arithmetic::~Arithmetic() {								// task has finished so its counts are final
+	print( "arithmetic", uHWCounters::read( *this ) );
+} // Arithmetic::~Arithmetic
+
+Chase::~Chase() {
+	print( "chase", uHWCounters::read( *this ) );
+} // Chase::~Chase
+
+int main() {
+	if ( ! uHWCounters::start( uThisProcessor() ) ) {
+		cout << "hardware counters not available (perf_event_open unsupported or denied)" << endl;
+		return 0;
+	} // if
+
+	{
+		Arithmetic a;
+		Chase c;
+	}
+	print( "processor", uHWCounters::read( uThisProcessor() ) );
+	print( "main", uHWCounters::read( uThisTask() ) );
+	uHWCounters::stop( uThisProcessor() );
+	cout << "successful completion" << endl;
+} // main
+
+// Local Variables: //
+// compile-command: "u++ HWCounters.cc" //
+// End: //
@@ -0,0 +1,125 @@
+//                              -*- Mode: C++ -*-
+//
+// uC++ Version 7.0.0, Copyright (C) Peter A. Buhr 2026
+//
+// HashMap.cc -- Concurrent hash map correctness while resizing, and lookup scaling from 1 to N processors.
+//
+// Author           : agent
+// Created On       : Mon Oct 19 01:51:27 2026
+// Last Modified By : agent
+// Last Modified On : Mon Oct 19 01:51:27 2026
+// Update Count     : 1
+//
+// This  library is free  software; you  can redistribute  it and/or  modify it
+// under the terms of the GNU Lesser General Public License as published by the
+// Free Software  Foundation; either  version 2.1 of  the License, or  (at your
+// option) any later version.
+//
+// This library is distributed in the  hope that it will be useful, but WITHOUT
+// ANY  WARRANTY;  without even  the  implied  warranty  of MERCHANTABILITY  or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+// for more details.
+//
+// You should  have received a  copy of the  GNU Lesser General  Public License
+// along  with this library.
+//
+
+#include <uHashMap.h>
+#include <uPRNG.h>
+#include <iostream>
+#include <iomanip>
+using namespace std;
+#include <unistd.h>										// sysconf
+
+enum { MaxProcessors = 8, NoOfKeys = 20'000, NoOfOps = 1'000'000 };
+
+typedef uHashMap<long int, long int> Map;
+
+// Each worker inserts its own keys into a small map, so the map resizes many times while the workers run, replaces
+// them, and erases the odd ones.
+_Task Filler {
+	Map & map;
+	long int first;
+	unsigned int & errors;
+
+	void main() {
+		for ( long int k = first; k < first + NoOfKeys; k += 1 ) {
+			if ( ! map.insert( k, k ) ) errors += 1;
+		} // for
+		for ( long int k = first; k < first + NoOfKeys; k += 1 ) {
+			if ( map.insert( k, 2 * k ) ) errors += 1;	// replace
+			if ( k % 2 == 1 && ! map.erase( k ) ) errors += 1;
+		} // for
+	} // Filler::main
+  public:
+	Filler( Map & map, long int first, unsigned int & errors ) : map( map ), first( first ), errors( errors ) {}
+}; // Filler
+
+// 90% lookups, 5% inserts and 5% erases of random keys.
+_Task Mixer {
+	Map & map;
+	unsigned int seed;
+
+	void main() {
+		PRNG32 prng( seed );
+		long int value;
+		for ( unsigned int i = 0; i < NoOfOps; i += 1 ) {
+			long int k = prng( NoOfKeys );
+			unsigned int op = prng( 20 );
+			if ( op == 0 ) map.insert( k, k );
+			else if ( op == 1 ) map.erase( k );
+			else map.find( k, value );
+		} // for
+	} // Mixer::main
+  public:
+	Mixer( Map & map, unsigned int seed ) : map( map ), seed( seed ) {}
+}; // Mixer
+
+int main() {
+	unsigned int errors = 0;
+	long int noOfProcessors = sysconf( _SC_NPROCESSORS_ONLN );
+	if ( noOfProcessors > MaxProcessors ) noOfProcessors = MaxProcessors;
+	uProcessor * processors[MaxProcessors - 1];
+	for ( long int p = 0; p < noOfProcessors - 1; p += 1 ) processors[p] = new uProcessor;
+
+	{
+		Map map( 16 );
+		{
+			Filler * fillers[MaxProcessors];
+			for ( long int w = 0; w < noOfProcessors; w += 1 ) fillers[w] = new Filler( map, w * NoOfKeys, errors );
+			for ( long int w = 0; w < noOfProcessors; w += 1 ) delete fillers[w];
+		}
+		if ( map.size() != (size_t)noOfProcessors * NoOfKeys / 2 ) errors += 1;
+		for ( long int k = 0; k < noOfProcessors * NoOfKeys; k += 1 ) {
+			long int value;
+			bool found = map.find( k, value );
+			if ( k % 2 == 0 ? ! found || value != 2 * k : found ) errors += 1;
+		} // for
+	}
+
+	Map map;
+	for ( long int k = 0; k < NoOfKeys; k += 2 ) map.insert( k, k );
+	for ( long int p = 1; p <= noOfProcessors; p += 1 ) {	// one worker per processor
+		uTime start = uClock::currTime();
+		{
+			Mixer * mixers[MaxProcessors];
+			for ( long int w = 0; w < p; w += 1 ) mixers[w] = new Mixer( map, w + 1 );
+			for ( long int w = 0; w < p; w += 1 ) delete mixers[w];
+		}
+		double secs = ( uClock::currTime() - start ).nanoseconds() / 1E9;
+		cout << setw( 2 ) << p << " processors " << setw( 8 ) << fixed << setprecision( 1 ) << p * NoOfOps / secs / 1E6 << " Mops/s" << endl;
+	} // for
+
+	for ( long int p = 0; p < noOfProcessors - 1; p += 1 ) delete processors[p];
+	uEpoch::synchronize();
+
+	if ( errors != 0 ) {
+		cerr << "Error: " << errors << " failures" << endl;
+		return 1;
+	} // if
+	cout << "successful completion" << endl;
+} // main
+
+// Local Variables: //
+// compile-command: "u++ HashMap.cc" //
+// End: //
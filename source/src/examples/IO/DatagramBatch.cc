@@ -0,0 +1,152 @@
+//                              -*- Mode: C++ -*-
+//
+// uC++ Version 7.0.0, Copyright (C) Peter A. Buhr 2026
+//
+// DatagramBatch.cc -- Loopback benchmark of single versus batched datagram I/O.
+//
+// Author           : agent
+// Created On       : Mon Oct 19 00:53:35 2026
+// Last Modified By : agent
+// Last Modified On : Mon Oct 19 05:13:04 2026
+// Update Count     : 2
+//
+// This  library is free  software; you  can redistribute  it and/or  modify it
+// under the terms of the GNU Lesser General Public License as published by the
+// Free Software  Foundation; either  version 2.1 of  the License, or  (at your
+// option) any later version.
+//
+// This library is distributed in the  hope that it will be useful, but WITHOUT
+// ANY  WARRANTY;  without even  the  implied  warranty  of MERCHANTABILITY  or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+// for more details.
+//
+// You should  have received a  copy of the  GNU Lesser General  Public License
+// along  with this library.
+//
+
+#include <uSocket.h>
+#include <iostream>
+using std::cout;
+using std::cerr;
+using std::endl;
+#include <cstdlib>										// atoi
+
+// A client sends rounds of Window datagrams to a server over loopback, and the server acknowledges each round with
+// one datagram, so at most one window is queued in the socket buffer and no datagram is dropped. Each datagram carries
+// its sequence number, which the server checks. The transfer is timed using sendto/recvfrom for each datagram and then
+// using sendmmsg/recvmmsg for each window.
+
+enum { Window = 64, DatagramSize = 64 };
+unsigned int Rounds = 2000;
+
+struct Datagram {
+	unsigned int seq;
+	char data[DatagramSize - sizeof(unsigned int)];
+}; // Datagram
+
+_Task Server {
+	uSocketServer &server;
+	bool batched;
+	unsigned int &errors;
+
+	void main() {
+		Datagram dgrams[Window];
+		struct iovec iov[Window];
+		struct mmsghdr msgs[Window];
+		struct sockaddr_in from;						// sender of last batch
+		char ack = 'A';
+
+		for ( unsigned int seq = 0, r = 0; r < Rounds; r += 1 ) {
+			for ( unsigned int received = 0; received < Window; ) {
+				unsigned int cnt;
+				if ( batched ) {
+					memset( msgs, 0, sizeof(msgs) );
+					for ( unsigned int i = 0; i < Window - received; i += 1 ) {
+						iov[i] = { &dgrams[i], sizeof(Datagram) };
+						msgs[i].msg_hdr.msg_iov = &iov[i];
+						msgs[i].msg_hdr.msg_iovlen = 1;
+					} // for
+					msgs[0].msg_hdr.msg_name = &from;
+					msgs[0].msg_hdr.msg_namelen = sizeof(from);
+					cnt = server.recvmmsg( msgs, Window - received );
+					for ( unsigned int i = 0; i < cnt; i += 1 ) {
+						if ( msgs[i].msg_len != sizeof(Datagram) ) errors += 1;
+					} // for
+				} else {
+					if ( server.recvfrom( (char *)&dgrams[0], sizeof(Datagram) ) != sizeof(Datagram) ) errors += 1;
+					cnt = 1;
+				} // if
+				for ( unsigned int i = 0; i < cnt; i += 1, seq += 1 ) {
+					if ( dgrams[i].seq != seq ) errors += 1;
+				} // for
+				received += cnt;
+			} // for
+			if ( batched ) {
+				server.sendto( &ack, sizeof(ack), (struct sockaddr *)&from, sizeof(from) );
+			} else {
+				server.sendto( &ack, sizeof(ack) );		// reply to last sender
+			} // if
+		} // for
+	} // Server::main
+  public:
+	Server( uSocketServer &server, bool batched, unsigned int &errors ) : server( server ), batched( batched ), errors( errors ) {}
+}; // Server
+
+static double client( unsigned short port, bool batched ) {
+	uSocketClient client( port, SOCK_DGRAM );
+	Datagram dgrams[Window];
+	struct iovec iov[Window];
+	struct mmsghdr msgs[Window];
+	char ack;
+
+	memset( dgrams, 0, sizeof(dgrams) );
+	uTime start = uClock::currTime();
+	for ( unsigned int seq = 0, r = 0; r < Rounds; r += 1 ) {
+		if ( batched ) {
+			memset( msgs, 0, sizeof(msgs) );
+			for ( unsigned int i = 0; i < Window; i += 1, seq += 1 ) {
+				dgrams[i].seq = seq;
+				iov[i] = { &dgrams[i], sizeof(Datagram) };
+				msgs[i].msg_hdr.msg_iov = &iov[i];			// no address => server address
+				msgs[i].msg_hdr.msg_iovlen = 1;
+			} // for
+			client.sendmmsg( msgs, Window );
+			for ( unsigned int i = 0; i < Window; i += 1 ) {
+				if ( msgs[i].msg_hdr.msg_name != nullptr || msgs[i].msg_len != sizeof(Datagram) ) {
+					abort( "client : sendmmsg header %u modified or not sent", i );
+				} // if
+			} // for
+		} else {
+			for ( unsigned int i = 0; i < Window; i += 1, seq += 1 ) {
+				dgrams[0].seq = seq;
+				client.sendto( (char *)&dgrams[0], sizeof(Datagram) );
+			} // for
+		} // if
+		client.recvfrom( &ack, sizeof(ack) );			// wait for server to receive window
+	} // for
+	return (uClock::currTime() - start).nanoseconds() / 1000000000.0;
+} // client
+
+int main( int argc, char *argv[] ) {
+	if ( argc > 1 ) Rounds = atoi( argv[1] );			// optional number of rounds
+	unsigned int errors = 0;
+	double times[2];
+	for ( unsigned int batched = 0; batched < 2; batched += 1 ) {
+		unsigned short port;
+		uSocketServer server( &port, SOCK_DGRAM );		// create and bind a server socket to free port
+		Server s( server, batched, errors );
+		times[batched] = client( port, batched );
+	} // for
+	if ( errors != 0 ) {
+		cerr << "Error: " << errors << " damaged or out of order datagrams" << endl;
+		return 1;
+	} // if
+	unsigned long int dgrams = (unsigned long int)Rounds * Window;
+	cout << "sendto/recvfrom " << (unsigned long int)(dgrams / times[0]) << " datagrams/sec" << endl;
+	cout << "sendmmsg/recvmmsg " << (unsigned long int)(dgrams / times[1]) << " datagrams/sec" << endl;
+	cout << "successful completion" << endl;
+} // main
+
+// Local Variables: //
+// compile-command: "u++ DatagramBatch.cc" //
+// End: //
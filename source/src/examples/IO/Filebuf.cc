@@ -6,6 +6,7 @@
 #include <vector>										// vector
 #include <set>                                          // multiset
 #include <unistd.h>										// unlink
+#include <cstring>										// memcmp
 
 
 #define verify( x ) ( ( x ) ? true : ( ( std::cerr << "Error: assertion " #x " failed at " __FILE__ ":" << __LINE__ << "\n" ), false ) )
@@ -26,7 +27,7 @@ bool equalBuffers( std::filebuf &ibuf, std::filebuf &obuf ) {
 
 bool overflow_test( std::filebuf &ibuf, std::filebuf &obuf, char *testFile ) {
 	// overflow/underflow: copy input to output through various intermediate buffers
-	const int bufsizes[] = { 1, 193, 256 };				// single-byte, prime, power-of-two
+	const int bufsizes[] = { 1, 193, 256, 4096 };		// single-byte, prime, power-of-two, bypass small buffers
 	bool success = true;
 	for ( unsigned i = 0; i < sizeof( bufsizes ) / sizeof( int ); i += 1 ) {
 		std::cerr << "copy with intermediate " << bufsizes[ i ] << "-byte buffer: ";
@@ -135,7 +136,51 @@ bool seek_test( std::filebuf &ibuf, std::filebuf &obuf, char *testFile, std::ios
 	return success;
 } // seek_test
 
-	
+
+bool large_test() {
+	// adaptive file buffer and buffer bypass: mix of small and large transfers to a file larger than the maximum buffer
+	std::cerr << "large file with adaptive buffer: ";
+	bool success = true;
+	const int blksize = 100000, nblks = 60;
+	char *blk = new char[ blksize ], *intbuf = new char[ blksize ];
+
+	std::filebuf obuf;
+	obuf.open( tempFile, std::ios_base::out | std::ios_base::trunc );
+	success &= verify( obuf.is_open() );
+	success &= verify( obuf.getbufsize() == __U_FILE_BUFFER_SIZE__ );
+	for ( int b = 0; b < nblks; b += 1 ) {
+		for ( int i = 0; i < blksize; i += 1 ) blk[ i ] = 'a' + (b + i) % 26;
+		if ( b % 3 == 0 ) {								// large transfer
+			success &= verify( obuf.sputn( blk, blksize ) == blksize );
+		} else {										// character transfers
+			for ( int i = 0; i < blksize; i += 1 ) obuf.sputc( blk[ i ] );
+		} // if
+	} // for
+	success &= verify( obuf.getbufsize() > __U_FILE_BUFFER_SIZE__ ); // buffer grew
+	obuf.close();
+
+	std::filebuf ibuf;
+	ibuf.open( tempFile, std::ios_base::in );
+	success &= verify( ibuf.is_open() );
+	for ( int b = 0; b < nblks; b += 1 ) {
+		for ( int i = 0; i < blksize; i += 1 ) blk[ i ] = 'a' + (b + i) % 26;
+		if ( b % 2 == 0 ) {								// large transfer
+			success &= verify( ibuf.sgetn( intbuf, blksize ) == blksize );
+		} else {										// character transfers
+			for ( int i = 0; i < blksize; i += 1 ) intbuf[ i ] = ibuf.sbumpc();
+		} // if
+		success &= verify( memcmp( blk, intbuf, blksize ) == 0 );
+	} // for
+	success &= verify( ibuf.sgetn( intbuf, blksize ) == 0 ); // end of file
+	ibuf.close();
+
+	delete [] blk;
+	delete [] intbuf;
+	std::cerr << (success ? "success\n" : "failure\n");
+	return success;
+} // large_test
+
+
 int main( int argc, char *argv[] ) {
 	const int ibufsizes[] = { 0, 1, 512 };
 	const int obufsizes[] = { 0, 1, 512 };
@@ -159,6 +204,8 @@ int main( int argc, char *argv[] ) {
 		} // for
 	} // for
 
+	success &= large_test();
+
 	unlink( tempFile );
 	if ( success ) {
 		std::cerr << "All tests succeeded.\n";
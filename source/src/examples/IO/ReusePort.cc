@@ -0,0 +1,135 @@
+//                              -*- Mode: C++ -*-
+//
+// uC++ Version 7.0.0, Copyright (C) Peter A. Buhr 2026
+//
+// ReusePort.cc -- Several listening sockets on one port, each served by its own cluster.
+//
+// Author           : agent
+// Created On       : Mon Oct 19 00:56:37 2026
+// Last Modified By : agent
+// Last Modified On : Mon Oct 19 00:56:37 2026
+// Update Count     : 1
+//
+// This  library is free  software; you  can redistribute  it and/or  modify it
+// under the terms of the GNU Lesser General Public License as published by the
+// Free Software  Foundation; either  version 2.1 of  the License, or  (at your
+// option) any later version.
+//
+// This library is distributed in the  hope that it will be useful, but WITHOUT
+// ANY  WARRANTY;  without even  the  implied  warranty  of MERCHANTABILITY  or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+// for more details.
+//
+// You should  have received a  copy of the  GNU Lesser General  Public License
+// along  with this library.
+//
+
+#include <uSocket.h>
+#include <iostream>
+using std::cout;
+using std::cerr;
+using std::endl;
+#include <cstdio>										// snprintf
+
+// Each listener has its own cluster and processor, and a server socket bound to the same port with SO_REUSEPORT, so the
+// kernel distributes incoming connections among the listening sockets and each connection is accepted and served by
+// the processor of one listener, without sharing a listening socket or poller among processors. Clients connect to the
+// port, send a message, and check the echo.
+
+enum { NoOfListeners = 3, NoOfClients = 60, MessageSize = 32 };
+
+unsigned int accepted = 0;								// connections accepted by all listeners
+
+_Task Listener {
+	uSocketServer &server;
+	unsigned int &count;
+
+	void main() {
+		uDuration timeout( 0, 100000000 );				// check for completion every 1/10 second
+		while ( __atomic_load_n( &accepted, __ATOMIC_SEQ_CST ) < NoOfClients ) {
+			try {
+				uSocketAccept acceptor( server, &timeout ); // accept a connection from a client
+				__atomic_fetch_add( &accepted, 1, __ATOMIC_SEQ_CST );
+				count += 1;
+				char msg[MessageSize];
+				for ( int len = 0; len < MessageSize; ) {
+					int rlen = acceptor.read( msg + len, MessageSize - len );
+				  if ( rlen == 0 ) abort( "listener : EOF ecountered before message" );
+					len += rlen;
+				} // for
+				acceptor.write( msg, MessageSize );		// echo message
+			} catch( uSocketAccept::OpenTimeout & ) {
+			} // try
+		} // while
+	} // Listener::main
+  public:
+	Listener( uCluster &cluster, uSocketServer &server, unsigned int &count ) : uBaseTask( cluster ), server( server ), count( count ) {}
+}; // Listener
+
+_Task Client {
+	unsigned short port;
+	unsigned int id;
+	unsigned int &errors;
+
+	void main() {
+		uSocketClient client( port );					// connect to one of the listeners
+		char msg[MessageSize], echo[MessageSize];
+		snprintf( msg, MessageSize, "client %u", id );
+		client.write( msg, MessageSize );
+		for ( int len = 0; len < MessageSize; ) {
+			int rlen = client.read( echo + len, MessageSize - len );
+			if ( rlen == 0 ) {
+				errors += 1;
+				return;
+			} // if
+			len += rlen;
+		} // for
+		if ( memcmp( msg, echo, MessageSize ) != 0 ) errors += 1;
+	} // Client::main
+  public:
+	Client( unsigned short port, unsigned int id, unsigned int &errors ) : port( port ), id( id ), errors( errors ) {}
+}; // Client
+
+int main() {
+	unsigned short port;
+	uSocketServer * servers[NoOfListeners];
+	servers[0] = new uSocketServer( &port, SOCK_STREAM, 0, NoOfClients, true ); // free port
+	for ( unsigned int i = 1; i < NoOfListeners; i += 1 ) {
+		servers[i] = new uSocketServer( port, SOCK_STREAM, 0, NoOfClients, true ); // same port
+	} // for
+
+	unsigned int counts[NoOfListeners] = { 0 }, errors = 0;
+	{
+		uCluster * clusters[NoOfListeners];
+		uProcessor * processors[NoOfListeners];
+		Listener * listeners[NoOfListeners];
+		for ( unsigned int i = 0; i < NoOfListeners; i += 1 ) {
+			clusters[i] = new uCluster( "listener" );
+			processors[i] = new uProcessor( *clusters[i] );
+			listeners[i] = new Listener( *clusters[i], *servers[i], counts[i] );
+		} // for
+		{
+			Client * clients[NoOfClients];
+			for ( unsigned int i = 0; i < NoOfClients; i += 1 ) clients[i] = new Client( port, i, errors );
+			for ( unsigned int i = 0; i < NoOfClients; i += 1 ) delete clients[i];
+		}
+		for ( unsigned int i = 0; i < NoOfListeners; i += 1 ) {
+			delete listeners[i];
+			delete processors[i];
+			delete clusters[i];
+		} // for
+	}
+	for ( unsigned int i = 0; i < NoOfListeners; i += 1 ) delete servers[i];
+
+	unsigned int total = 0;
+	for ( unsigned int i = 0; i < NoOfListeners; i += 1 ) total += counts[i];
+	if ( errors != 0 || total != NoOfClients ) {
+		cerr << "Error: " << errors << " damaged echoes, " << total << " of " << NoOfClients << " connections accepted" << endl;
+		return 1;
+	} // if
+	cout << "successful completion" << endl;
+} // main
+
+// Local Variables: //
+// compile-command: "u++ ReusePort.cc" //
+// End: //
@@ -0,0 +1,153 @@
+//                              -*- Mode: C++ -*-
+//
+// uC++ Version 7.0.0, Copyright (C) Peter A. Buhr 2026
+//
+// Splice.cc -- Forward a stream through sockets, pipes and a file without copying it to user space.
+//
+// Author           : agent
+// Created On       : Mon Oct 19 01:00:39 2026
+// Last Modified By : agent
+// Last Modified On : Mon Oct 19 05:23:52 2026
+// Update Count     : 2
+//
+// This  library is free  software; you  can redistribute  it and/or  modify it
+// under the terms of the GNU Lesser General Public License as published by the
+// Free Software  Foundation; either  version 2.1 of  the License, or  (at your
+// option) any later version.
+//
+// This library is distributed in the  hope that it will be useful, but WITHOUT
+// ANY  WARRANTY;  without even  the  implied  warranty  of MERCHANTABILITY  or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+// for more details.
+//
+// You should  have received a  copy of the  GNU Lesser General  Public License
+// along  with this library.
+//
+
+#include <uSocket.h>
+#include <iostream>
+using std::cout;
+using std::cerr;
+using std::endl;
+#include <unistd.h>										// unlink
+
+// The sender maps its buffer into a pipe (vmsplice) and splices the pipe to a socket. The proxy splices the accepted
+// socket to a second pipe, duplicates the pipe data into a third pipe (tee) for a checker task, and splices the second
+// pipe to a file. The pipes are small relative to the transfer, so every stage blocks on full and empty pipes.
+
+enum { Total = 8 * 1024 * 1024, Chunk = 64 * 1024 };
+
+static inline char pattern( unsigned int i ) {
+	return (i * 7 + i / 4096) & 0xff;
+} // pattern
+
+_Task Sender {
+	const char *name;
+	const char *buf;
+
+	void main() {
+		uSocketClient client( name );
+		uPipe pipe;
+		for ( unsigned int sent = 0; sent < Total; ) {
+			struct iovec iov = { (void *)(buf + sent), Total - sent < Chunk ? Total - sent : Chunk };
+			ssize_t len = pipe.right().vmsplice( &iov, 1 ); // reference pages in pipe
+			for ( ssize_t moved = 0; moved < len; ) {
+				moved += client.splice( pipe.left(), len - moved ); // pipe to socket
+			} // for
+			sent += len;
+		} // for
+	} // Sender::main
+  public:
+	Sender( const char *name, const char *buf ) : name( name ), buf( buf ) {}
+}; // Sender
+
+_Task Checker {
+	uPipe::End &in;
+	unsigned int &errors;
+
+	void main() {
+		char buf[Chunk];
+		for ( unsigned int received = 0; received < Total; ) {
+			int len = in.read( buf, sizeof(buf) );
+			for ( int i = 0; i < len; i += 1 ) {
+				if ( buf[i] != pattern( received + i ) ) errors += 1;
+			} // for
+			received += len;
+		} // for
+	} // Checker::main
+  public:
+	Checker( uPipe::End &in, unsigned int &errors ) : in( in ), errors( errors ) {}
+}; // Checker
+
+_Task Proxy {
+	uSocketServer &server;
+	uFile::FileAccess &out;
+	unsigned int &errors;
+
+	void main() {
+		uSocketAccept acceptor( server );
+		uPipe forward, copy;
+		Checker checker( copy.left(), errors );
+		loff_t off = 0;
+		for ( ;; ) {
+			ssize_t len = forward.right().splice( acceptor, Chunk ); // socket to pipe
+		  if ( len == 0 ) break;						// sender closed socket ?
+			while ( len > 0 ) {
+				// tee copies from the front of the pipe, so consume exactly the bytes copied before the next tee.
+				ssize_t copied = copy.right().tee( forward.left(), len );
+				for ( ssize_t moved = 0; moved < copied; ) {
+					moved += out.splice( forward.left(), copied - moved, nullptr, &off ); // pipe to file
+				} // for
+				len -= copied;
+			} // while
+		} // for
+		if ( off != Total ) errors += 1;
+	} // Proxy::main
+  public:
+	Proxy( uSocketServer &server, uFile::FileAccess &out, unsigned int &errors ) : server( server ), out( out ), errors( errors ) {}
+}; // Proxy
+
+int main( int argc, char *argv[] ) {
+	const char *name = argc > 1 ? argv[1] : "socksplice";
+	const char *fname = "xxx";
+	char *buf = new char[Total];
+	for ( unsigned int i = 0; i < Total; i += 1 ) buf[i] = pattern( i );
+	unlink( name );
+
+	unsigned int errors = 0;
+	{
+		uSocketServer server( name );
+		uFile::FileAccess out( fname, O_WRONLY | O_CREAT | O_TRUNC, 0666 );
+		Proxy proxy( server, out, errors );
+		Sender sender( name, buf );
+	} // wait for sender and proxy
+	unlink( name );
+
+	uFile::FileAccess in( fname, O_RDONLY );			// check file contents
+	char rbuf[Chunk];
+	unsigned int received = 0;
+	for ( int len; ( len = in.read( rbuf, sizeof(rbuf) ) ) > 0; received += len ) {
+		for ( int i = 0; i < len; i += 1 ) {
+			if ( rbuf[i] != pattern( received + i ) ) errors += 1;
+		} // for
+	} // for
+	unlink( fname );
+	delete [] buf;
+
+	uPipe from, to;										// input-side error reported by the input
+	try {
+		to.right().splice( from.right(), Chunk );		// write end as input => EBADF
+		errors += 1;
+	} catch( uPipe::End::ReadFailure & ) {
+	} // try
+
+	if ( errors != 0 || received != Total ) {
+		cerr << "Error: " << errors << " damaged bytes, " << received << " of " << Total << " bytes in file" << endl;
+		return 1;
+	} // if
+	cout << "successful completion" << endl;
+} // main
+
+// Local Variables: //
+// compile-command: "u++ Splice.cc" //
+// End: //
@@ -0,0 +1,130 @@
+//                              -*- Mode: C++ -*-
+//
+// uC++ Version 7.0.0, Copyright (C) Peter A. Buhr 2026
+//
+// WriteCombining.cc -- Many tasks write messages to a shared socket with write combining.
+//
+// Author           : agent
+// Created On       : Mon Oct 19 00:28:43 2026
+// Last Modified By : agent
+// Last Modified On : Mon Oct 19 06:10:25 2026
+// Update Count     : 2
+//
+// This  library is free  software; you  can redistribute  it and/or  modify it
+// under the terms of the GNU Lesser General Public License as published by the
+// Free Software  Foundation; either  version 2.1 of  the License, or  (at your
+// option) any later version.
+//
+// This library is distributed in the  hope that it will be useful, but WITHOUT
+// ANY  WARRANTY;  without even  the  implied  warranty  of MERCHANTABILITY  or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+// for more details.
+//
+// You should  have received a  copy of the  GNU Lesser General  Public License
+// along  with this library.
+//
+
+#include <uSocket.h>
+#include <iostream>
+using std::cout;
+using std::cerr;
+using std::endl;
+#include <cstdio>										// snprintf
+#include <unistd.h>										// unlink
+
+// Writers share one client socket, like streams multiplexed on one connection. Each message is written by a single
+// write, send or writev, the latter through the uFileIO base class with the message split across two vectors, so write
+// combining must keep each message contiguous and each writer's messages in order. The reader is slow at first so the
+// socket buffer fills and writers queue behind the sending task.
+
+enum { NoOfWriters = 16, NoOfMessages = 2000, MessageSize = 48 };
+
+static void format( char *msg, unsigned int id, unsigned int seq ) {
+	int len = snprintf( msg, MessageSize, "writer %u message %u", id, seq );
+	for ( int i = len; i < MessageSize - 1; i += 1 ) msg[i] = 'a' + (id + seq + i) % 26; // pad to fixed size
+	msg[MessageSize - 1] = '\n';
+} // format
+
+_Task Writer {
+	uSocketClient &client;
+	unsigned int id;
+
+	void main() {
+		char msg[MessageSize];
+		uFileIO &file = client;
+		for ( unsigned int seq = 0; seq < NoOfMessages; seq += 1 ) {
+			format( msg, id, seq );
+			if ( seq % 3 == 0 ) {
+				client.write( msg, MessageSize );
+			} else if ( seq % 3 == 1 ) {
+				client.send( msg, MessageSize );
+			} else {
+				struct iovec iov[2] = { { msg, MessageSize / 2 }, { msg + MessageSize / 2, MessageSize - MessageSize / 2 } };
+				file.writev( iov, 2 );
+			} // if
+			if ( seq % 50 == 0 ) yield();
+		} // for
+	} // Writer::main
+  public:
+	Writer( uSocketClient &client, unsigned int id ) : client( client ), id( id ) {}
+}; // Writer
+
+_Task Reader {
+	uSocketServer &server;
+	unsigned int &errors;
+
+	void main() {
+		uSocketAccept acceptor( server );
+		unsigned int next[NoOfWriters] = { 0 };
+		char msg[MessageSize], expect[MessageSize];
+
+		yield( 100 );									// let the socket buffer fill
+		for ( unsigned int m = 0; m < NoOfWriters * NoOfMessages; m += 1 ) {
+			for ( int len = 0; len < MessageSize; ) {
+				int rlen = acceptor.read( msg + len, MessageSize - len );
+				if ( rlen == 0 ) {
+					cerr << "Error: EOF after " << m << " messages" << endl;
+					errors += 1;
+					return;
+				} // if
+				len += rlen;
+			} // for
+			unsigned int id, seq;
+			if ( sscanf( msg, "writer %u message %u", &id, &seq ) != 2 || id >= NoOfWriters || seq != next[id] ) {
+				errors += 1;
+				continue;
+			} // if
+			format( expect, id, seq );
+			if ( memcmp( msg, expect, MessageSize ) != 0 ) errors += 1;
+			next[id] += 1;
+		} // for
+	} // Reader::main
+  public:
+	Reader( uSocketServer &server, unsigned int &errors ) : server( server ), errors( errors ) {}
+}; // Reader
+
+int main( int argc, char *argv[] ) {
+	const char *name = argc > 1 ? argv[1] : "sockwc";
+	unlink( name );
+	uProcessor processors[3] __attribute__(( unused )); // more than one processor
+	unsigned int errors = 0;
+	uSocketServer server( name );
+	{
+		Reader reader( server, errors );
+		uSocketClient client( name );
+		client.setWriteCombining( true );
+		Writer * writers[NoOfWriters];
+		for ( unsigned int i = 0; i < NoOfWriters; i += 1 ) writers[i] = new Writer( client, i );
+		for ( unsigned int i = 0; i < NoOfWriters; i += 1 ) delete writers[i];
+	} // wait for reader
+	unlink( name );
+	if ( errors != 0 ) {
+		cerr << "Error: " << errors << " damaged or out of order messages" << endl;
+		return 1;
+	} // if
+	cout << "successful completion" << endl;
+} // main
+
+// Local Variables: //
+// compile-command: "u++ WriteCombining.cc" //
+// End: //
@@ -0,0 +1,109 @@
+//                              -*- Mode: C++ -*-
+//
+// uC++ Version 7.0.0, Copyright (C) Peter A. Buhr 2026
+//
+// ZeroCopy.cc -- Large socket writes with MSG_ZEROCOPY, reusing the buffer after each write.
+//
+// Author           : agent
+// Created On       : Mon Oct 19 01:03:08 2026
+// Last Modified By : agent
+// Last Modified On : Mon Oct 19 05:02:36 2026
+// Update Count     : 2
+//
+// This  library is free  software; you  can redistribute  it and/or  modify it
+// under the terms of the GNU Lesser General Public License as published by the
+// Free Software  Foundation; either  version 2.1 of  the License, or  (at your
+// option) any later version.
+//
+// This library is distributed in the  hope that it will be useful, but WITHOUT
+// ANY  WARRANTY;  without even  the  implied  warranty  of MERCHANTABILITY  or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+// for more details.
+//
+// You should  have received a  copy of the  GNU Lesser General  Public License
+// along  with this library.
+//
+
+#include <uSocket.h>
+#include <iostream>
+using std::cout;
+using std::cerr;
+using std::endl;
+#include <cstring>										// memset
+
+// The client writes blocks with zero-copy send and refills the same buffer as soon as each write returns, so the
+// receiver sees a damaged block if a write returns while the kernel still references the buffer. Small writes between
+// the blocks take the copying path. Over loopback the kernel copies the data, but completions are still reported. The
+// client never reads the data the receiver sends it, so its socket stays readable while waiting for completions.
+
+enum { NoOfBlocks = 64, BlockSize = 1024 * 1024, SmallSize = 100 };
+
+static inline char pattern( unsigned int block, unsigned int i ) {
+	return (block * 31 + i / 512) & 0xff;
+} // pattern
+
+_Task Receiver {
+	uSocketServer &server;
+	unsigned int &errors;
+
+	void main() {
+		uSocketAccept acceptor( server );
+		char *buf = new char[BlockSize];
+		acceptor.write( "unread", 6 );					// client socket readable without completions
+		for ( unsigned int b = 0; b < NoOfBlocks; b += 1 ) {
+			for ( int len = 0; len < BlockSize; ) {
+				int rlen = acceptor.read( buf + len, BlockSize - len );
+				if ( rlen == 0 ) abort( "receiver : EOF ecountered before block %u", b );
+				len += rlen;
+			} // for
+			for ( unsigned int i = 0; i < BlockSize; i += 1 ) {
+				if ( buf[i] != pattern( b, i ) ) { errors += 1; break; }
+			} // for
+			for ( int len = 0; len < SmallSize; ) {
+				int rlen = acceptor.read( buf + len, SmallSize - len );
+				if ( rlen == 0 ) abort( "receiver : EOF ecountered before small write %u", b );
+				len += rlen;
+			} // for
+			for ( unsigned int i = 0; i < SmallSize; i += 1 ) {
+				if ( buf[i] != (char)b ) { errors += 1; break; }
+			} // for
+		} // for
+		delete [] buf;
+	} // Receiver::main
+  public:
+	Receiver( uSocketServer &server, unsigned int &errors ) : server( server ), errors( errors ) {}
+}; // Receiver
+
+int main() {
+	unsigned short port;
+	uSocketServer server( &port );						// create and bind a server socket to free port
+	unsigned int errors = 0;
+	{
+		Receiver receiver( server, errors );
+		uSocketClient client( port );
+		if ( client.setZeroCopy( true ) == -1 ) {
+			cerr << "zero-copy send not supported, using copying send" << endl;
+		} // if
+		char *buf = new char[BlockSize], small[SmallSize];
+		for ( unsigned int b = 0; b < NoOfBlocks; b += 1 ) {
+			for ( unsigned int i = 0; i < BlockSize; i += 1 ) buf[i] = pattern( b, i ); // reuse buffer
+			if ( b % 2 == 0 ) {
+				client.write( buf, BlockSize );
+			} else {
+				client.send( buf, BlockSize );
+			} // if
+			memset( small, b, SmallSize );
+			client.write( small, SmallSize );
+		} // for
+		delete [] buf;
+	} // wait for receiver
+	if ( errors != 0 ) {
+		cerr << "Error: " << errors << " damaged blocks" << endl;
+		return 1;
+	} // if
+	cout << "successful completion" << endl;
+} // main
+
+// Local Variables: //
+// compile-command: "u++ ZeroCopy.cc" //
+// End: //
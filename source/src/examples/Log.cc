@@ -0,0 +1,117 @@
+//                              -*- Mode: C++ -*-
+//
+// uC++ Version 7.0.0, Copyright (C) Peter A. Buhr 2026
+//
+// Log.cc -- Test asynchronous logging from many tasks on multiple processors.
+//
+// Author           : agent
+// Created On       : Mon Oct 19 00:23:51 2026
+// Last Modified By : agent
+// Last Modified On : Mon Oct 19 00:23:51 2026
+// Update Count     : 1
+//
+// This  library is free  software; you  can redistribute  it and/or  modify it
+// under the terms of the GNU Lesser General Public License as published by the
+// Free Software  Foundation; either  version 2.1 of  the License, or  (at your
+// option) any later version.
+//
+// This library is distributed in the  hope that it will be useful, but WITHOUT
+// ANY  WARRANTY;  without even  the  implied  warranty  of MERCHANTABILITY  or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+// for more details.
+//
+// You should  have received a  copy of the  GNU Lesser General  Public License
+// along  with this library.
+//
+
+#include <uLog.h>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+using namespace std;
+#include <fcntl.h>										// open
+#include <unistd.h>										// unlink
+
+// Many tasks log records on several processors while the log buffers are small, so producers wrap around and wait for
+// the writer. Each record has a checksum so a split or interleaved record is detected when the log is read back.
+
+enum { NoOfTasks = 20, NoOfRecords = 2000, NoOfProcessors = 4 };
+const char * logFile = "xxx";
+
+static unsigned int checksum( unsigned int id, unsigned int rec ) {
+	return (id * 7919 + rec * 104729) % 1000003;
+} // checksum
+
+_Task Logger {
+	unsigned int id;
+
+	void main() {
+		for ( unsigned int r = 0; r < NoOfRecords; r += 1 ) {
+			uLog() << "task " << id << " record " << r << " check " << checksum( id, r ) << endl;
+			if ( r % 100 == 0 ) yield();				// encourage interleaving and migration
+		} // for
+		uLog() << "task " << id << " record " << NoOfRecords << " multi-line" << endl << "  continuation" << endl;
+	} // Logger::main
+  public:
+	Logger( unsigned int id ) : id( id ) {}
+}; // Logger
+
+int main() {
+	int fd = open( logFile, O_WRONLY | O_CREAT | O_TRUNC, 0666 );
+	if ( fd == -1 ) {
+		cerr << "Error: cannot open " << logFile << endl;
+		return 1;
+	} // if
+	string big( 10000, 'x' );							// larger than a processor buffer
+	uLog::open( fd, 4096 );								// small buffers => producers wait for the writer
+	{
+		uProcessor processors[NoOfProcessors - 1] __attribute__(( unused )); // more than one processor
+		Logger * loggers[NoOfTasks];
+		for ( unsigned int i = 0; i < NoOfTasks; i += 1 ) loggers[i] = new Logger( i );
+		uLog() << "big " << big << endl;
+		for ( unsigned int i = 0; i < NoOfTasks; i += 1 ) delete loggers[i];
+	}
+	uLog::flush();
+	uLog::close();										// closes fd
+
+	// Check every record is intact and each task logged all its records.
+	ifstream in( logFile );
+	unsigned int counts[NoOfTasks] = { 0 }, bigs = 0, bad = 0;
+	for ( string line; getline( in, line ); ) {
+		istringstream is( line );
+		string word, record, check;
+		unsigned int id, r, sum;
+		if ( line.compare( 0, 4, "big " ) == 0 ) {
+			if ( line.size() == 4 + big.size() ) bigs += 1; else bad += 1;
+		} else if ( line == "  continuation" ) {
+		} else if ( is >> word >> id >> record >> r && id < NoOfTasks ) {
+			if ( r == NoOfRecords ) {					// last record: continuation follows immediately
+				string next;
+				if ( getline( in, next ) && next == "  continuation" ) counts[id] += 1; else bad += 1;
+			} else if ( is >> check >> sum && sum == checksum( id, r ) && is.eof() ) {
+				counts[id] += 1;
+			} else {
+				bad += 1;
+			} // if
+		} else {
+			bad += 1;
+		} // if
+	} // for
+	unlink( logFile );
+
+	for ( unsigned int i = 0; i < NoOfTasks; i += 1 ) {
+		if ( counts[i] != NoOfRecords + 1 ) bad += 1;
+	} // for
+	if ( bad != 0 || bigs != 1 ) {
+		cerr << "Error: " << bad << " damaged or missing records" << endl;
+		return 1;
+	} // if
+
+	uLog() << "log closed, written directly" << endl;
+	cout << "successful completion" << endl;
+} // main
+
+// Local Variables: //
+// compile-command: "u++ Log.cc" //
+// End: //
@@ -0,0 +1,126 @@
+//                              -*- Mode: C++ -*-
+//
+// uC++ Version 7.0.0, Copyright (C) Peter A. Buhr 2026
+//
+// PRNGFill.cc -- Check and time bulk random-number generation.
+//
+// Author           : agent
+// Created On       : Mon Oct 19 01:25:58 2026
+// Last Modified By : agent
+// Last Modified On : Mon Oct 19 01:25:58 2026
+// Update Count     : 1
+//
+// This  library is free  software; you  can redistribute  it and/or  modify it
+// under the terms of the GNU Lesser General Public License as published by the
+// Free Software  Foundation; either  version 2.1 of  the License, or  (at your
+// option) any later version.
+//
+// This library is distributed in the  hope that it will be useful, but WITHOUT
+// ANY  WARRANTY;  without even  the  implied  warranty  of MERCHANTABILITY  or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+// for more details.
+//
+// You should  have received a  copy of the  GNU Lesser General  Public License
+// along  with this library.
+//
+
+#include <uPRNG.h>
+#include <iostream>
+#include <iomanip>
+using namespace std;
+#include <cmath>										// sqrt
+
+enum { BUCKETS = 1'000, N = 10'000'000, TRIALS = 10 };
+
+// Relative standard deviation of the bucket counts, which is about 1% for N / BUCKETS values per bucket.
+static double rstd( const size_t buckets[] ) {
+	double avg = (double)N / BUCKETS, sum = 0.0;
+	for ( size_t i = 0; i < BUCKETS; i += 1 ) {
+		double diff = buckets[i] - avg;
+		sum += diff * diff;
+	} // for
+	return sqrt( sum / BUCKETS ) / avg * 100;
+} // rstd
+
+template< typename P, typename T, typename F > static unsigned int check( const char *name, T buf[], F fbuf[] ) {
+	unsigned int errors = 0;
+	size_t * buckets = new size_t[BUCKETS]();
+
+	P prng1( 1009 ), prng2( 1009 );						// same seed => same values
+	T * buf2 = new T[N];
+	prng1.fill( buf, N );
+	prng2.fill( buf2, N );
+	for ( size_t i = 0; i < N; i += 1 ) if ( buf[i] != buf2[i] ) { errors += 1; break; }
+	if ( prng1.calls() != N ) errors += 1;
+	prng1.fill( buf2, N );								// next fill => different values
+	if ( buf[0] == buf2[0] && buf[N - 1] == buf2[N - 1] ) errors += 1;
+	delete [] buf2;
+
+	prng1.fill( buf, N, BUCKETS );						// [0,u)
+	for ( size_t i = 0; i < N; i += 1 ) {
+		if ( buf[i] >= BUCKETS ) { errors += 1; break; }
+		buckets[buf[i]] += 1;
+	} // for
+	double r = rstd( buckets );
+	if ( r > 2.0 ) errors += 1;
+
+	prng1.fill( buf, N - 3, 5, 21 );					// [l,u], odd length
+	for ( size_t i = 0; i < N - 3; i += 1 ) if ( buf[i] < 5 || buf[i] > 21 ) { errors += 1; break; }
+
+	prng1.fill( fbuf, N );								// [0,1)
+	for ( size_t i = 0; i < BUCKETS; i += 1 ) buckets[i] = 0;
+	for ( size_t i = 0; i < N; i += 1 ) {
+		if ( fbuf[i] < 0 || fbuf[i] >= 1 ) { errors += 1; break; }
+		buckets[(size_t)(fbuf[i] * BUCKETS)] += 1;
+	} // for
+	double fr = rstd( buckets );
+	if ( fr > 2.0 ) errors += 1;
+	delete [] buckets;
+
+	cout << name << fixed << setprecision(2) << " rstd integer " << r << "% float " << fr << "%" << endl;
+	return errors;
+} // check
+
+template< typename P, typename T > static void timing( const char *name, T buf[] ) {
+	enum { Chunk = 4096 };								// buffer in cache => generation cost
+	P prng( 1009 );
+	uTime start = uClock::currTime();
+	for ( size_t t = 0; t < (size_t)N * TRIALS / Chunk; t += 1 ) {
+		for ( size_t i = 0; i < Chunk; i += 1 ) buf[i] = prng();
+		asm volatile( "" : : "r" (buf) : "memory" );	// prevent removing stores
+	} // for
+	double scalar = (uClock::currTime() - start).nanoseconds() / 1000000000.0;
+	start = uClock::currTime();
+	for ( size_t t = 0; t < (size_t)N * TRIALS / Chunk; t += 1 ) {
+		prng.fill( buf, Chunk );
+	} // for
+	double bulk = (uClock::currTime() - start).nanoseconds() / 1000000000.0;
+	cout << name << setprecision(2) << " operator() " << scalar << " fill " << bulk << " seconds" << endl;
+} // timing
+
+int main() {
+	unsigned int errors = 0;
+	uint64_t * buf64 = new uint64_t[N];
+	double * dbuf = new double[N];
+	uint32_t * buf32 = new uint32_t[N];
+	float * fbuf = new float[N];
+
+	errors += check<PRNG64>( "PRNG64", buf64, dbuf );
+	errors += check<PRNG32>( "PRNG32", buf32, fbuf );
+	timing<PRNG64>( "PRNG64", buf64 );
+	timing<PRNG32>( "PRNG32", buf32 );
+
+	delete [] fbuf;
+	delete [] buf32;
+	delete [] dbuf;
+	delete [] buf64;
+	if ( errors != 0 ) {
+		cerr << "Error: " << errors << " failures" << endl;
+		return 1;
+	} // if
+	cout << "successful completion" << endl;
+} // main
+
+// Local Variables: //
+// compile-command: "u++ PRNGFill.cc" //
+// End: //
@@ -35,47 +35,72 @@ const unsigned int NoOfTimes =
 #endif // __U_STATISTICS__
 const unsigned int Work = 100;
 
-uRWLock rwlock;
+volatile unsigned int writing = 0;						// writers in critical section
+
+template< typename Lock > _Task Reader {
+	Lock & rwlock;
 
-_Task Reader {
 	void main() {
 		for ( unsigned int i = 0; i < NoOfTimes; i += 1 ) {
 			rwlock.rdacquire();
+			if ( writing != 0 ) abort( "reader interference" );
 			// if ( rwlock.wrcnt() != 0 )
 			// 	abort( "reader interference: wcnt %d, rcnt %d", rwlock.wrcnt(), rwlock.rdcnt() );
 			for ( volatile unsigned int b = 0; b < Work; b += 1 );
 			// if ( rwlock.wrcnt() != 0 )
 			//     abort( "reader interference: wcnt %d, rcnt %d", rwlock.wrcnt(), rwlock.rdcnt() );
+			if ( writing != 0 ) abort( "reader interference" );
 			rwlock.rdrelease();
 		} // for
 	} // main
   public:
+	Reader( Lock & rwlock ) : rwlock( rwlock ) {}
 };
 
-_Task Writer {
+template< typename Lock > _Task Writer {
+	Lock & rwlock;
+
 	void main() {
 		for ( unsigned int i = 0; i < NoOfTimes; i += 1 ) {
 			for ( volatile unsigned int b = 0; b < Work; b += 1 );
 			rwlock.wracquire();
+			if ( writing != 0 ) abort( "writer interference" );
+			writing += 1;
 			// if ( rwlock.wrcnt() != 1 || rwlock.rdcnt() != 0 )
 			// 	abort( "writer interference: wcnt %d, rcnt %d", rwlock.wrcnt(), rwlock.rdcnt() );
 			for ( volatile unsigned int b = 0; b < Work; b += 1 );
 			// if ( rwlock.wrcnt() != 1 || rwlock.rdcnt() != 0 )
 			//     abort( "writer interference: wcnt %d, rcnt %d", rwlock.wrcnt(), rwlock.rdcnt() );
+			writing -= 1;
 			rwlock.wrrelease();
 			for ( volatile unsigned int b = 0; b < Work; b += 1 );
 		} // for
 	} // main
   public:
+	Writer( Lock & rwlock ) : rwlock( rwlock ) {}
 }; // Writer
 
+template< typename Lock > void test( Lock & rwlock ) {
+	enum { NoOfReaders = 6, NoOfWriters = 2 };
+	Writer< Lock > * writers[NoOfWriters];
+	Reader< Lock > * readers[NoOfReaders];
+	for ( unsigned int i = 0; i < NoOfWriters; i += 1 ) writers[i] = new Writer< Lock >( rwlock );
+	for ( unsigned int i = 0; i < NoOfReaders; i += 1 ) readers[i] = new Reader< Lock >( rwlock );
+	for ( unsigned int i = 0; i < NoOfReaders; i += 1 ) delete readers[i];
+	for ( unsigned int i = 0; i < NoOfWriters; i += 1 ) delete writers[i];
+} // test
+
 
 int main() {
-	enum { NoOfReaders = 6, NoOfWriters = 2 };
-	uProcessor p[NoOfReaders + NoOfWriters];
+	enum { NoOfProcessors = 8 };
+	uProcessor p[NoOfProcessors];
+	{
+		uRWLock rwlock;
+		test( rwlock );
+	}
 	{
-		Writer writers[NoOfWriters];
-		Reader readers[NoOfReaders];
+		uBiasedRWLock<> rwlock;
+		test( rwlock );
 	}
 	cout << "successful completion" << endl;
 } // main
@@ -0,0 +1,104 @@
+//                              -*- Mode: C++ -*-
+//
+// uC++ Version 7.0.0, Copyright (C) Peter A. Buhr 2026
+//
+// Reclaim.cc -- Lock-free queue and stack with epoch and hazard-pointer memory reclamation.
+//
+// Author           : agent
+// Created On       : Mon Oct 19 01:49:07 2026
+// Last Modified By : agent
+// Last Modified On : Mon Oct 19 01:49:07 2026
+// Update Count     : 1
+//
+// This  library is free  software; you  can redistribute  it and/or  modify it
+// under the terms of the GNU Lesser General Public License as published by the
+// Free Software  Foundation; either  version 2.1 of  the License, or  (at your
+// option) any later version.
+//
+// This library is distributed in the  hope that it will be useful, but WITHOUT
+// ANY  WARRANTY;  without even  the  implied  warranty  of MERCHANTABILITY  or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+// for more details.
+//
+// You should  have received a  copy of the  GNU Lesser General  Public License
+// along  with this library.
+//
+
+#include <uQueueLF.h>
+#include <iostream>
+using namespace std;
+
+// Workers on several processors push and pop the same queue and stack, so nodes are retired while other workers may
+// still be reading them. Every value pushed must be popped exactly once, and after the processors are deleted and the
+// nodes retired on them are reclaimed, every node must have been deleted.
+
+enum { NoOfProcessors = 4, NoOfWorkers = 8, NoOfItems = 100000 };
+
+struct Item {
+	static volatile long int live;						// items in nodes not yet deleted
+	long int value;
+
+	Item( long int value = 0 ) : value( value ) { uFetchAdd( live, 1 ); }
+	Item( const Item & item ) : value( item.value ) { uFetchAdd( live, 1 ); }
+	Item & operator=( const Item & ) = default;
+	~Item() { uFetchAdd( live, -1 ); }
+}; // Item
+volatile long int Item::live = 0;
+
+_Task Worker {
+	uQueueLF<Item> & queue;
+	uStackLFR<Item> & stack;
+	long int id, & sum;
+
+	void main() {
+		Item item;
+		for ( long int i = 0; i < NoOfItems; i += 1 ) {
+			queue.push( Item( id * NoOfItems + i ) );
+			stack.push( Item( id * NoOfItems + i ) );
+			if ( queue.pop( item ) ) sum += item.value;
+			if ( stack.pop( item ) ) sum += item.value;
+			if ( i % 64 == 0 ) yield();					// mix tasks across processors
+		} // for
+	} // Worker::main
+  public:
+	Worker( uQueueLF<Item> & queue, uStackLFR<Item> & stack, long int id, long int & sum ) :
+		queue( queue ), stack( stack ), id( id ), sum( sum ) {}
+}; // Worker
+
+int main() {
+	unsigned int errors = 0;
+	long int sums[NoOfWorkers] = { 0 }, sum = 0;
+	{
+		uQueueLF<Item> queue;
+		uStackLFR<Item> stack;
+		{
+			uProcessor processors[NoOfProcessors - 1] __attribute__(( unused )); // more than one processor
+			Worker * workers[NoOfWorkers];
+			for ( long int w = 0; w < NoOfWorkers; w += 1 ) workers[w] = new Worker( queue, stack, w, sums[w] );
+			for ( long int w = 0; w < NoOfWorkers; w += 1 ) delete workers[w];
+		} // processors deleted, their retired nodes move to this processor
+
+		Item item;
+		while ( queue.pop( item ) ) sum += item.value;	// pushes and pops are unbalanced on contention
+		while ( stack.pop( item ) ) sum += item.value;
+		for ( long int w = 0; w < NoOfWorkers; w += 1 ) sum += sums[w];
+		if ( sum != 2 * ( (long int)NoOfWorkers * NoOfItems * ( NoOfWorkers * NoOfItems - 1 ) / 2 ) ) errors += 1;
+
+		uEpoch::synchronize();							// delete retired nodes
+		uHazardPointer::reclaim();
+	}
+	if ( Item::live != 0 ) {
+		cerr << "Error: " << Item::live << " items not deleted" << endl;
+		errors += 1;
+	} // if
+
+	if ( errors != 0 ) {
+		cerr << "Error: " << errors << " failures" << endl;
+		return 1;
+	} // if
+	cout << "successful completion" << endl;
+} // main
+
+// Local Variables: //
+// compile-command: "u++ Reclaim.cc" //
+// End: //
@@ -0,0 +1,133 @@
+//                              -*- Mode: C++ -*-
+//
+// uC++ Version 7.0.0, Copyright (C) Peter A. Buhr 2026
+//
+// Region.cc -- Request handlers allocating from a region per request
+//
+// Author           : agent
+// Created On       : Mon Oct 19 03:20:18 2026
+// Last Modified By : agent
+// Last Modified On : Mon Oct 19 03:20:18 2026
+// Update Count     : 1
+//
+// This  library is free  software; you  can redistribute  it and/or  modify it
+// under the terms of the GNU Lesser General Public License as published by the
+// Free Software  Foundation; either  version 2.1 of  the License, or  (at your
+// option) any later version.
+//
+// This library is distributed in the  hope that it will be useful, but WITHOUT
+// ANY  WARRANTY;  without even  the  implied  warranty  of MERCHANTABILITY  or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+// for more details.
+//
+// You should  have received a  copy of the  GNU Lesser General  Public License
+// along  with this library.
+//
+
+#include <uRegion.h>
+#include <vector>
+#include <string>
+#include <map>
+#include <iostream>
+using namespace std;
+
+// Handlers on several processors each build a request from many small objects, with the same code allocating from the
+// heap or from a region declared for the request, so the results must match. Nested regions, release and the region
+// storage are also checked.
+
+enum { NoOfProcessors = 4, NoOfHandlers = 8, NoOfRequests = 20000, NoOfFields = 40 };
+
+struct Field {											// trivial destructor
+	Field * next;
+	long int key, value;
+}; // Field
+
+template< typename T > using RVector = vector< T, uRegion::Allocator< T > >;
+typedef basic_string< char, char_traits< char >, uRegion::Allocator< char > > RString;
+
+// Build a request and return a checksum. A region, if any, is current, so the containers take it by default.
+template< typename Vector, typename String > static long int request( long int id, bool region ) {
+	Field * fields = nullptr;
+	Vector values;
+	for ( long int i = 0; i < NoOfFields; i += 1 ) {
+		Field * f = region ? new( *uRegion::current() ) Field : new Field;
+		*f = { fields, id + i, id * i };
+		fields = f;
+		values.push_back( String( "field value " ) + to_string( i ).c_str() ); // longer than short-string buffer
+	} // for
+
+	long int sum = 0;
+	for ( Field * f = fields; f != nullptr; f = f->next ) sum += f->key ^ f->value;
+	for ( auto & v : values ) sum += v.size();
+	if ( ! region ) {
+		for ( Field * f = fields; f != nullptr; ) { Field * n = f->next; delete f; f = n; }
+	} // if
+	return sum;
+} // request
+
+_Task Handler {
+	long int id, & sum, & regionSum;
+
+	void main() {
+		for ( long int r = 0; r < NoOfRequests; r += 1 ) {
+			sum += request< vector< string >, string >( id * NoOfRequests + r, false );
+			if ( r % 64 == 0 ) yield();					// mix tasks across processors
+		} // for
+		for ( long int r = 0; r < NoOfRequests; r += 1 ) {
+			uRegion region;								// storage freed at end of request
+			regionSum += request< RVector< RString >, RString >( id * NoOfRequests + r, true );
+			if ( r % 64 == 0 ) yield();
+		} // for
+	} // Handler::main
+  public:
+	Handler( long int id, long int & sum, long int & regionSum ) : id( id ), sum( sum ), regionSum( regionSum ) {}
+}; // Handler
+
+int main() {
+	unsigned int errors = 0;
+
+	if ( uRegion::current() != nullptr ) errors += 1;
+	{
+		uRegion outer( 4096 );
+		if ( uRegion::current() != &outer ) errors += 1;
+		char * a = (char *)outer.alloc( 10, 1 ), * b = (char *)outer.alloc( 10, 1 );
+		if ( b != a + 10 ) errors += 1;					// bump allocation
+		char * c = (char *)outer.alloc( 8, 64 );
+		if ( (uintptr_t)c % 64 != 0 ) errors += 1;		// alignment
+		if ( outer.alloc( 100000 ) == nullptr ) errors += 1; // own chunk, bump chunk kept
+		if ( outer.alloc( 1, 1 ) != c + 8 ) errors += 1;
+		{
+			uRegion inner;
+			if ( uRegion::current() != &inner ) errors += 1;
+			map< int, int, less< int >, uRegion::Allocator< pair< const int, int > > > m;
+			for ( int i = 0; i < 1000; i += 1 ) m[i] = i;
+			if ( m.size() != 1000 || m[999] != 999 ) errors += 1;
+		}
+		if ( uRegion::current() != &outer ) errors += 1;
+		outer.release();								// only bump chunk kept
+		if ( outer.storage() != 4096 ) errors += 1;
+		if ( outer.alloc( 10, 1 ) != a ) errors += 1;	// storage reused
+	}
+	if ( uRegion::current() != nullptr ) errors += 1;
+
+	long int sums[NoOfHandlers] = { 0 }, regionSums[NoOfHandlers] = { 0 };
+	{
+		uProcessor processors[NoOfProcessors - 1] __attribute__(( unused )); // more than one processor
+		Handler * handlers[NoOfHandlers];
+		for ( long int h = 0; h < NoOfHandlers; h += 1 ) handlers[h] = new Handler( h, sums[h], regionSums[h] );
+		for ( long int h = 0; h < NoOfHandlers; h += 1 ) delete handlers[h];
+	}
+	for ( long int h = 0; h < NoOfHandlers; h += 1 ) {
+		if ( sums[h] != regionSums[h] ) errors += 1;
+	} // for
+
+	if ( errors != 0 ) {
+		cerr << "Error: " << errors << " failures" << endl;
+		return 1;
+	} // if
+	cout << "successful completion" << endl;
+} // main
+
+// Local Variables: //
+// compile-command: "u++ Region.cc" //
+// End: //
@@ -0,0 +1,162 @@
+//                              -*- Mode: C++ -*-
+//
+// uC++ Version 7.0.0, Copyright (C) Peter A. Buhr 2026
+//
+// Ring.cc -- Check uRing against uSequence, and a cluster using uRingScheduler.
+//
+// Author           : agent
+// Created On       : Mon Oct 19 01:31:10 2026
+// Last Modified By : agent
+// Last Modified On : Mon Oct 19 06:02:50 2026
+// Update Count     : 2
+//
+// This  library is free  software; you  can redistribute  it and/or  modify it
+// under the terms of the GNU Lesser General Public License as published by the
+// Free Software  Foundation; either  version 2.1 of  the License, or  (at your
+// option) any later version.
+//
+// This library is distributed in the  hope that it will be useful, but WITHOUT
+// ANY  WARRANTY;  without even  the  implied  warranty  of MERCHANTABILITY  or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+// for more details.
+//
+// You should  have received a  copy of the  GNU Lesser General  Public License
+// along  with this library.
+//
+
+#include <uRing.h>
+#include <uRingScheduler.h>
+#include <uPRNG.h>
+#include <iostream>
+using namespace std;
+
+// The same random operations are applied to a uRing and a uSequence of separate nodes with the same values, and the
+// element orders are compared after each operation. Then tasks on a cluster using uRingScheduler yield, and migrate
+// off the cluster and back, which adds and drops them from the ring ready queue.
+
+struct Fred : public uSeqable {
+	int i;
+	Fred( int i ) : i( i ) {}
+};
+
+static bool same( uRing<Fred> & ring, uSequence<Fred> & seq ) {
+	uRingIter<Fred> riter( ring );
+	uSeqIter<Fred> siter( seq );
+	Fred * r, * s;
+	for ( ;; ) {
+		bool rmore = riter >> r, smore = siter >> s;
+	  if ( rmore != smore ) return false;
+	  if ( ! rmore ) break;
+	  if ( r->i != s->i ) return false;
+	} // for
+	return ( ring.head() == nullptr ) == ( seq.head() == nullptr ) &&
+		( ring.empty() || ( ring.head()->i == seq.head()->i && ring.tail()->i == seq.tail()->i ) );
+} // same
+
+enum { Nodes = 500, Ops = 200'000 };
+
+static unsigned int checkRing() {
+	Fred * rnodes[Nodes], * snodes[Nodes];
+	for ( int i = 0; i < Nodes; i += 1 ) {
+		rnodes[i] = new Fred( i );
+		snodes[i] = new Fred( i );
+	} // for
+
+	unsigned int errors = 0;
+	uRing<Fred> ring( 4 );								// small => grow and compact
+	uSequence<Fred> seq;
+	PRNG prng( 1009 );
+	for ( unsigned int op = 0; op < Ops && errors == 0; op += 1 ) {
+		int n = prng( Nodes );
+		switch ( prng( 4 ) ) {
+		  case 0:
+			if ( ! rnodes[n]->listed() ) { ring.addTail( rnodes[n] ); seq.addTail( snodes[n] ); }
+			break;
+		  case 1:
+			if ( ! rnodes[n]->listed() ) { ring.addHead( rnodes[n] ); seq.addHead( snodes[n] ); }
+			break;
+		  case 2:										// remove anywhere
+			if ( rnodes[n]->listed() ) { ring.remove( rnodes[n] ); seq.remove( snodes[n] ); }
+			break;
+		  case 3: {
+			Fred * r, * s;
+			if ( prng( 2 ) ) { r = ring.dropHead(); s = seq.dropHead(); }
+			else { r = ring.dropTail(); s = seq.dropTail(); }
+			if ( ( r == nullptr ) != ( s == nullptr ) || ( r && ( r->i != s->i || r->listed() ) ) ) errors += 1;
+			break;
+		  }
+		} // switch
+		if ( ! same( ring, seq ) ) errors += 1;
+	} // for
+
+	uSequence<Fred> from;								// transfer
+	for ( int i = 0; i < Nodes; i += 1 ) {
+		if ( ! rnodes[i]->listed() ) { from.addTail( rnodes[i] ); seq.addTail( snodes[i] ); }
+	} // for
+	ring.transfer( from );
+	if ( ! from.empty() || ! same( ring, seq ) || ring.size() != Nodes ) errors += 1;
+
+	while ( ring.dropHead() );
+	while ( seq.dropHead() );
+	for ( int i = 0; i < Nodes; i += 1 ) {
+		delete rnodes[i];
+		delete snodes[i];
+	} // for
+	return errors;
+} // checkRing
+
+
+enum { Tasks = 200, Rounds = 1000, Migrate = 100 };
+unsigned int turns[Tasks];
+uCluster * away;										// user cluster
+
+_Task Worker {
+	unsigned int id;
+	uCluster & home;
+	unsigned int & errors;
+
+	void main() {
+		for ( unsigned int r = 0; r < Rounds; r += 1 ) {
+			turns[id] += 1;
+			if ( r % Migrate == id % Migrate ) {		// leave and rejoin the ring ready queue
+				if ( &migrate( *away ) != &home ) errors += 1;
+				migrate( home );
+			} else {
+				yield();
+			} // if
+			if ( &uThisCluster() != &home ) errors += 1;
+		} // for
+	} // Worker::main
+  public:
+	Worker( uCluster & cluster, unsigned int id, unsigned int & errors ) : uBaseTask( cluster ), id( id ), home( cluster ), errors( errors ) {}
+}; // Worker
+
+static unsigned int checkScheduler() {
+	unsigned int errors = 0;
+	away = &uThisCluster();
+	uRingScheduler rq( 16 );							// small => overflow
+	uCluster cluster( rq, "ring" );
+	{
+		uProcessor processor( cluster );
+		Worker * workers[Tasks];
+		for ( unsigned int i = 0; i < Tasks; i += 1 ) workers[i] = new Worker( cluster, i, errors );
+		for ( unsigned int i = 0; i < Tasks; i += 1 ) delete workers[i];
+	}
+	for ( unsigned int i = 0; i < Tasks; i += 1 ) {
+		if ( turns[i] != Rounds ) errors += 1;
+	} // for
+	return errors;
+} // checkScheduler
+
+int main() {
+	unsigned int errors = checkRing() + checkScheduler();
+	if ( errors != 0 ) {
+		cerr << "Error: " << errors << " failures" << endl;
+		return 1;
+	} // if
+	cout << "successful completion" << endl;
+} // main
+
+// Local Variables: //
+// compile-command: "u++ Ring.cc" //
+// End: //
@@ -187,14 +187,14 @@ void uEventList::setTimer( uDuration duration ) {
 } // uEventList::setTimer
 
 
-void uEventList::setTimer( uTime time ) {				// time parameter is real-time (not virtual time)
+void uEventList::setTimer( uTime time ) {				// time parameter is on the deadline clock (uClock::monoTime)
 	uDEBUGPRT(
 		char buffer[256];
 		uDebugPrtBuf( buffer, "uEventList::setTimer, time:%lld\n", time.nanoseconds() );
 		);
   if ( time == uTime() ) return;						// zero time is invalid
 
-	uDuration dur = time - uClock::currTime();
+	uDuration dur = time - uClock::monoTime();
 
 	if ( dur <= 0 ) {					// if duration is zero or negative (it has already past)
 		uDEBUGPRT( uDebugPrtBuf( buffer, "uEventList::setTimer, kill time:%lld currtime:%lld dur:%lld\n",
@@ -212,7 +212,7 @@ void uEventList::setTimer( uTime time ) {				// time parameter is real-time (not
 
 void uEventListPop::over( uEventList &events, bool inKernel ) {
 	uEventListPop::events = &events;
-	currTime = uClock::currTime();
+	currTime = uClock::monoTime();
 	cxtSwHandler = nullptr;
 	uEventListPop::inKernel = inKernel;
 	assert( ! uKernelModule::uKernelModuleBoot.RFinprogress ); // should not be on
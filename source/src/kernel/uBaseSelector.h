@@ -290,7 +290,7 @@ namespace UPP {
 	template<typename Root>
 	class Executor {
 		Root & root;
-		uTime timeout;
+		uTime timeout;									// deadline on uClock::monoTime
 		bool hasTimeout, hasElse;
 		State isFinish;
 		UPP::SelectorClient selectState;
@@ -303,29 +303,29 @@ namespace UPP {
 			root.registerSelf( &selectState );
 		} // Executor::Executor
 
-		Executor( Root & root, uTime timeout ) : root( root ), timeout( timeout ), hasTimeout( true ), hasElse( false ), isFinish( NonAvail ) {
+		Executor( Root & root, uTime timeout ) : root( root ), timeout( uClock::monoTime( timeout ) ), hasTimeout( true ), hasElse( false ), isFinish( NonAvail ) {
 			root.registerSelf( &selectState );
 		} // Executor::Executor
 
-		Executor( Root & root, uDuration timeout ) : root( root ), timeout( uClock::currTime() + timeout ), hasTimeout( true ), hasElse( false ), isFinish( NonAvail ) {
+		Executor( Root & root, uDuration timeout ) : root( root ), timeout( uClock::monoTime() + timeout ), hasTimeout( true ), hasElse( false ), isFinish( NonAvail ) {
 			root.registerSelf( &selectState );
 		} // Executor::Executor
 
-		Executor( Root & root, bool timeoutGuard, uTime timeout ) : root( root ), timeout( timeout ), hasTimeout( timeoutGuard ), hasElse( false ), isFinish( NonAvail ) {
+		Executor( Root & root, bool timeoutGuard, uTime timeout ) : root( root ), timeout( uClock::monoTime( timeout ) ), hasTimeout( timeoutGuard ), hasElse( false ), isFinish( NonAvail ) {
 			root.registerSelf( &selectState );
 		} // Executor::Executor
 
-		Executor( Root & root, bool timeoutGuard, uDuration timeout ) : root( root ), timeout( uClock::currTime() + timeout ), hasTimeout( timeoutGuard ), hasElse( false ), isFinish( NonAvail ) {
+		Executor( Root & root, bool timeoutGuard, uDuration timeout ) : root( root ), timeout( uClock::monoTime() + timeout ), hasTimeout( timeoutGuard ), hasElse( false ), isFinish( NonAvail ) {
 			root.registerSelf( &selectState );
 		} // Executor::Executor
 
 		Executor( Root & root, bool timeoutGuard, uTime timeout, bool elseGuard )
-			: root( root ), timeout( timeout ), hasTimeout( timeoutGuard ), hasElse( elseGuard ), isFinish( NonAvail ) {
+			: root( root ), timeout( uClock::monoTime( timeout ) ), hasTimeout( timeoutGuard ), hasElse( elseGuard ), isFinish( NonAvail ) {
 			root.registerSelf( &selectState );
 		} // Executor::Executor
 
 		Executor( Root & root, bool timeoutGuard, uDuration timeout, bool elseGuard )
-			: root( root ), timeout( uClock::currTime() + timeout ), hasTimeout( timeoutGuard ), hasElse( elseGuard ), isFinish( NonAvail ) {
+			: root( root ), timeout( uClock::monoTime() + timeout ), hasTimeout( timeoutGuard ), hasElse( elseGuard ), isFinish( NonAvail ) {
 			root.registerSelf( &selectState );
 		} // Executor::Executor
 
@@ -363,7 +363,7 @@ namespace UPP {
 
 				if ( hasTimeout ) {
 					//osacquire( cerr ) << "nextAction top hasTimeout" << endl;
-					if ( ! selectState.sem.P( timeout ) ) { // timeout expired (false) ?
+					if ( ! selectState.sem.PDeadline( timeout ) ) { // timeout expired (false) ?
 						root.removeFuture();			// walk tree removing select from futures to allow reset
 						return 2;						// terminate select
 					} // if 
@@ -87,8 +87,9 @@ void uBaseTask::createTask( uCluster & cluster ) {
 
 	// memory allocation
 
+	heapData = nullptr;									// no region
+	hazardSlot_ = nullptr;
 	if ( this != (uBaseTask *)uKernelModule::bootTask ) {
-		heapData = nullptr;
 		uHeapControl::prepareTask( this );
 	} // if
 } // uBaseTask::createTask
@@ -261,16 +262,21 @@ uBaseTask::uBaseTask( uCluster & cluster ) : uBaseCoroutine( cluster.getStackSiz
 } // uBaseTask::uBaseTask
 
 
-void uBaseTask::sleep( uTime time ) {
-	if ( time <= uClock::currTime() ) return;
+void uBaseTask::sleepDeadline( uTime deadline ) {
+	if ( deadline <= uClock::monoTime() ) return;
 	uWakeupHndlr handler( uThisTask() );				// handler to wake up blocking task
-	uEventNode uRTEvent( uThisTask(), handler, time );	// event node for event list
+	uEventNode uRTEvent( uThisTask(), handler, deadline ); // event node for event list
 	uRTEvent.add( true );								// block until time expires
+} // uBaseTask::sleepDeadline
+
+
+void uBaseTask::sleep( uTime time ) {
+	sleepDeadline( uClock::monoTime( time ) );
 } // uBaseTask::sleep
 
 
 void uBaseTask::sleep( uDuration duration ) {
-	sleep( uClock::currTime() + duration );
+	sleepDeadline( uClock::monoTime() + duration );
 } // uBaseTask::sleep
 
 
@@ -35,6 +35,7 @@
 #ifdef __U_STATISTICS__
 #include <uHeapLmmm.h>
 #endif // __U_STATISTICS__
+#include <uEpoch.h>
 
 #include <uDebug.h>										// access: uDebugWrite
 
@@ -272,6 +273,10 @@ uNBIO uCluster::NBIO;
 
 int UPP::uKernelBoot::count = 0;
 int UPP::uInitProcessorsBoot::count = 0;
+volatile int UPP::uBlockingIO::state = UPP::uBlockingIO::Uncreated;
+uCluster * UPP::uBlockingIO::cluster_ = nullptr;
+uProcessor ** UPP::uBlockingIO::processors = nullptr;
+unsigned int UPP::uBlockingIO::numProcessors = 0;
 
 
 extern "C" void pthread_deletespecific_( void * );		// see pthread simulation
@@ -399,17 +404,52 @@ void uMutexLock::add_( uBaseTask & task ) {				// used by uCondLock::signal
 } // uMutexLock::add_
 
 
+void uMutexLock::add_( uSequence<uBaseTaskDL> & tasks ) { // used by uCondLock::broadcast
+	spinLock.acquire();
+	do {
+		tasks.dropHead()->task().wake();				// restart acquiring task
+	} while ( ! tasks.empty() );
+	spinLock.release();
+} // uMutexLock::add_
+
+
 void uMutexLock::release_() {							// used by uCondLock::wait
 	spinLock.acquire();
 	if ( ! waiting.empty() ) {							// waiting tasks ?
-		waiting.dropHead()->task().wake();				// remove task at head of waiting list and start it
+		owner_ = &(waiting.dropHead()->task());			// remove task at head of waiting list
+		owner_->wake();									// and start it
 	} else {
 		count = false;									// release, not in use
+		owner_ = nullptr;
 	} // if
 	spinLock.release();
 } // uMutexLock::release_
 
 
+void uMutexLock::spin_() {								// pre/post: spinLock acquired, lock held by another task
+	#ifdef __U_MULTI__
+	// Spin only while no task is blocked, as release passes the lock to a blocked task, and only while the holder is
+	// running, as otherwise the lock cannot be released before the spinner blocks. The holder cannot release the lock,
+	// and hence terminate, while spinLock is held, so it is safe to examine. As for glibc adaptive mutexes, the spin
+	// bound is twice the smoothed number of spins needed by previous acquires, plus a minimum.
+
+	enum { MinSpins = 16, MaxSpins = 1024, Recheck = 32 };
+	unsigned int limit = spinBudget * 2 + MinSpins, spins = 0;
+	if ( limit > MaxSpins ) limit = MaxSpins;
+	while ( count && owner_ != nullptr && waiting.empty() && owner_->getState() == uBaseTask::Running && spins < limit ) {
+		uBaseTask * owner = owner_;
+		spinLock.release();
+		for ( unsigned int i = 0; i < Recheck && spins < limit; i += 1, spins += 1 ) { // spin without lock
+		  if ( __atomic_load_n( &owner_, __ATOMIC_RELAXED ) != owner ) break; // released ?
+			uPause();
+		} // for
+		spinLock.acquire();
+	} // while
+	spinBudget += ((int)spins - (int)spinBudget) / 8;	// smooth
+	#endif // __U_MULTI__
+} // uMutexLock::spin_
+
+
 uDEBUG(
 	uMutexLock::~uMutexLock() {
 		spinLock.acquire();
@@ -431,6 +471,9 @@ void uMutexLock::acquire() {
 	#ifdef KNOT
 	task.setActivePriority( task.getActivePriorityValue() + 1 );
 	#endif // KNOT
+	#ifdef __U_MULTI__
+	if ( count ) spin_();								// lock in use ? spin before blocking
+	#endif // __U_MULTI__
 	if ( count ) {										// but if lock in use
 		waiting.addTail( &(task.entryRef_) );			// suspend current task
 		#ifdef __U_STATISTICS__
@@ -444,6 +487,7 @@ void uMutexLock::acquire() {
 		return;
 	} // if
 	count = true;
+	owner_ = &task;
 	spinLock.release();
 } // uMutexLock::acquire
 
@@ -462,6 +506,7 @@ bool uMutexLock::tryacquire() {
 		return false;									// don't wait for the lock
 	} // if
 	count = true;
+	owner_ = &uThisTask();
 	spinLock.release();
 	return true;
 } // uMutexLock::tryacquire
@@ -478,9 +523,11 @@ void uMutexLock::release() {
 		} // if
 	);
 	if ( ! waiting.empty() ) {							// waiting tasks ?
-		waiting.dropHead()->task().wake();				// remove task at head of waiting list and start it
+		owner_ = &(waiting.dropHead()->task());			// remove task at head of waiting list
+		owner_->wake();									// and start it
 	} else {
 		count = false;
+		owner_ = nullptr;
 	} // if
 	#ifdef KNOT
 	uThisTask().setActivePriority( uThisTask().getActivePriorityValue() - 1 );
@@ -505,6 +552,18 @@ void uOwnerLock::add_( uBaseTask & task ) {				// used by uCondLock::signal
 } // uOwnerLock::add_
 
 
+void uOwnerLock::add_( uSequence<uBaseTaskDL> & tasks ) { // used by uCondLock::broadcast
+	spinLock.acquire();
+	if ( owner_ == nullptr ) {							// lock free ?
+		owner_ = &(tasks.dropHead()->task());			// head task becomes owner
+		count = 1;
+		owner_->wake();									// restart new owner
+	} // if
+	waiting.transfer( tasks );							// chain remaining tasks to owner lock list
+	spinLock.release();
+} // uOwnerLock::add_
+
+
 void uOwnerLock::release_() {							// used by uCondLock::wait
 	spinLock.acquire();
 	if ( ! waiting.empty() ) {							// waiting tasks ?
@@ -541,6 +600,9 @@ void uOwnerLock::acquire() {
 	task.setActivePriority( task.getActivePriorityValue() + 1 );
 	#endif // KNOT
 	if ( owner_ != &task ) {							// don't own lock yet
+		#ifdef __U_MULTI__
+		if ( owner_ != nullptr ) spin_();				// lock in use ? spin before blocking
+		#endif // __U_MULTI__
 		if ( owner_ != nullptr ) {						// but if lock in use
 			waiting.addTail( &(task.entryRef_) );		// suspend current task
 			#ifdef __U_STATISTICS__
@@ -645,11 +707,21 @@ uDEBUG(
 	} // uCondLock::uCondLock
 );
 
+inline void uCondLock::enqueue( uBaseTask & task, uMutexLock & lock ) { // pre: spinLock acquired
+	if ( waiting.empty() ) {							// track common owner lock for broadcast
+		waitLock = &lock;
+	} else if ( waitLock != &lock ) {
+		waitLock = nullptr;
+	} // if
+	waiting.addTail( &(task.entryRef_) );
+} // uCondLock::enqueue
+
+
 void uCondLock::wait( uMutexLock & lock ) {
 	uBaseTask & task = uThisTask();						// optimization
 	task.ownerLock_ = &lock;							// task remembers this lock before blocking for use in signal
 	spinLock.acquire();
-	waiting.addTail( &(task.entryRef_) );				// queue current task
+	enqueue( task, lock );								// queue current task
 	// Must add to the condition queue first before releasing the lock because testing for empty condition can occur
 	// immediately after the lock is released.
 	lock.release_();									// release mutex lock
@@ -665,7 +737,7 @@ void uCondLock::wait( uMutexLock & lock, uintptr_t info ) {
 
 
 bool uCondLock::wait( uMutexLock & lock, uDuration duration ) {
-	return wait( lock, uClock::currTime() + duration );
+	return waitDeadline( lock, uClock::monoTime() + duration );
 } // uCondLock::wait
 
 
@@ -676,6 +748,11 @@ bool uCondLock::wait( uMutexLock & lock, uintptr_t info, uDuration duration ) {
 
 
 bool uCondLock::wait( uMutexLock & lock, uTime time ) {
+	return waitDeadline( lock, uClock::monoTime( time ) );
+} // uCondLock::wait
+
+
+bool uCondLock::waitDeadline( uMutexLock & lock, uTime deadline ) {
 	uBaseTask & task = uThisTask();						// optimization
 
 	task.ownerLock_ = &lock;							// task remembers this lock before blocking for use in signal
@@ -684,11 +761,11 @@ bool uCondLock::wait( uMutexLock & lock, uTime time ) {
 	uDEBUGPRT( uDebugPrt( "(uCondLock &)%p.wait, task:%p\n", this, &task ); );
 
 	TimedWaitHandler handler( task, * this );			// handler to wake up blocking task
-	uEventNode timeoutEvent( task, handler, time, 0 );
+	uEventNode timeoutEvent( task, handler, deadline, 0 );
 	timeoutEvent.executeLocked = true;
 	timeoutEvent.add();
 
-	waiting.addTail( &(task.entryRef_) );				// queue current task
+	enqueue( task, lock );								// queue current task
 	// Must add to the condition queue first before releasing the owner lock because testing for empty condition can
 	// occur immediately after the owner lock is released.
 	lock.release_();									// release owner lock
@@ -698,7 +775,7 @@ bool uCondLock::wait( uMutexLock & lock, uTime time ) {
 	timeoutEvent.remove();
 
 	return ! handler.timedout;
-} // uCondLock::wait
+} // uCondLock::waitDeadline
 
 
 bool uCondLock::wait( uMutexLock & lock, uintptr_t info, uTime time ) {
@@ -719,7 +796,7 @@ void uCondLock::wait( uOwnerLock & lock ) {
 	task.ownerLock_ = &lock;							// task remembers this lock before blocking for use in signal
 	unsigned int prevcnt = lock.count;					// remember this lock's recursive count before blocking
 	spinLock.acquire();
-	waiting.addTail( &(task.entryRef_) );				// queue current task
+	enqueue( task, lock );								// queue current task
 	// Must add to the condition queue first before releasing the lock because testing for empty condition can occur
 	// immediately after the lock is released.
 	lock.release_();									// release owner lock
@@ -736,7 +813,7 @@ void uCondLock::wait( uOwnerLock & lock, uintptr_t info ) {
 
 
 bool uCondLock::wait( uOwnerLock & lock, uDuration duration ) {
-	return wait( lock, uClock::currTime() + duration );
+	return waitDeadline( lock, uClock::monoTime() + duration );
 } // uCondLock::wait
 
 
@@ -747,6 +824,11 @@ bool uCondLock::wait( uOwnerLock & lock, uintptr_t info, uDuration duration ) {
 
 
 bool uCondLock::wait( uOwnerLock & lock, uTime time ) {
+	return waitDeadline( lock, uClock::monoTime( time ) );
+} // uCondLock::wait
+
+
+bool uCondLock::waitDeadline( uOwnerLock & lock, uTime deadline ) {
 	uBaseTask & task = uThisTask();						// optimization
 	uDEBUG(
 		uBaseTask * owner = lock.owner();				// owner could change
@@ -762,11 +844,11 @@ bool uCondLock::wait( uOwnerLock & lock, uTime time ) {
 	uDEBUGPRT( uDebugPrt( "(uCondLock &)%p.wait, task:%p\n", this, &task ); );
 
 	TimedWaitHandler handler( task, * this );			// handler to wake up blocking task
-	uEventNode timeoutEvent( task, handler, time, 0 );
+	uEventNode timeoutEvent( task, handler, deadline, 0 );
 	timeoutEvent.executeLocked = true;
 	timeoutEvent.add();
 
-	waiting.addTail( &(task.entryRef_) );				// queue current task
+	enqueue( task, lock );								// queue current task
 	// Must add to the condition queue first before releasing the owner lock because testing for empty condition can
 	// occur immediately after the owner lock is released.
 	lock.release_();									// release owner lock
@@ -778,7 +860,7 @@ bool uCondLock::wait( uOwnerLock & lock, uTime time ) {
 	timeoutEvent.remove();
 
 	return ! handler.timedout;
-} // uCondLock::wait
+} // uCondLock::waitDeadline
 
 
 bool uCondLock::wait( uOwnerLock & lock, uintptr_t info, uTime time ) {
@@ -831,17 +913,34 @@ bool uCondLock::signal() {
 
 
 bool uCondLock::broadcast() {
-	// It is impossible to chain the entire waiting list to the associated owner lock because each wait can be on a
-	// different owner lock. Hence, each task has to be individually processed to move it onto the correct owner lock.
+	// Each wait can be on a different owner lock, so the waiting tasks are grouped by owner lock, and each group is
+	// chained to its owner lock in one critical section. Usually all tasks wait on the same owner lock, which is known
+	// without examining the tasks, so the entire waiting list is chained in one step.
 
 	uSequence<uBaseTaskDL> temp;
 	spinLock.acquire();
+	if ( waiting.empty() ) {							// waitLock only valid with blocked tasks
+		spinLock.release();
+		return false;
+	} // if
+	uMutexLock * lock = waitLock;
 	temp.transfer( waiting );
 	spinLock.release();
-	if ( temp.empty() ) return false;
+	if ( lock != nullptr ) {							// all tasks on same owner lock ?
+		lock->add_( temp );
+		return true;
+	} // if
 	do {
-		uBaseTask & task = temp.dropHead()->task();		// remove task at head of waiting list
-		task.ownerLock_->add_( task );					// chain to its owner lock
+		lock = temp.head()->task().ownerLock_;
+		uSequence<uBaseTaskDL> group;
+		for ( uBaseTaskDL * p = temp.head(), * n; p != nullptr; p = n ) { // remove tasks waiting on same owner lock
+			n = temp.succ( p );
+			if ( p->task().ownerLock_ == lock ) {
+				temp.remove( p );
+				group.addTail( p );
+			} // if
+		} // for
+		lock->add_( group );							// chain group to its owner lock
 	} while ( ! temp.empty() );
 	return true;
 } // uCondLock::broadcast
@@ -1767,18 +1866,18 @@ namespace UPP {
 
 
 	void uSerial::acceptPause( uDuration duration ) {
-		acceptPause( uClock::currTime() + duration );
+		acceptPauseDeadline( uClock::monoTime() + duration );
 	} // uSerial::acceptPause
 
 
-	void uSerial::acceptPause( uTime time ) {
-		uDEBUGPRT( uDebugPrt( "(uSerial &)%p.acceptPause( time ) enter, mask:0x%x,0x%x,0x%x,0x%x, owner:%p\n",
+	void uSerial::acceptPauseDeadline( uTime deadline ) {
+		uDEBUGPRT( uDebugPrt( "(uSerial &)%p.acceptPauseDeadline enter, mask:0x%x,0x%x,0x%x,0x%x, owner:%p\n",
 							  this, mask[0], mask[1], mask[2], mask[3], mutexOwner ); );
 		// lock is acquired at beginning of accept statement
 		uBaseTask & task = uThisTask();					// optimization
 		uTimeoutHndlr handler( task, *this );			// handler to wake up blocking task
 
-		timeoutEvent.alarm = time;
+		timeoutEvent.alarm = deadline;
 		timeoutEvent.task = &task;
 		timeoutEvent.sigHandler = &handler;
 		timeoutEvent.executeLocked = true;
@@ -1800,10 +1899,10 @@ namespace UPP {
 			task.acceptedCall->acceptorSuspended = false; // acceptor resumes
 			task.acceptedCall = nullptr;
 		} // if
-		uDEBUGPRT( uDebugPrt( "(uSerial &)%p.acceptPause( time ) restart, mask:0x%x,0x%x,0x%x,0x%x, owner:%p, maskposn:%p\n",
+		uDEBUGPRT( uDebugPrt( "(uSerial &)%p.acceptPauseDeadline restart, mask:0x%x,0x%x,0x%x,0x%x, owner:%p, maskposn:%p\n",
 							  this, mask[0], mask[1], mask[2], mask[3], mutexOwner, mutexMaskLocn ); );
 		_Enable <uMutexFailure>;						// implicit poll
-	} // uSerial::acceptPause
+	} // uSerial::acceptPauseDeadline
 
 
 	void uSerial::acceptEnd() {
@@ -2119,6 +2218,24 @@ bool uCondition::signalBlock() {						// signal a condition
 } // uCondition::signalBlock
 
 
+bool uCondition::broadcast() {							// signal all tasks on a condition
+  if ( waiting.empty() ) return false;					// broadcast on empty condition is no-op
+
+	uBaseTask & task = uThisTask();						// optimization
+	UPP::uSerial & serial = task.getSerial();
+	uDEBUG( uSignalCheck(); );
+
+	#ifdef __U_PROFILER__
+	if ( task.profileActive && uProfiler::uProfiler_registerSignal ) { // task registered for profiling ?
+		(*uProfiler::uProfiler_registerSignal)( uProfiler::profilerInstance, *this, task, serial );
+	} // if
+	#endif // __U_PROFILER__
+
+	serial.acceptSignalled.transfer( waiting );			// move all signalled tasks on top of accept/signalled stack, FIFO
+	return true;
+} // uCondition::broadcast
+
+
 uCondition::WaitingFailure::WaitingFailure( const uCondition & cond, const char * const msg ) : uKernelFailure( msg ), cond( cond ) {}
 
 uCondition::WaitingFailure::~WaitingFailure() {}
@@ -2168,6 +2285,7 @@ void UPP::uKernelBoot::startup() {
 	RealRtn::startup();									// must come before any call to uDebugPrt
 
 	tzset();											// initialize time global variables
+	uClock::startup( uDefaultClock() );					// select clock for timeouts
 	#ifdef __U_STATISTICS__
 	char * lang = getenv( "LANG" );
 	if ( lang ) setlocale( LC_NUMERIC, lang );			// set lang for commas in statistics
@@ -2423,6 +2541,8 @@ void UPP::uKernelBoot::shutdown() {
 	uKernelModule::globalClusters.dtor();
 	uKernelModule::globalProcessors.dtor();
 
+	uEpoch::shutdown();
+
 	heapManagerDtor();
 	uHeapControl::shutdown();
 } // uKernelBoot::shutdown
@@ -2436,12 +2556,48 @@ void uInitProcessorsBoot::startup() {
 
 
 void uInitProcessorsBoot::shutdown() {
+	uBlockingIO::shutdown();
 	for ( unsigned int i = 1; i < uKernelModule::numUserProcessors; i += 1 ) {
 		delete uKernelModule::userProcessors[i];
 	} // for
 } // uInitProcessorsBoot::shutdown
 
 
+uCluster * uBlockingIO::create() {
+	for ( ;; ) {										// only one task creates the cluster
+		int curr = __atomic_load_n( &state, __ATOMIC_ACQUIRE );
+	  if ( curr == Created ) return cluster_;
+	  if ( curr == Disabled ) return nullptr;
+	  if ( curr == Uncreated && uCompareAssign( state, curr, (int)Creating ) ) break;
+		uThisTask().yield();							// wait for creating task
+	} // for
+
+	numProcessors = uDefaultBlockingIOProcessors();
+	if ( numProcessors == 0 ) {
+		__atomic_store_n( &state, Disabled, __ATOMIC_RELEASE );
+		return nullptr;
+	} // if
+	cluster_ = new uCluster( "blockingIOCluster" );
+	processors = new uProcessor *[numProcessors];
+	for ( unsigned int i = 0; i < numProcessors; i += 1 ) {
+		processors[i] = new uProcessor( *cluster_ );
+	} // for
+	__atomic_store_n( &state, Created, __ATOMIC_RELEASE );
+	return cluster_;
+} // uBlockingIO::create
+
+
+void uBlockingIO::shutdown() {
+	int curr = __atomic_exchange_n( &state, Disabled, __ATOMIC_ACQ_REL ); // later blocking calls execute in place
+  if ( curr != Created ) return;
+	for ( unsigned int i = 0; i < numProcessors; i += 1 ) {
+		delete processors[i];
+	} // for
+	delete [] processors;
+	delete cluster_;
+} // uBlockingIO::shutdown
+
+
 // Local Variables: //
 // compile-command: "make install" //
 // End: //
@@ -337,6 +337,11 @@ class uCondition;										// forward declaration
 class uTimeoutHndlr;									// forward declaration
 class uWakeupHndlr;										// forward declaration
 class uRWLock;											// forward declaration
+class uLog;												// forward declaration
+struct uLogBuffer;										// forward declaration
+class uEpoch;											// forward declaration
+class uHazardPointer;									// forward declaration
+struct uEpochRecord;									// forward declaration
 
 namespace UPP {
 	enum  uAction { uNo, uYes };						// forward declaration
@@ -486,12 +491,14 @@ static void * doMalloc( size_t size
 					    #ifdef __U_STATISTICS__
 					    , unsigned int counter
 					    #endif // __U_STATISTICS__
+					    , bool header = false
 					  );
 static void doFree( void * addr );
 static void * memalignNoStats( size_t alignment, size_t size
 							   #ifdef __U_STATISTICS__
 							   , unsigned int counter
 							   #endif // __U_STATISTICS__
+							   , bool header = false
 							 );
 
 class uKernelModule {
@@ -502,12 +509,14 @@ class uKernelModule {
 						    #ifdef __U_STATISTICS__
 						    , unsigned int counter
 						    #endif // __U_STATISTICS__
+						    , bool header
 						  );
 	friend void doFree( void * addr );
 	friend void * memalignNoStats( size_t alignment, size_t size
 							   #ifdef __U_STATISTICS__
 							   , unsigned int counter
 							   #endif // __U_STATISTICS__
+							   , bool header
 							 );
 #pragma GCC diagnostic pop
 	friend void free( void * addr ) __THROW;
@@ -542,7 +551,12 @@ class uKernelModule {
 	friend class UPP::uKernelBoot;						// access: everything
 	friend class UPP::uInitProcessorsBoot;				// access: numUserProcessors, userProcessors
 	friend class UPP::uHeapManager;						// access: bootTaskStorage, kernelModuleInitialized, startup
+	friend class UPP::uHeapControl;						// access: uKernelModuleBoot
 	friend class UPP::uNBIO;							// access: uKernelModuleBoot
+	friend class uHWCounters;							// access: uKernelModuleBoot
+	friend class uLog;									// access: uKernelModuleBoot, globalProcessors, globalProcessorLock
+	friend class uEpoch;								// access: uKernelModuleBoot
+	friend class uHazardPointer;						// access: uKernelModuleBoot
 	friend int pthread_mutex_lock( pthread_mutex_t * mutex ) __THROW; // access: kernelModuleInitialized
 	friend int pthread_mutex_lock( pthread_mutex_t * mutex ) __THROW; // access: kernelModuleInitialized
 
@@ -1036,19 +1050,27 @@ class uCxtSwtchHndlr : public uSignalHandler {
 // uMutexLock/uOwnerLock use wait morphing with uCondLock. uCondLock removes an unblocking task and moves it to the lock
 // queue for processing through the add_ member in the locks. Wait morphing eliminates the double blocking if the
 // unblocking thread must reacquire the mutex lock after the wait.
+//
+// On a multiprocessor, an acquiring task spins before blocking while the task holding the lock is running, because a
+// short critical section ends sooner than a context switch. The spin bound is learned per lock.
 
 class uMutexLock {
 	friend class uCondLock;								// access: add_, release_
   protected:
 	// These data fields must be initialized to zero. Therefore, this lock can be used in the same storage area as a
-	// pthread_mutex_t, if sizeof(pthread_mutex_t) >= sizeof(uMutexLock).
+	// pthread_mutex_t, if sizeof(pthread_mutex_t) >= sizeof(uMutexLock). On 64-bit, the layout is vtable pointer 8,
+	// spinLock 4, count 4, waiting 8, owner_ 8 and spinBudget 4 (+ 4 padding) = 40 bytes = sizeof(pthread_mutex_t).
 
 	uSpinLock spinLock;									// must be first field for alignment
 	unsigned int count;									// number of recursive entries; no overflow checking
-	uSequence<uBaseTaskDL> waiting;						// sequence versus queue to reduce size to 24 bytes => more expensive
+	uSequence<uBaseTaskDL> waiting;						// sequence (8 bytes) versus queue (16) to fit pthread_mutex_t
+	uBaseTask * owner_;									// task holding lock, nullptr => free or unknown
+	unsigned int spinBudget;							// learned spins before blocking
 
 	virtual void add_( uBaseTask & task );				// helper routines for uCondLock
+	virtual void add_( uSequence<uBaseTaskDL> & tasks );
 	void release_();
+	void spin_();										// spin while holder is running
   public:
 	uMutexLock( const uMutexLock & ) = delete;			// no copy
 	uMutexLock( uMutexLock && ) = delete;
@@ -1060,6 +1082,8 @@ class uMutexLock {
 		uFetchAdd( UPP::Statistics::uMutexLocks, 1 );
 		#endif // __U_STATISTICS__
 		count = false;									// no one has acquired the lock
+		owner_ = nullptr;
+		spinBudget = 0;
 	} // uMutexLock::uMutexLock
 
 	uDEBUG( virtual ~uMutexLock(); )
@@ -1077,11 +1101,11 @@ class uOwnerLock : public uMutexLock {
 	friend class uCondLock;								// access: add_, release_
 
 	// These data fields must be initialized to zero. Therefore, this lock can be used in the same storage area as a
-	// pthread_mutex_t, if sizeof(pthread_mutex_t) >= sizeof(uOwnerLock).
-
-	uBaseTask * owner_;									// owner with respect to recursive entry
+	// pthread_mutex_t, if sizeof(pthread_mutex_t) >= sizeof(uOwnerLock). The owner with respect to recursive entry is
+	// owner_ in uMutexLock.
 
 	void add_( uBaseTask & task );						// helper routines for uCondLock
+	void add_( uSequence<uBaseTaskDL> & tasks );
 	void release_();
   public:
 	uOwnerLock( const uOwnerLock & ) = delete;			// no copy
@@ -1131,7 +1155,11 @@ class uCondLock {
 
 	uSpinLock spinLock;									// must be first field for alignment
 	uSequence<uBaseTaskDL> waiting;						// queue of blocked tasks
+	uMutexLock * waitLock;								// owner lock of all blocked tasks, nullptr => different owner locks
+	void enqueue( uBaseTask & task, uMutexLock & lock ); // add blocked task
 	void waitTimeout( TimedWaitHandler & h );			// timeout
+	bool waitDeadline( uMutexLock & lock, uTime deadline ); // deadline on uClock::monoTime
+	bool waitDeadline( uOwnerLock & lock, uTime deadline );
   public:
 	uCondLock( const uCondLock & ) = delete;			// no copy
 	uCondLock( uCondLock && ) = delete;
@@ -1142,6 +1170,7 @@ class uCondLock {
 		#ifdef __U_STATISTICS__
 		uFetchAdd( UPP::Statistics::uCondLocks, 1 );
 		#endif // __U_STATISTICS__
+		waitLock = nullptr;								// no blocked tasks
 	} // uCondLock::uCondLock
 
 	uDEBUG( ~uCondLock(); )
@@ -1172,7 +1201,11 @@ class uCondLock {
 
 
 namespace UPP {
+	template<typename Root> class Executor;
+
 	class uSemaphore {
+		template<typename Root> friend class Executor;	// access: PDeadline
+
 		struct TimedWaitHandler : public uSignalHandler { // real-time
 			uSemaphore & semaphore;
 			bool timedout;
@@ -1190,6 +1223,8 @@ namespace UPP {
 		uQueue<uBaseTaskDL> waiting;
 
 		void waitTimeout( TimedWaitHandler & h );
+		bool PDeadline( uTime deadline );				// deadline on uClock::monoTime
+		bool PDeadline( uSemaphore & s, uTime deadline );
 	  public:
 		uSemaphore( const uSemaphore & ) = delete;		// no copy
 		uSemaphore( uSemaphore && ) = delete;
@@ -1884,6 +1919,7 @@ class uBasePIQ {
 #ifdef KNOT
 #include <uCeilingQ.h>
 #endif // KNOT
+#include <uHWCounters.h>
 
 
 //######################### uBaseTask (cont) #########################
@@ -1921,6 +1957,8 @@ class uBaseTask : public uBaseCoroutine {
 	friend class uEventList;							// access: profileActive
 	friend class UPP::uHeapControl;						// access: heapData
 	friend class uEventListPop;							// access: currCluster
+	friend class uHWCounters;							// access: hwCounters_
+	friend class uHazardPointer;						// access: hazardSlot_
 	friend void set_seed( size_t );						// access: thread_seed
 	friend size_t get_seed();							// access: thread_seed
 	friend size_t prng();								// access: random_state
@@ -1983,6 +2021,8 @@ class uBaseTask : public uBaseCoroutine {
 	uProcessor & bound_;								// processor to which this task is bound, if applicable
 	uBasePrioritySeq * calledEntryMem_;					// pointer to called mutex queue
 	uMutexLock * ownerLock_;							// pointer to owner lock used for signalling conditions
+	uHWCounters::Counts hwCounters_;					// hardware counts while executing on processors with counters
+	void * hazardSlot_;									// uHazardPointer slot kept for the task's next hazard pointer
 
 	// profiling : necessary for compatibility between non-profiling and profiling
 
@@ -1996,6 +2036,8 @@ class uBaseTask : public uBaseCoroutine {
 	UPP::uSerialMember * acceptedCall;					// pointer to the last mutex entry accepted by this thread
 	std::terminate_handler terminateRtn __attribute__(( noreturn )); // per task handling termination action
 	uBaseCoroutine::UnhandledException * cause;			// forwarded unhandled exception
+
+	static void sleepDeadline( uTime deadline );		// deadline on uClock::monoTime
   protected:
 	// real-time
 
@@ -2201,7 +2243,7 @@ class uBaseTask : public uBaseCoroutine {
 
 	uBasePIQ * uPIQ;									// TEMPORARY
 	void * pthreadData;									// pointer to pthread specific data
-	void * heapData;									// thread-local storage for per-thread heaps
+	void * heapData;									// innermost uRegion of task
 
 	void uYieldNoPoll();
 	void uYieldYield( unsigned int times );				// inserted by translator for -yield
@@ -2297,7 +2339,7 @@ namespace UPP {
 
 		void acceptPause();
 		void acceptPause( uDuration duration );
-		void acceptPause( uTime time );
+		void acceptPauseDeadline( uTime deadline );		// deadline on uClock::monoTime
 		void acceptEnd();
 
 		void acceptElse() {
@@ -2377,53 +2419,14 @@ namespace UPP {
 			return executeC();
 		} // uSerial::executeC
 
-		bool executeU( bool timeout, uTime time ) {
-			if ( timeout ) {
-				acceptTry();
-				acceptPause( time );
-				return true;
-			} // if
-			return executeU();
-		} // uSerial::executeU
-
 		bool executeU( bool timeout, uDuration duration );
-
-		bool executeC( bool timeout, uTime time ) {
-			if ( timeout ) {
-				acceptTry();
-				acceptPause( time );
-				return true;
-			} // if
-			return executeC();
-		} // uSerial::executeC
-
+		bool executeU( bool timeout, uTime time );
 		bool executeC( bool timeout, uDuration duration );
-
-		bool executeU( bool timeout, uTime time, bool else_ ) {
-			if ( else_ ) {
-				acceptElse();
-				return false;
-			} // if
-			if ( timeout ) {
-				return executeU( timeout, time );
-			} // if
-			return executeU();
-		} // uSerial::executeU
-
+		bool executeC( bool timeout, uTime time );
 		bool executeU( bool timeout, uDuration duration, bool else_ );
-
-		bool executeC( bool timeout, uTime time, bool else_ ) {
-			if ( else_ ) {
-				acceptElse();
-				return false;
-			} // if
-			if ( timeout ) {
-				return executeC( timeout, time );
-			} // if
-			return executeC();
-		} // uSerial::executeC
-
+		bool executeU( bool timeout, uTime time, bool else_ );
 		bool executeC( bool timeout, uDuration duration, bool else_ );
+		bool executeC( bool timeout, uTime time, bool else_ );
 
 		class uProtectAcceptStmt {
 			uSerial & serial;
@@ -2542,6 +2545,7 @@ class uCondition {
 	} // uCondition::wait
 	bool signal();										// signal condition
 	bool signalBlock();									// signal condition
+	bool broadcast();									// signal all tasks on condition
 
 	bool empty() const {								// test for tasks on a condition
 		return waiting.empty();							// check if the condition queue is empty
@@ -2741,6 +2745,10 @@ class uProcessor {
 	friend class uEventListPop;							// access: contextSwitchHandler
 	friend void * uKernelModule::startThread( void * p ); // acesss: everything
 	friend class UPP::uMachContext;						// access: procTask
+	friend class uHWCounters;							// access: hwCounters, procTask
+	friend class uLog;									// access: logBuffer
+	friend class uEpoch;								// access: epochRecord
+	friend class uHazardPointer;						// access: epochRecord
 
 	// debugging
 
@@ -2786,6 +2794,12 @@ class uProcessor {
 	unsigned int spin;
 
 	uProcessorTask * procTask;							// handle processor specific requests
+	uHWCounters * hwCounters;							// hardware counters, nullptr => not counting
+	uLogBuffer * logBuffer;								// log records appended on this processor
+	uEpochRecord * epochRecord;							// memory reclamation state, nullptr => not used
+	#if defined( __U_AFFINITY__ )
+	volatile bool affinityChanged;						// processor kernel moves heap to the new NUMA node
+	#endif // __U_AFFINITY__
 	uBaseTaskSeq external;								// ready queue for processor task
 
 	uCluster * currCluster_;							// cluster processor currently associated with
@@ -2862,19 +2876,55 @@ class uProcessor {
 
 namespace UPP {
 	inline bool uSerial::executeU( bool timeout, uDuration duration ) {
-		return executeU( timeout, uClock::currTime() + duration );
+		if ( timeout ) {
+			acceptTry();
+			acceptPause( duration );
+			return true;
+		} // if
+		return executeU();
 	} // uSerial::executeU
 
 	inline bool uSerial::executeC( bool timeout, uDuration duration ) {
-		return executeC( timeout, uClock::currTime() + duration );
+		if ( timeout ) {
+			acceptTry();
+			acceptPause( duration );
+			return true;
+		} // if
+		return executeC();
 	} // uSerial::executeC
 
 	inline bool uSerial::executeU( bool timeout, uDuration duration, bool else_ ) {
-		return executeU( timeout, uClock::currTime() + duration, else_ );
+		if ( else_ ) {
+			acceptElse();
+			return false;
+		} // if
+		return executeU( timeout, duration );
 	} // uSerial::executeU
 
 	inline bool uSerial::executeC( bool timeout, uDuration duration, bool else_ ) {
-		return executeC( timeout, uClock::currTime() + duration, else_ );
+		if ( else_ ) {
+			acceptElse();
+			return false;
+		} // if
+		return executeC( timeout, duration );
+	} // uSerial::executeC
+
+	// A real-time timeout is converted to a delay, so the wait is on the deadline clock like a duration timeout.
+
+	inline bool uSerial::executeU( bool timeout, uTime time ) {
+		return executeU( timeout, timeout ? time - uClock::currTime() : uDuration( 0 ) );
+	} // uSerial::executeU
+
+	inline bool uSerial::executeC( bool timeout, uTime time ) {
+		return executeC( timeout, timeout ? time - uClock::currTime() : uDuration( 0 ) );
+	} // uSerial::executeC
+
+	inline bool uSerial::executeU( bool timeout, uTime time, bool else_ ) {
+		return executeU( timeout, timeout ? time - uClock::currTime() : uDuration( 0 ), else_ );
+	} // uSerial::executeU
+
+	inline bool uSerial::executeC( bool timeout, uTime time, bool else_ ) {
+		return executeC( timeout, timeout ? time - uClock::currTime() : uDuration( 0 ), else_ );
 	} // uSerial::executeC
 } // UPP
 
@@ -3046,6 +3096,56 @@ inline uBaseCoroutine::uBaseCoroutine() : UPP::uMachContext( uThisCluster().getS
 } // uBaseCoroutine::uBaseCoroutine
 
 
+//######################### uBlockingCall #########################
+
+
+namespace UPP {
+	// The blocking I/O cluster is created on first use with uDefaultBlockingIOProcessors processors, so programs that
+	// make no blocking calls do not pay for its kernel threads. With a uniprocessor kernel, all processors share one
+	// kernel thread, so blocking calls execute in place.
+	class uBlockingIO {
+		friend class uInitProcessorsBoot;				// access: shutdown
+
+		enum State { Uncreated, Creating, Created, Disabled };
+		static volatile int state;
+		static uCluster * cluster_;
+		static uProcessor ** processors;
+		static unsigned int numProcessors;
+
+		static uCluster * create();
+		static void shutdown();
+	  public:
+		static uCluster * cluster() {					// nullptr => execute blocking calls in place
+			#ifdef __U_MULTI__
+			if ( LIKELY( __atomic_load_n( &state, __ATOMIC_ACQUIRE ) == Created ) ) return cluster_;
+			return create();
+			#else
+			return nullptr;
+			#endif // __U_MULTI__
+		} // uBlockingIO::cluster
+	}; // uBlockingIO
+} // UPP
+
+
+// Execute fn, which may make system calls that block the kernel thread (e.g., open, stat, fsync, getaddrinfo), on the
+// blocking I/O cluster. The calling task migrates to the cluster and back to its cluster, even if fn raises an
+// exception, so only a blocking I/O processor stops. The result of fn is returned.
+template< typename Func > auto uBlockingCall( Func && fn ) -> decltype( fn() ) {
+	struct Migrate {
+		uCluster * home;								// nullptr => not migrated
+
+		Migrate( uCluster * cluster ) {
+			home = cluster == nullptr || &uThisCluster() == cluster ? nullptr : &uBaseTask::migrate( *cluster );
+		} // Migrate::Migrate
+
+		~Migrate() {
+			if ( home != nullptr ) uBaseTask::migrate( *home );
+		} // Migrate::~Migrate
+	} migrate( UPP::uBlockingIO::cluster() );
+	return fn();
+} // uBlockingCall
+
+
 //######################### uPthreadable #########################
 
 
@@ -3221,6 +3321,10 @@ namespace UPP {
 	  public:
 		static bool initialized();
 
+		static uBaseTask * activeTask() {				// nullptr => kernel boot, used by heap profiler
+			return TLS_GET( activeTask );
+		} // uHeapControl::activeTask
+
 		static bool traceHeap() {
 			return traceHeap_;
 		} // uHeapControl::traceHeap
@@ -30,6 +30,9 @@
 //#include <uDebug.h>
 
 #include <ostream>
+#if defined( __i386__ ) || defined( __x86_64__ )
+#include <cpuid.h>										// __get_cpuid
+#endif // __i386__ || __x86_64__
 
 
 //######################### uDuration #########################
@@ -91,6 +94,47 @@ uTime::uTime( int year, int month, int day, int hour, int min, int sec, int64_t
 } // uTime::uCreateTime
 
 
+//######################### uClock #########################
+
+
+uClock::Source uClock::source = uClock::Monotonic;
+uint64_t uClock::tscBase = 0, uClock::tscMult = 0;
+uint64_t uClock::monoBase = 0;
+
+
+static uint64_t monoNsec() {
+	timespec ts;
+	clock_gettime( CLOCK_MONOTONIC, &ts );
+	return (uint64_t)ts.tv_sec * TIMEGRAN + ts.tv_nsec;
+} // monoNsec
+
+
+// The counter is scaled over a 10 millisecond interval, bracketed by clock reads to bound the error. A counter that
+// stops or changes rate with the processor frequency cannot measure time, so the source falls back to Monotonic.
+void uClock::startup( unsigned int source ) {
+	uClock::source = source == Coarse ? Coarse : Monotonic;
+  if ( source != TSC ) return;
+
+	#if defined( __i386__ ) || defined( __x86_64__ )
+	unsigned int eax, ebx, ecx, edx;
+  if ( ! __get_cpuid( 0x80000007, &eax, &ebx, &ecx, &edx ) || (edx & (1 << 8)) == 0 ) return; // not invariant TSC ?
+	#endif // __i386__ || __x86_64__
+
+	enum { Interval = 10'000'000 };						// nanoseconds
+	uint64_t t0 = monoNsec(), c0 = uRdtsc(), t1, c1;
+	do {
+		c1 = uRdtsc();
+		t1 = monoNsec();
+	} while ( t1 - t0 < Interval );
+  if ( c1 <= c0 ) return;								// counter not advancing ?
+
+	tscMult = (uint64_t)(((unsigned __int128)(t1 - t0) << 32) / (c1 - c0));
+	tscBase = c1;
+	monoBase = t1;
+	uClock::source = TSC;
+} // uClock::startup
+
+
 // Local Variables: //
 // compile-command: "make install" //
 // End: //
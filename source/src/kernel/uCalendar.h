@@ -399,8 +399,25 @@ inline bool operator<=( uTime op1, uTime op2 ) {
 //######################### uClock #########################
 
 
+// Timeouts and sleeps are deadlines on a monotonic clock, so they are unaffected by steps to the real-time clock. The
+// monotonic source is selected at startup by uDefaultClock: Monotonic reads CLOCK_MONOTONIC, Coarse reads
+// CLOCK_MONOTONIC_COARSE, which is cheaper but advances once per clock tick, and TSC reads the time-stamp counter scaled
+// to nanoseconds by a calibration against CLOCK_MONOTONIC, which is cheapest but requires an invariant counter. An
+// absolute real-time is converted to a deadline when it is given, so a later step to the real-time clock does not move
+// it.
+
 class uClock {
+	friend class UPP::uKernelBoot;						// access: startup
+
 	uDuration offset;									// for virtual clock: contains offset from real-time
+  public:
+	enum Source { Monotonic, Coarse, TSC };				// monotonic clock source
+  private:
+	static Source source;
+	static uint64_t tscBase, tscMult;					// counter at calibration, nanoseconds per tick (32.32 fixed point)
+	static uint64_t monoBase;							// CLOCK_MONOTONIC nanoseconds at calibration
+
+	static void startup( unsigned int source );			// set source, calibrate counter
   public:
 	uClock() : offset( 0 ) {
 	} // uClock::uClock
@@ -441,6 +458,28 @@ class uClock {
 		clock_gettime( CLOCK_THREAD_CPUTIME_ID, &ts );
 		return uTime( ts );
 	} // uClock::getCPUTime
+
+	static Source getSource() {
+		return source;
+	} // uClock::getSource
+
+	static uTime monoTime() {							// current time on the deadline clock
+		uTime time;
+		if ( source == TSC ) {
+			time.tn = monoBase + (uint64_t)(((unsigned __int128)(uRdtsc() - tscBase) * tscMult) >> 32);
+		} else {
+			timespec ts;
+			clock_gettime( source == Coarse ? CLOCK_MONOTONIC_COARSE : CLOCK_MONOTONIC, &ts );
+			time = ts;
+		} // if
+		return time;
+	} // uClock::monoTime
+
+	static uTime monoTime( uTime time ) {				// convert real-time to the deadline clock, past => now
+		uTime now = monoTime();
+		uDuration delay = time - currTime();
+		return delay > 0 ? now + delay : now;
+	} // uClock::monoTime
 }; // uClock
 
 
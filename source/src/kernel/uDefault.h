@@ -57,12 +57,25 @@ enum : unsigned int { __U_DEFAULT_MAIN_STACK_SIZE__ = 500 * 1000 };
 enum : unsigned int { __U_DEFAULT_USER_PROCESSORS__ = 1 };
 
 
+// Define the default number of processors created on the blocking I/O cluster, which is created on the first call to
+// uBlockingCall. Zero means blocking calls execute on the caller's processor.
+
+enum : unsigned int { __U_DEFAULT_BLOCKING_IO_PROCESSORS__ = 2 };
+
+
+// Define the default clock for timeouts and sleeps: 0 => CLOCK_MONOTONIC, 1 => CLOCK_MONOTONIC_COARSE, cheaper with the
+// resolution of a clock tick, 2 => calibrated time-stamp counter, cheapest, if the counter is invariant (see uClock).
+
+enum : unsigned int { __U_DEFAULT_CLOCK__ = 0 };
+
+
 extern unsigned int uDefaultStackSize();				// cluster coroutine/task stack size (bytes)
 extern unsigned int uMainStackSize();					// uMain task stack size (bytes)
 extern unsigned int uDefaultSpin();						// processor spin time for idle task (context switches)
 extern unsigned int uDefaultPreemption();				// processor scheduling pre-emption durations (milliseconds)
 extern unsigned int uDefaultProcessors();				// number of processors created on the user cluster
 extern unsigned int uDefaultBlockingIOProcessors();		// number of blocking I/O processors created on the blocking I/O cluster
+extern unsigned int uDefaultClock();					// clock source for timeouts and sleeps (uClock::Source)
 
 extern void uStatistics();								// print user defined statistics on interrupt
 
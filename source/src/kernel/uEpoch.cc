@@ -0,0 +1,300 @@
+//                              -*- Mode: C++ -*-
+//
+// uC++ Version 7.0.0, Copyright (C) Peter A. Buhr 2026
+//
+// uEpoch.cc --
+//
+// Author           : agent
+// Created On       : Mon Oct 19 01:49:07 2026
+// Last Modified By : agent
+// Last Modified On : Mon Oct 19 05:20:52 2026
+// Update Count     : 2
+//
+// This  library is free  software; you  can redistribute  it and/or  modify it
+// under the terms of the GNU Lesser General Public License as published by the
+// Free Software  Foundation; either  version 2.1 of  the License, or  (at your
+// option) any later version.
+//
+// This library is distributed in the  hope that it will be useful, but WITHOUT
+// ANY  WARRANTY;  without even  the  implied  warranty  of MERCHANTABILITY  or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+// for more details.
+//
+// You should  have received a  copy of the  GNU Lesser General  Public License
+// along  with this library.
+//
+
+
+#define __U_KERNEL__
+#include <uC++.h>
+#include <uEpoch.h>
+
+#include <algorithm>									// sort, binary_search
+
+
+volatile size_t uEpoch::global = 2;						// retired epochs never underflow
+uEpochRecord * volatile uEpoch::records = nullptr;
+uHazardPointer::Slot * volatile uHazardPointer::slots = nullptr;
+volatile size_t uHazardPointer::noOfSlots = 0;
+
+
+//######################### uEpochRecord #########################
+
+
+void uEpochRecord::Retired::add( uReclaimable * n ) {
+	n->reclaimNext = nullptr;
+	if ( tail == nullptr ) head = n;
+	else tail->reclaimNext = n;
+	tail = n;
+	count += 1;
+} // uEpochRecord::Retired::add
+
+void uEpochRecord::Retired::add( Retired & list ) {
+  if ( list.head == nullptr ) return;
+	if ( tail == nullptr ) head = list.head;
+	else tail->reclaimNext = list.head;
+	tail = list.tail;
+	count += list.count;
+	list.head = list.tail = nullptr;
+	list.count = 0;
+} // uEpochRecord::Retired::add
+
+// Nodes are in retirement order, so the expired nodes are a prefix of the list.
+uReclaimable * uEpochRecord::Retired::expired( size_t epoch ) {
+	uReclaimable * first = head, * last = nullptr;
+	for ( uReclaimable * n = head; n != nullptr && n->reclaimEpoch + 2 <= epoch; n = n->reclaimNext ) {
+		last = n;
+		count -= 1;
+	} // for
+  if ( last == nullptr ) return nullptr;
+	head = last->reclaimNext;
+	if ( head == nullptr ) tail = nullptr;
+	last->reclaimNext = nullptr;
+	return first;
+} // uEpochRecord::Retired::expired
+
+
+//######################### uEpoch #########################
+
+
+// Give the current processor a record, reusing one released by a deleted processor if possible. Records are allocated
+// with interrupts enabled, so the task may migrate and the record is installed on the processor it is executing on.
+uEpochRecord * uEpoch::attach() {
+	uKernelModule::uKernelModuleData::enableInterrupts();
+	uEpochRecord * r;
+	for ( r = records; r != nullptr; r = r->next ) {	// reuse released record ?
+		if ( ! r->inUse && ! __atomic_exchange_n( &r->inUse, true, __ATOMIC_ACQUIRE ) ) break;
+	} // for
+	if ( r == nullptr ) {
+		r = new uEpochRecord;
+		r->next = records;
+		while ( ! uCompareAssignValue( records, r->next, r ) ); // push, failure updates r->next
+	} // if
+	uKernelModule::uKernelModuleData::disableInterrupts();
+
+	uProcessor & processor = uThisProcessor();			// task may have migrated
+	if ( processor.epochRecord == nullptr ) {
+		processor.epochRecord = r;
+	} else {											// another task installed a record
+		__atomic_store_n( &r->inUse, false, __ATOMIC_RELEASE );
+	} // if
+	return processor.epochRecord;
+} // uEpoch::attach
+
+
+// Advance the global epoch if every processor in a guard has announced the current epoch.
+bool uEpoch::advance() {
+	size_t e = __atomic_load_n( &global, __ATOMIC_ACQUIRE );
+	__atomic_thread_fence( __ATOMIC_SEQ_CST );			// nodes retired before reading announcements
+	for ( uEpochRecord * r = __atomic_load_n( &records, __ATOMIC_ACQUIRE ); r != nullptr; r = r->next ) {
+		size_t s = __atomic_load_n( &r->state, __ATOMIC_ACQUIRE );
+	  if ( (s & 1) != 0 && (s >> 1) != e ) return false; // guard in an older epoch ?
+	} // for
+	uCompareAssign( global, e, e + 1 );					// failure => another processor advanced
+	return true;
+} // uEpoch::advance
+
+
+void uEpoch::destroy( uReclaimable * list ) {
+	while ( list != nullptr ) {
+		uReclaimable * n = list;
+		list = list->reclaimNext;
+		delete n;
+	} // while
+} // uEpoch::destroy
+
+
+// Called by the processor kernel between user tasks, where the processor is quiescent, so reclamation progresses
+// even when the retiring tasks stop retiring. Deletion is left to user context.
+void uEpoch::quiescent( uProcessor & processor ) {
+	uEpochRecord * r = processor.epochRecord;
+	if ( r->retired.head != nullptr && r->retired.head->reclaimEpoch + 2 > __atomic_load_n( &global, __ATOMIC_RELAXED ) ) {
+		advance();
+	} // if
+} // uEpoch::quiescent
+
+
+// The processor has stopped executing tasks, so its nodes are moved to the deleting task's processor and the record is
+// released. Moved nodes are given the current epoch, which only delays their deletion.
+void uEpoch::detach( uProcessor & processor ) {
+	uEpochRecord * r = processor.epochRecord;
+  if ( r == nullptr ) return;
+	processor.epochRecord = nullptr;
+	__atomic_thread_fence( __ATOMIC_SEQ_CST );
+	size_t e = __atomic_load_n( &global, __ATOMIC_RELAXED );
+	for ( uReclaimable * n = r->retired.head; n != nullptr; n = n->reclaimNext ) n->reclaimEpoch = e;
+
+	r->state = r->nesting = 0;
+	uKernelModule::uKernelModuleData::disableInterrupts();
+	if ( &uThisProcessor() != &processor ) {			// processor deleting itself during shutdown keeps its nodes
+		uEpochRecord * mine = uThisProcessor().epochRecord;
+		if ( mine == nullptr ) mine = attach();
+		mine->retired.add( r->retired );
+		mine->hazards.add( r->hazards );
+	} // if
+	uKernelModule::uKernelModuleData::enableInterrupts();
+
+	__atomic_store_n( &r->inUse, false, __ATOMIC_RELEASE );
+} // uEpoch::detach
+
+
+// Called after all tasks and processors are deleted, so no node can be referenced.
+void uEpoch::shutdown() {
+	for ( uEpochRecord * r = records; r != nullptr; ) {
+		uEpochRecord * next = r->next;
+		destroy( r->retired.head );
+		destroy( r->hazards.head );
+		delete r;
+		r = next;
+	} // for
+	records = nullptr;
+	for ( uHazardPointer::Slot * s = uHazardPointer::slots; s != nullptr; ) {
+		uHazardPointer::Slot * next = s->next;
+		delete s;
+		s = next;
+	} // for
+	uHazardPointer::slots = nullptr;
+} // uEpoch::shutdown
+
+
+// Retired nodes are deleted outside any guard, because a node's destructor may block.
+void uEpoch::retire( uReclaimable * node ) {
+	uKernelModule::uKernelModuleData::disableInterrupts();
+	uEpochRecord * r = uThisProcessor().epochRecord;
+	if ( r == nullptr ) r = attach();
+	__atomic_thread_fence( __ATOMIC_SEQ_CST );			// node removed before reading epoch
+	node->reclaimEpoch = __atomic_load_n( &global, __ATOMIC_RELAXED );
+	r->retired.add( node );
+	bool full = r->retired.count >= RetireThreshold && r->nesting == 0;
+	uKernelModule::uKernelModuleData::enableInterrupts();
+	if ( full ) reclaim();
+} // uEpoch::retire
+
+
+void uEpoch::reclaim() {
+	uKernelModule::uKernelModuleData::disableInterrupts();
+	uEpochRecord * r = uThisProcessor().epochRecord;
+	uReclaimable * expired = nullptr;
+	if ( r != nullptr && r->retired.head != nullptr ) {
+		advance();
+		expired = r->retired.expired( __atomic_load_n( &global, __ATOMIC_ACQUIRE ) );
+	} // if
+	uKernelModule::uKernelModuleData::enableInterrupts();
+	destroy( expired );
+} // uEpoch::reclaim
+
+
+// Pre: not in a guard.
+void uEpoch::synchronize() {
+	for ( ;; ) {
+		reclaim();
+		uKernelModule::uKernelModuleData::disableInterrupts();
+		uEpochRecord * r = uThisProcessor().epochRecord;
+		bool empty = r == nullptr || r->retired.head == nullptr;
+		uKernelModule::uKernelModuleData::enableInterrupts();
+	  if ( empty ) break;
+		uThisTask().yield();							// let guards on other processors finish
+	} // for
+} // uEpoch::synchronize
+
+
+//######################### uHazardPointer #########################
+
+
+uHazardPointer::Slot * uHazardPointer::claim() {
+	Slot * slot;
+	for ( slot = slots; slot != nullptr; slot = slot->next ) { // reuse released slot ?
+		if ( ! slot->inUse && ! __atomic_exchange_n( &slot->inUse, true, __ATOMIC_ACQUIRE ) ) return slot;
+	} // for
+	slot = new Slot;
+	slot->ptr = nullptr;
+	slot->inUse = true;
+	slot->next = slots;
+	while ( ! uCompareAssignValue( slots, slot->next, slot ) ); // push, failure updates slot->next
+	uFetchAdd( noOfSlots, 1 );
+	return slot;
+} // uHazardPointer::claim
+
+void uHazardPointer::release( uBaseTask & task ) {
+	Slot * slot = (Slot *)task.hazardSlot_;
+  if ( slot == nullptr ) return;
+	task.hazardSlot_ = nullptr;
+	__atomic_store_n( &slot->inUse, false, __ATOMIC_RELEASE );
+} // uHazardPointer::release
+
+
+// Reclaim when the retired nodes are at least twice the slots, so at least half are deleted by each scan.
+void uHazardPointer::retire( uReclaimable * node ) {
+	uKernelModule::uKernelModuleData::disableInterrupts();
+	uEpochRecord * r = uThisProcessor().epochRecord;
+	if ( r == nullptr ) r = uEpoch::attach();
+	r->hazards.add( node );
+	size_t count = r->hazards.count;
+	uKernelModule::uKernelModuleData::enableInterrupts();
+	if ( count >= (size_t)uEpoch::RetireThreshold + 2 * __atomic_load_n( &noOfSlots, __ATOMIC_RELAXED ) ) reclaim();
+} // uHazardPointer::retire
+
+
+void uHazardPointer::reclaim() {
+	uEpochRecord::Retired list, keep;
+	uKernelModule::uKernelModuleData::disableInterrupts();
+	uEpochRecord * r = uThisProcessor().epochRecord;
+	if ( r != nullptr ) list.add( r->hazards );			// take the nodes
+	uKernelModule::uKernelModuleData::enableInterrupts();
+  if ( list.head == nullptr ) return;
+
+	__atomic_thread_fence( __ATOMIC_SEQ_CST );			// nodes removed before reading slots
+	Slot * all = __atomic_load_n( &slots, __ATOMIC_ACQUIRE ); // slots added later cannot hold retired nodes
+	size_t size = 0, cnt = 0;
+	for ( Slot * s = all; s != nullptr; s = s->next ) size += 1;
+	void ** hazards = new void *[size];
+	for ( Slot * s = all; s != nullptr; s = s->next ) {
+		void * p = __atomic_load_n( &s->ptr, __ATOMIC_ACQUIRE );
+		if ( p != nullptr ) { hazards[cnt] = p; cnt += 1; }
+	} // for
+	std::sort( hazards, hazards + cnt );
+
+	for ( uReclaimable * n = list.head; n != nullptr; ) {
+		uReclaimable * next = n->reclaimNext;
+		if ( std::binary_search( hazards, hazards + cnt, (void *)n ) ) {
+			keep.add( n );								// still protected
+		} else {
+			delete n;
+		} // if
+		n = next;
+	} // for
+	delete [] hazards;
+
+	if ( keep.head != nullptr ) {
+		uKernelModule::uKernelModuleData::disableInterrupts();
+		r = uThisProcessor().epochRecord;				// task may have migrated
+		if ( r == nullptr ) r = uEpoch::attach();
+		r->hazards.add( keep );
+		uKernelModule::uKernelModuleData::enableInterrupts();
+	} // if
+} // uHazardPointer::reclaim
+
+
+// Local Variables: //
+// compile-command: "make install" //
+// End: //
@@ -0,0 +1,213 @@
+//                              -*- Mode: C++ -*-
+//
+// uC++ Version 7.0.0, Copyright (C) Peter A. Buhr 2026
+//
+// uEpoch.h -- Safe memory reclamation for lock-free data structures
+//
+// Author           : agent
+// Created On       : Mon Oct 19 01:49:07 2026
+// Last Modified By : agent
+// Last Modified On : Mon Oct 19 05:20:52 2026
+// Update Count     : 2
+//
+// This  library is free  software; you  can redistribute  it and/or  modify it
+// under the terms of the GNU Lesser General Public License as published by the
+// Free Software  Foundation; either  version 2.1 of  the License, or  (at your
+// option) any later version.
+//
+// This library is distributed in the  hope that it will be useful, but WITHOUT
+// ANY  WARRANTY;  without even  the  implied  warranty  of MERCHANTABILITY  or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+// for more details.
+//
+// You should  have received a  copy of the  GNU Lesser General  Public License
+// along  with this library.
+//
+
+
+#pragma once
+
+
+// A node removed from a lock-free data structure may still be read by tasks that found it before it was removed, so it
+// cannot be deleted immediately. Instead, the node, which must inherit from uReclaimable, is retired, and it is deleted
+// once no task can still hold a reference to it. Two schemes are provided:
+//
+// uEpoch: a task reads the data structure inside a uEpoch::Guard. A guard is a short non-preemptive section on the
+// current uProcessor, so it must not block, yield or perform I/O. Each processor announces the global epoch when it
+// enters a guard, and the epoch advances when every processor in a guard has announced it. A node retired in epoch e is
+// deleted once the global epoch reaches e + 2. A processor outside a guard, including its kernel between user tasks, is
+// quiescent and never delays reclamation, and the processor kernel advances the epoch when it has nodes waiting.
+//
+// uHazardPointer: a task publishes each node it is about to dereference in a hazard slot, and a retired node is deleted
+// once no slot holds it. Hazard pointers cost a fence per protected node, but a task may block while holding one.
+//
+// Retired nodes are kept with the processor that retired them and are deleted in user context, never by the kernel. The
+// nodes of a deleted processor are passed to the processor of the task deleting it.
+
+class uReclaimable {
+	friend class uEpoch;								// access: reclaimNext, reclaimEpoch
+	friend class uHazardPointer;						// access: reclaimNext
+	friend struct uEpochRecord;							// access: reclaimNext, reclaimEpoch
+
+	uReclaimable * reclaimNext;							// list of retired nodes
+	size_t reclaimEpoch;								// global epoch when retired
+  public:
+	virtual ~uReclaimable() {}
+}; // uReclaimable
+
+
+// Per-processor reclamation state, on a separate cache line from other processors' state. Records are never freed; a
+// record released by a deleted processor is reused by a new processor.
+
+struct __attribute__(( aligned( 64 ) )) uEpochRecord {
+	struct Retired {									// FIFO list of retired nodes
+		uReclaimable * head, * tail;
+		size_t count;
+
+		Retired() : head( nullptr ), tail( nullptr ), count( 0 ) {}
+		void add( uReclaimable * n );
+		void add( Retired & list );						// move list to the end
+		uReclaimable * expired( size_t epoch );			// remove nodes retired by epoch - 2
+	}; // Retired
+
+	uEpochRecord * next;								// list of all records, push only
+	volatile bool inUse;								// owned by a processor ?
+	volatile size_t state;								// epoch << 1 | in guard
+	unsigned int nesting;								// guard nesting depth
+	Retired retired;									// waiting for the epoch to advance
+	Retired hazards;									// waiting for hazard pointers to clear
+
+	uEpochRecord() : next( nullptr ), inUse( true ), state( 0 ), nesting( 0 ) {}
+}; // uEpochRecord
+
+
+class uEpoch {
+	friend _Coroutine UPP::uProcessorKernel;			// access: quiescent
+	friend class uProcessor;							// access: detach
+	friend class uHazardPointer;						// access: attach, records
+	friend class UPP::uKernelBoot;						// access: shutdown
+
+	enum { RetireThreshold = 64 };						// retired nodes on a processor before reclaiming
+
+	static volatile size_t global;						// global epoch
+	static uEpochRecord * volatile records;				// all records, push only
+
+	static uEpochRecord * attach();						// pre and post: interrupts disabled
+	static bool advance();
+	static void destroy( uReclaimable * list );
+	static void quiescent( uProcessor & processor );	// called by processor kernel
+	static void detach( uProcessor & processor );		// called when processor deleted
+	static void shutdown();								// delete all records and remaining nodes
+  public:
+	class Guard {
+	  public:
+		Guard( const Guard & ) = delete;				// no copy
+		Guard( Guard && ) = delete;
+		Guard & operator=( const Guard & ) = delete;	// no assignment
+		Guard & operator=( Guard && ) = delete;
+
+		Guard() { uEpoch::enter(); }
+		~Guard() { uEpoch::exit(); }
+	}; // Guard
+
+	static void enter();								// start non-preemptive read-side section
+	static void exit();									// end read-side section
+	static void retire( uReclaimable * node );			// delete node when no guard can reference it
+	static void reclaim();								// delete expired nodes retired on this processor
+	static void synchronize();							// wait until nodes retired on this processor are deleted
+	static size_t epoch() { return __atomic_load_n( &global, __ATOMIC_RELAXED ); }
+}; // uEpoch
+
+
+inline void uEpoch::enter() {
+	uKernelModule::uKernelModuleData::disableInterrupts(); // no preemption or migration until exit
+	uEpochRecord * r = uThisProcessor().epochRecord;
+	if ( UNLIKELY( r == nullptr ) ) r = attach();		// first guard on this processor ?
+	if ( r->nesting == 0 ) {
+		__atomic_store_n( &r->state, __atomic_load_n( &global, __ATOMIC_RELAXED ) << 1 | 1, __ATOMIC_RELAXED );
+		__atomic_thread_fence( __ATOMIC_SEQ_CST );		// announce before reading the data structure
+	} // if
+	r->nesting += 1;
+} // uEpoch::enter
+
+inline void uEpoch::exit() {
+	uEpochRecord * r = uThisProcessor().epochRecord;
+	r->nesting -= 1;
+	if ( r->nesting == 0 ) {
+		__atomic_store_n( &r->state, r->state & ~(size_t)1, __ATOMIC_RELEASE ); // reads completed before leaving
+	} // if
+	uKernelModule::uKernelModuleData::enableInterrupts();
+} // uEpoch::exit
+
+
+// Claiming a slot searches the list of all slots, so each task keeps the slot of its last hazard pointer, which stays
+// in use, and its next hazard pointer takes it without searching. The slot is released when the task terminates.
+
+class uHazardPointer {
+	friend class uEpoch;								// access: Slot, slots
+	friend class UPP::uMachContext;						// access: release
+
+	struct Slot {
+		Slot * next;									// list of all slots, push only
+		void * volatile ptr;							// protected node
+		volatile bool inUse;							// owned by a uHazardPointer or task ?
+	}; // Slot
+
+	static Slot * volatile slots;						// all slots, push only
+	static volatile size_t noOfSlots;
+
+	Slot * slot;
+
+	static Slot * claim();								// search for free slot or allocate one
+	static void release( uBaseTask & task );			// called when task terminates
+  public:
+	uHazardPointer( const uHazardPointer & ) = delete;	// no copy
+	uHazardPointer( uHazardPointer && ) = delete;
+	uHazardPointer & operator=( const uHazardPointer & ) = delete; // no assignment
+	uHazardPointer & operator=( uHazardPointer && ) = delete;
+
+	uHazardPointer() {									// claim a slot
+		uBaseTask & task = uThisTask();
+		slot = (Slot *)task.hazardSlot_;
+		if ( LIKELY( slot != nullptr ) ) {				// task's slot ?
+			task.hazardSlot_ = nullptr;					// nested hazard pointers claim other slots
+		} else {
+			slot = claim();
+		} // if
+	} // uHazardPointer::uHazardPointer
+
+	~uHazardPointer() {									// release the slot
+		clear();
+		uBaseTask & task = uThisTask();
+		if ( LIKELY( task.hazardSlot_ == nullptr ) ) {	// keep slot for next hazard pointer
+			task.hazardSlot_ = slot;
+		} else {
+			__atomic_store_n( &slot->inUse, false, __ATOMIC_RELEASE );
+		} // if
+	} // uHazardPointer::~uHazardPointer
+
+	// Return the node in src after protecting it: the slot is set and src is re-read until it is unchanged, so the node
+	// cannot have been retired before it was protected. T must inherit from uReclaimable.
+	template<typename T> T * protect( T * const volatile & src ) {
+		T * p = __atomic_load_n( &src, __ATOMIC_ACQUIRE );
+		for ( ;; ) {
+			__atomic_store_n( &slot->ptr, (void *)static_cast<const uReclaimable *>( p ), __ATOMIC_RELAXED );
+			__atomic_thread_fence( __ATOMIC_SEQ_CST );	// publish before re-reading
+			T * q = __atomic_load_n( &src, __ATOMIC_ACQUIRE );
+		  if ( q == p ) return p;
+			p = q;
+		} // for
+	} // uHazardPointer::protect
+
+	void clear() {
+		__atomic_store_n( &slot->ptr, nullptr, __ATOMIC_RELEASE );
+	} // uHazardPointer::clear
+
+	static void retire( uReclaimable * node );			// delete node when no slot holds it
+	static void reclaim();								// delete unprotected nodes retired on this processor
+}; // uHazardPointer
+
+
+// Local Variables: //
+// compile-command: "make install" //
+// End: //
@@ -0,0 +1,154 @@
+//                              -*- Mode: C++ -*-
+//
+// uC++ Version 7.0.0, Copyright (C) Peter A. Buhr 2026
+//
+// uHWCounters.cc --
+//
+// Author           : agent
+// Created On       : Mon Oct 19 00:01:11 2026
+// Last Modified By : agent
+// Last Modified On : Mon Oct 19 00:01:11 2026
+// Update Count     : 1
+//
+// This  library is free  software; you  can redistribute  it and/or  modify it
+// under the terms of the GNU Lesser General Public License as published by the
+// Free Software  Foundation; either  version 2.1 of  the License, or  (at your
+// option) any later version.
+//
+// This library is distributed in the  hope that it will be useful, but WITHOUT
+// ANY  WARRANTY;  without even  the  implied  warranty  of MERCHANTABILITY  or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+// for more details.
+//
+// You should  have received a  copy of the  GNU Lesser General  Public License
+// along  with this library.
+//
+
+
+#define __U_KERNEL__
+#include <uC++.h>
+#include <uProcessor.h>
+
+#include <cstring>										// memset
+#include <unistd.h>										// read, close, syscall
+#include <sys/ioctl.h>									// ioctl
+#include <sys/syscall.h>								// SYS_perf_event_open
+#include <linux/perf_event.h>							// perf_event_attr
+
+
+static const struct {
+	uint32_t type;
+	uint64_t config;
+	const char * name;
+} events[uHWCounters::NoOfEvents] = {					// order matches uHWCounters::Event
+	{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, "cycles" },
+	{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, "instructions" },
+	{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, "cache misses" },
+	{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES, "branch misses" },
+};
+
+
+uHWCounters::uHWCounters() : leader( -1 ), members( 0 ) {
+	for ( unsigned int e = 0; e < NoOfEvents; e += 1 ) {
+		struct perf_event_attr attr;
+		memset( &attr, 0, sizeof(attr) );
+		attr.size = sizeof(attr);
+		attr.type = events[e].type;
+		attr.config = events[e].config;
+		attr.read_format = PERF_FORMAT_GROUP;
+		attr.disabled = leader == -1;					// group starts when leader is enabled
+		attr.exclude_kernel = 1;						// user-level execution only, works with perf_event_paranoid 2
+		attr.exclude_hv = 1;
+
+		// pid 0 and cpu -1 => calling kernel thread on any CPU
+		fds[e] = syscall( SYS_perf_event_open, &attr, 0, -1, leader, PERF_FLAG_FD_CLOEXEC );
+		if ( fds[e] == -1 ) {
+		  if ( leader == -1 ) break;					// no leader => no counters
+			continue;									// event not supported, count others
+		} // if
+		if ( leader == -1 ) leader = fds[e];
+		order[members] = (Event)e;
+		members += 1;
+	} // for
+
+	if ( leader != -1 ) {
+		ioctl( leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP );
+		ioctl( leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP );
+	} else {
+		for ( unsigned int e = 0; e < NoOfEvents; e += 1 ) fds[e] = -1;
+	} // if
+} // uHWCounters::uHWCounters
+
+
+uHWCounters::~uHWCounters() {
+	if ( leader == -1 ) return;
+	ioctl( leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP );
+	for ( unsigned int e = 0; e < NoOfEvents; e += 1 ) {
+		if ( fds[e] != -1 && fds[e] != leader ) close( fds[e] );
+	} // for
+	close( leader );									// close leader last
+} // uHWCounters::~uHWCounters
+
+
+void uHWCounters::read( Counts & counts ) const {
+	// A group read returns the number of events followed by the value of each event in group order.
+	uint64_t values[1 + NoOfEvents];
+	ssize_t rlen = ::read( leader, values, sizeof(uint64_t) * (1 + members) );
+	if ( UNLIKELY( rlen != (ssize_t)(sizeof(uint64_t) * (1 + members)) ) ) return; // counts unchanged
+	for ( unsigned int m = 0; m < members; m += 1 ) {
+		counts[order[m]] = values[1 + m];
+	} // for
+} // uHWCounters::read
+
+
+bool uHWCounters::start( uProcessor & processor ) {
+	return processor.procTask->setHWCounters( true );
+} // uHWCounters::start
+
+
+void uHWCounters::stop( uProcessor & processor ) {
+	processor.procTask->setHWCounters( false );
+} // uHWCounters::stop
+
+
+bool uHWCounters::active( uProcessor & processor ) {
+	return processor.hwCounters != nullptr;
+} // uHWCounters::active
+
+
+bool uHWCounters::available( uProcessor & processor, Event event ) {
+	uHWCounters * counters = processor.hwCounters;
+	return counters != nullptr && counters->fds[event] != -1;
+} // uHWCounters::available
+
+
+uHWCounters::Counts uHWCounters::read( uProcessor & processor ) {
+	return processor.procTask->readHWCounters();		// mutual exclusion with closing the counters
+} // uHWCounters::read
+
+
+uHWCounters::Counts uHWCounters::read( uBaseTask & task ) {
+	Counts counts;
+	uKernelModule::uKernelModuleData::disableInterrupts(); // no preemption => task cannot change processors
+	counts = task.hwCounters_;
+	if ( &task == &uThisTask() ) {						// add counts since task last started executing
+		uHWCounters * counters = uThisProcessor().hwCounters;
+		if ( counters != nullptr ) {
+			Counts now;
+			counters->read( now );
+			counts += now - counters->begin;
+		} // if
+	} // if
+	uKernelModule::uKernelModuleData::enableInterrupts();
+	return counts;
+} // uHWCounters::read
+
+
+const char * uHWCounters::name( Event event ) {
+	return events[event].name;
+} // uHWCounters::name
+
+
+// Local Variables: //
+// compile-command: "make install" //
+// End: //
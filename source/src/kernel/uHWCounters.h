@@ -0,0 +1,108 @@
+//                              -*- Mode: C++ -*-
+//
+// uC++ Version 7.0.0, Copyright (C) Peter A. Buhr 2026
+//
+// uHWCounters.h --
+//
+// Author           : agent
+// Created On       : Mon Oct 19 00:01:11 2026
+// Last Modified By : agent
+// Last Modified On : Mon Oct 19 00:01:11 2026
+// Update Count     : 1
+//
+// This  library is free  software; you  can redistribute  it and/or  modify it
+// under the terms of the GNU Lesser General Public License as published by the
+// Free Software  Foundation; either  version 2.1 of  the License, or  (at your
+// option) any later version.
+//
+// This library is distributed in the  hope that it will be useful, but WITHOUT
+// ANY  WARRANTY;  without even  the  implied  warranty  of MERCHANTABILITY  or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+// for more details.
+//
+// You should  have received a  copy of the  GNU Lesser General  Public License
+// along  with this library.
+//
+
+
+#pragma once
+
+
+#include <cstdint>										// uint64_t
+
+
+// Hardware performance counters (Linux perf_event_open) for a uProcessor's kernel thread. A counter group is opened
+// on the kernel thread by the processor's uProcessorTask, and then counts cycles, instructions, cache misses and branch
+// misses for that kernel thread. While a processor's counters are active, the processor kernel reads the group before
+// and after each user task executes (at the uSwitch boundaries) and adds the difference to the task's counts, so the
+// counts are virtualized across user-level context switches. In the uniprocessor kernel, all uProcessors share one
+// UNIX process so processor counts include all processors.
+
+class uHWCounters {
+	friend _Coroutine UPP::uProcessorKernel;			// access: switchIn, switchOut
+	friend _Task uProcessorTask;						// access: uHWCounters, ~uHWCounters, read
+  public:
+	enum Event { Cycles, Instructions, CacheMisses, BranchMisses, NoOfEvents };
+
+	struct Counts {
+		uint64_t counts[NoOfEvents];
+
+		Counts() {
+			for ( unsigned int i = 0; i < NoOfEvents; i += 1 ) counts[i] = 0;
+		} // Counts::Counts
+
+		uint64_t operator[]( Event e ) const { return counts[e]; }
+		uint64_t & operator[]( Event e ) { return counts[e]; }
+
+		Counts & operator+=( const Counts & rhs ) {
+			for ( unsigned int i = 0; i < NoOfEvents; i += 1 ) counts[i] += rhs.counts[i];
+			return *this;
+		} // Counts::operator+=
+
+		Counts operator-( const Counts & rhs ) const {
+			Counts diff;
+			for ( unsigned int i = 0; i < NoOfEvents; i += 1 ) diff.counts[i] = counts[i] - rhs.counts[i];
+			return diff;
+		} // Counts::operator-
+	}; // Counts
+  private:
+	int leader;											// group leader file descriptor
+	int fds[NoOfEvents];								// -1 => event not available on this hardware
+	unsigned int members;								// number of events in the group
+	Event order[NoOfEvents];							// event for each group position, in read order
+	Counts begin;										// group values when current user task started executing
+
+	uHWCounters();										// open on calling kernel thread
+	~uHWCounters();
+
+	bool opened() const { return leader != -1; }
+	void read( Counts & counts ) const;
+
+	void switchIn() {									// user task about to execute
+		read( begin );
+	} // uHWCounters::switchIn
+
+	void switchOut( Counts & task ) {					// user task stopped executing
+		Counts end = begin;								// failed read => no change
+		read( end );
+		task += end - begin;
+	} // uHWCounters::switchOut
+  public:
+	uHWCounters( const uHWCounters & ) = delete;		// no copy
+	uHWCounters( uHWCounters && ) = delete;
+	uHWCounters & operator=( const uHWCounters & ) = delete; // no assignment
+	uHWCounters & operator=( uHWCounters && ) = delete;
+
+	static bool start( uProcessor & processor );		// open counters on processor, false => unsupported/denied
+	static void stop( uProcessor & processor );			// close counters on processor
+	static bool active( uProcessor & processor );
+	static bool available( uProcessor & processor, Event event ); // event counted on processor ?
+	static Counts read( uProcessor & processor );		// processor counts since start
+	static Counts read( uBaseTask & task );				// task counts while executing on processors with counters
+	static const char * name( Event event );
+}; // uHWCounters
+
+
+// Local Variables: //
+// compile-command: "make install" //
+// End: //
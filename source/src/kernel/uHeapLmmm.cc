@@ -35,9 +35,14 @@
 #include <cerrno>										// errno, ENOMEM, EINVAL
 #include <cassert>										// assert
 #include <cstdint>										// uintptr_t, uint64_t, uint32_t
-#include <unistd.h>										// STDERR_FILENO, sbrk, sysconf, write
-#include <sys/mman.h>									// mmap, munmap
+#include <unistd.h>										// STDERR_FILENO, sysconf, write
+#include <sys/mman.h>									// mmap, munmap, mprotect, madvise
 #include <sys/sysinfo.h>								// get_nprocs
+#include <sys/syscall.h>								// SYS_getcpu, SYS_mbind
+#include <fcntl.h>										// open
+#include <execinfo.h>									// backtrace, backtrace_symbols_fd
+#include <cmath>										// log, exp
+#include <new>											// align_val_t
 
 #define str(s) #s
 #define xstr(s) str(s)
@@ -54,6 +59,11 @@
 #if ! defined( __OWNERSHIP__ ) && defined( __REMOTESPIN__ )
 #warning "REMOTESPIN is ignored without OWNERSHIP; suggest commenting out REMOTESPIN"
 #endif // ! __OWNERSHIP__ && __REMOTESPIN__
+#define __SLAB__										// small allocations are headerless, carved from aligned slab pages
+#if defined( SYS_getcpu ) && defined( SYS_mbind )
+#define __NUMA__										// heaps and their storage are placed on the NUMA node of their thread
+#endif // SYS_getcpu && SYS_mbind
+#define __SAMPLE__										// sampling heap profiler, active when malloc_sample_rate() > 0
 
 #define LIKELY(x) __builtin_expect(!!(x), 1)
 #define UNLIKELY(x) __builtin_expect(!!(x), 0)
@@ -92,7 +102,7 @@ static inline __attribute__((always_inline)) size_t Bsearchl( unsigned int key,
 
 
 #ifdef __U_STATISTICS__
-enum { CntTriples = 13 };								// number of counter triples
+enum { CntTriples = 14 };								// number of counter triples
 struct HeapStatistics {
 	enum { MALLOC, AALLOC, CALLOC, MEMALIGN, AMEMALIGN, CMEMALIGN, RESIZE, REALLOC, FREE };
 	union {
@@ -121,6 +131,8 @@ struct HeapStatistics {
 			unsigned long long int free_storage_request, free_storage_alloc;
 			unsigned long long int remote_pushes, remote_pulls;
 			unsigned long long int remote_storage_request, remote_storage_alloc;
+			unsigned long long int node_pushes, node_0_pushes; // remote pushes to a heap on another node, no zero pushes
+			unsigned long long int node_storage_request, node_storage_alloc;
 			unsigned long long int mmap_calls, mmap_0_calls; // no zero calls
 			unsigned long long int mmap_storage_request, mmap_storage_alloc;
 			unsigned long long int munmap_calls, munmap_0_calls; // no zero calls
@@ -198,6 +210,9 @@ struct Heap {
 		Storage * freeList;								// thread free list
 		Heap * homeManager;								// heap owner (free storage to bucket, from bucket to heap)
 		size_t blockSize;								// size of allocations on this list
+		#ifdef __SLAB__
+		char * slabNext, * slabEnd;						// unallocated objects in current slab page (slab buckets only)
+		#endif // __SLAB__
 		#if defined( __U_STATISTICS__ )
 		size_t allocations, reuses;
 		#endif // __U_STATISTICS__
@@ -208,14 +223,25 @@ struct Heap {
 	enum { NoBucketSizes = 60 };						// number of bucket sizes
 
 	FreeHeader freeLists[NoBucketSizes];				// buckets for different allocation sizes
+	#ifdef __SLAB__
+	// Headerless buckets for allocations of 16, 32, 48 and 64 bytes. Slab buckets are separate from the corresponding
+	// header buckets, which still serve small allocations needing a header, e.g., calloc and memalign.
+	enum { NoSlabSizes = 4, SlabStep = 16 };
+	FreeHeader slabLists[NoSlabSizes];
+	#endif // __SLAB__
 	void * bufStart;									// start of current buffer
 	size_t bufRemaining;								// remaining free storage in buffer
+	#ifdef __SAMPLE__
+	ptrdiff_t sampleCountdown;							// bytes allocated before next sample
+	uint64_t sampleSeed;								// random state for sample intervals
+	#endif // __SAMPLE__
 
 	#if defined( __U_STATISTICS__ ) || defined( __U_DEBUG__ )
 	Heap * nextHeapManager;								// intrusive link of existing heaps; traversed to collect statistics or check unfreed storage
 	#endif // __U_STATISTICS__ || __U_DEBUG__
 	Heap * nextFreeHeapManager;							// intrusive link of free heaps from terminated threads; reused by new threads
 
+	unsigned int node;									// NUMA node of heap storage
 	uDEBUG(	ptrdiff_t allocUnfreed; );					// running total of allocations minus frees; can be negative
 
 	#ifdef __U_STATISTICS__
@@ -256,13 +282,38 @@ enum { LookupSizes = 65'536 + sizeof(Heap::Storage) };	// number of fast lookup
 static unsigned char CALIGN lookup[LookupSizes];		// O(1) lookup for small sizes
 #endif // __FASTLOOKUP__
 
+#ifdef __SLAB__
+// Slab objects have no header. A slab page is aligned on its size, so the page header, giving the owning bucket, is
+// found by masking an object address. All slab pages are carved from one reserved address range, so a single range
+// check separates slab objects from storage with a header.
+//
+// <--------------------------------- SlabPageSize --------------------------------->
+// |page header|object|object| ... |object|unused|
+// ^SlabPageSize alignment
+struct SlabPage {
+	Heap::FreeHeader * home;							// slab bucket owning the page
+}; // SlabPage
+
+enum {
+	SlabPageSize = 64 * 1024,							// power of 2
+	SlabPageHeader = CACHE_ALIGN,						// objects start on a cache line
+	SlabMaxSize = Heap::NoSlabSizes * Heap::SlabStep,	// largest headerless allocation
+};
 
-// Manipulate sticky bits stored in unused 3 low-order bits of an address.
+static_assert( sizeof(SlabPage) <= SlabPageHeader, "slab page header too large" );
+
+#define SlabPageAddr( addr ) ((SlabPage *)((uintptr_t)(addr) & ~(uintptr_t)(SlabPageSize - 1)))
+#define SlabIndex( size ) ((size) <= Heap::SlabStep ? 0 : ((size) - 1) / Heap::SlabStep)
+#endif // __SLAB__
+
+
+// Manipulate sticky bits stored in unused 4 low-order bits of an address.
 //   bit0 => alignment => fake header
 //   bit1 => zero filled (calloc)
-//   bit2 => mapped allocation versus sbrk
-#define StickyBits( header ) (((header)->kind.real.blockSize & 0x7))
-#define ClearStickyBits( addr ) (decltype(addr))((uintptr_t)(addr) & ~7)
+//   bit2 => mapped allocation versus arena
+//   bit3 => sampled by heap profiler
+#define StickyBits( header ) (((header)->kind.real.blockSize & 0xf))
+#define ClearStickyBits( addr ) (decltype(addr))((uintptr_t)(addr) & ~15)
 #define MarkAlignmentBit( alignment ) ((alignment) | 1)
 #define AlignmentBit( header ) ((((header)->kind.fake.alignment) & 1))
 #define ClearAlignmentBit( header ) (((header)->kind.fake.alignment) & ~1)
@@ -271,35 +322,66 @@ static unsigned char CALIGN lookup[LookupSizes];		// O(1) lookup for small sizes
 #define MarkZeroFilledBit( header ) ((header)->kind.real.blockSize |= 2)
 #define MmappedBit( header ) ((((header)->kind.real.blockSize) & 4))
 #define MarkMmappedBit( size ) ((size) | 4)
+#define SampledBit( header ) ((((header)->kind.real.blockSize) & 8))
+#define MarkSampledBit( header ) ((header)->kind.real.blockSize |= 8)
+#define ClearSampledBit( header ) ((((header)->kind.real.blockSize) &= ~8))
+
+static_assert( alignof(Heap::FreeHeader) >= 16, "free-list address has too few unused bits for sticky bits" );
 
 
 enum {
-	// The default extension heap amount in units of bytes. When the current heap reaches the brk address, the brk
-	// address is extended by the extension amount.
+	// The default arena size in units of bytes. When a heap's arena is full, the heap is given a new arena of this size
+	// from the heap reserve.
 	__DEFAULT_HEAP_EXTEND__ = 8 * 1024 * 1024,
 
+	// Arenas are aligned on the huge-page size when using transparent huge pages.
+	HugePageSize = 2 * 1024 * 1024,
+
 	// The mmap crossover point during allocation. Allocations less than this amount are allocated from buckets; values
 	// greater than or equal to this value are mmap from the operating system.
 	__DEFAULT_MMAP_START__ = 8 * 1024 * 1024 + sizeof(Heap::Storage),
 
 	// The default unfreed storage amount in units of bytes. When the program ends it subtracts this amount from
 	// the malloc/free counter to adjust for storage the program does not free.
-	__DEFAULT_HEAP_UNFREED__ = 0
+	__DEFAULT_HEAP_UNFREED__ = 0,
+
+	// Nodes at or above this number are treated as node 0, i.e., storage is not bound.
+	MaxNumaNodes = 64,
 }; // enum
 
+// The address space reserved for heap arenas in units of bytes, which is halved until the reservation succeeds. Storage
+// is committed only when an arena is given to a heap.
+#define __DEFAULT_HEAP_RESERVE__ (sizeof(void *) == 8 ? (size_t)256 * 1024 * 1024 * 1024 : (size_t)1024 * 1024 * 1024)
+
+// The default address space reserved for slab pages in units of bytes. Only touched pages use memory. When the reserve
+// is exhausted, small allocations fall back to buckets with headers.
+#define __DEFAULT_SLAB_REGION__ (sizeof(void *) == 8 ? (size_t)16 * 1024 * 1024 * 1024 : (size_t)256 * 1024 * 1024)
+
 
 struct HeapMaster {
 	uNoCtor<uSpinLock, false> extLock;					// protects allocation-buffer extension
 	uNoCtor<uSpinLock, false> mgrLock;					// protects freeHeapManagersList, heapManagersList, heapManagersStorage, heapManagersStorageEnd
 
-	void * sbrkStart;									// start of sbrk storage
-	void * sbrkEnd;										// end of sbrk area (logical end of heap)
-	size_t sbrkRemaining;								// amount of free storage at end of sbrk area
-	size_t sbrkExtend;									// sbrk extend amount
+	void * heapStart;									// start of arena reserve
+	void * heapEnd;										// end of arenas given to heaps (logical end of heap)
+	size_t heapRemaining;								// unused reserve after heapEnd
+	size_t arenaExtend;									// arena size
+	size_t arenaAlign;									// arena alignment, page or huge-page size
+	bool hugePages;										// arenas use transparent huge pages
+	unsigned int numaNodes;								// online NUMA nodes, 1 => no node placement
+	#ifdef __SAMPLE__
+	size_t sampleRate;									// mean bytes allocated between samples, 0 => no sampling
+	#endif // __SAMPLE__
 	size_t pageSize;									// architecture pagesize
 	size_t mmapStart;									// cross over point for mmap
 	size_t maxBucketsUsed;								// maximum number of buckets in use
 
+	#ifdef __SLAB__
+	char * slabStart;									// start of slab reserve
+	char * slabNext;									// next unused slab page
+	size_t slabSize;									// size of slab reserve, 0 => no slabs
+	#endif // __SLAB__
+
 	#if defined( __U_STATISTICS__ ) || defined( __U_DEBUG__ )
 	Heap * heapManagersList;							// heap-stack head
 	#endif // __U_STATISTICS__ || __U_DEBUG__
@@ -316,8 +398,15 @@ struct HeapMaster {
 	unsigned long long int nremainder, remainder;		// counts mostly unusable storage at the end of a thread's reserve block
 	unsigned long long int threads_started, threads_exited; // counts threads that have started and exited
 	unsigned long long int reused_heap, new_heap;		// counts reusability of heaps
-	unsigned long long int sbrk_calls;
-	unsigned long long int sbrk_storage;
+	unsigned long long int arena_calls;					// arenas given to heaps
+	unsigned long long int arena_storage;
+	unsigned long long int slab_pages;					// slab pages carved from the reserve
+	unsigned long long int slab_storage;
+	struct NodeStatistics {								// per NUMA node
+		unsigned long long int new_heap, reused_heap, rebinds; // heaps placed on the node
+		unsigned long long int arena_calls, slab_pages, storage; // storage bound to the node
+		unsigned long long int node_pushes, node_storage_request, node_storage_alloc; // frees to other nodes by exited heaps
+	} nodeStats[MaxNumaNodes];
 	int stats_fd;
 	#endif // __U_STATISTICS__
 }; // HeapMaster
@@ -334,6 +423,107 @@ static __U_THREAD_LOCAL__ Heap * heapManager CALIGN = (Heap *)1; // singleton
 static __U_THREAD_LOCAL__ size_t PAD2 CALIGN __attribute__(( unused )); // protect further false sharing
 
 
+#ifdef __NUMA__
+#ifndef MPOL_PREFERRED
+#define MPOL_PREFERRED 1								// <numaif.h> is not always installed
+#endif // MPOL_PREFERRED
+
+// Nodes are listed as ranges, e.g., "0", "0-3" or "0,2-3", so the last number is the highest online node. Read
+// directly because stdio may allocate.
+static unsigned int numaNodes( void ) {
+	char buf[BufSize];
+	int fd = open( "/sys/devices/system/node/online", O_RDONLY );
+  if ( fd == -1 ) return 1;
+	ssize_t len = read( fd, buf, sizeof(buf) );
+	close( fd );
+	while ( len > 0 && (buf[len - 1] < '0' || '9' < buf[len - 1]) ) len -= 1; // remove newline
+	unsigned int highest = 0, scale = 1;
+	for ( ; len > 0 && '0' <= buf[len - 1] && buf[len - 1] <= '9'; len -= 1, scale *= 10 ) {
+		highest += (buf[len - 1] - '0') * scale;
+	} // for
+	return highest < MaxNumaNodes ? highest + 1 : (unsigned int)MaxNumaNodes;
+} // numaNodes
+#endif // __NUMA__
+
+// NUMA node of the CPU executing the calling thread.
+static inline unsigned int currentNode( void ) {
+	#ifdef __NUMA__
+	unsigned int cpu, node;
+	if ( heapMaster.numaNodes > 1 && syscall( SYS_getcpu, &cpu, &node, nullptr ) == 0 && node < MaxNumaNodes ) return node;
+	#endif // __NUMA__
+	return 0;
+} // currentNode
+
+// Prefer the pages of a new arena or slab page on the node of its heap. The pages are not yet touched, so the policy
+// takes effect on first touch by any thread. Failure is ignored, as the storage is usable on any node.
+static inline void bindNode( void * addr __attribute__(( unused )), size_t size __attribute__(( unused )), unsigned int node __attribute__(( unused )) ) {
+	#ifdef __NUMA__
+	if ( heapMaster.numaNodes > 1 ) {
+		unsigned long int mask = 1ul << node;
+		// syscall arguments are long, so widen the integer arguments
+		syscall( SYS_mbind, addr, size, (unsigned long int)MPOL_PREFERRED, &mask, (unsigned long int)MaxNumaNodes + 1, 0ul );
+	} // if
+	#endif // __NUMA__
+} // bindNode
+
+
+#ifdef __SAMPLE__
+enum { SampleFrames = 16, SampleSkip = 2, SampleSites = 4096, SampleTasks = 1024, SampleObjects = 65536, SampleNameLen = 32 };
+
+// Bytes to allocate before the next sample, drawn from an exponential distribution with mean sampleRate, so each byte
+// is equally likely to be sampled and an allocation of size bytes is sampled with probability 1 - exp(-size / rate).
+static ptrdiff_t sampleInterval( Heap * heap ) {
+  if ( heapMaster.sampleRate == 0 ) return PTRDIFF_MAX;	// never sample
+	heap->sampleSeed ^= heap->sampleSeed << 13;			// xorshift
+	heap->sampleSeed ^= heap->sampleSeed >> 7;
+	heap->sampleSeed ^= heap->sampleSeed << 17;
+	double q = ((heap->sampleSeed >> 11) + 1) * 0x1p-53;	// (0, 1]
+	return -log( q ) * heapMaster.sampleRate;			// at most 37 * sampleRate
+} // sampleInterval
+
+
+// A sample stands for the objects and bytes expected to be allocated per sample of its size, i.e., the sampled object
+// divided by its sampling probability. Estimates are accumulated by call site (stack trace) and by task, both for the
+// storage allocated since the program started and for the storage still live. A sampled object is marked in its
+// header, so free only looks up sampled objects. The tables have a fixed size and are mapped on the first sample, as
+// the profiler cannot allocate from the heap it is profiling; samples are dropped when a table is 3/4 full.
+struct SampleCounts {									// estimated objects and bytes
+	double liveObjs, liveBytes, allocObjs, allocBytes;
+}; // SampleCounts
+
+struct SampleSite {
+	unsigned int depth;									// frames in stack, 0 => empty entry
+	void * stack[SampleFrames];
+	SampleCounts counts;
+}; // SampleSite
+
+struct SampleTask {
+	uBaseTask * task;
+	char name[SampleNameLen];							// copied, as the task can be deleted before printing
+	bool used;											// false => empty entry
+	SampleCounts counts;
+}; // SampleTask
+
+struct SampleObject {									// live sampled object
+	Heap::Storage::Header * header;						// nullptr => empty entry
+	SampleSite * site;
+	SampleTask * task;
+	double objs, bytes;									// estimate represented by this sample
+}; // SampleObject
+
+struct SampleProfile {
+	uNoCtor<uSpinLock, false> lock;						// protects tables and counters
+	SampleSite * sites;									// nullptr => tables not mapped
+	SampleTask * tasks;
+	SampleObject * objects;
+	size_t noSites, noTasks, noObjects;					// used entries
+	unsigned long long int samples, dropped;
+}; // SampleProfile
+
+static SampleProfile sampleProfile;
+#endif // __SAMPLE__
+
+
 static void heapMasterCtor( void ) {
 	// Singleton pattern to initialize heap master
 
@@ -342,10 +532,33 @@ static void heapMasterCtor( void ) {
 	heapMaster.extLock.ctor();
 	heapMaster.mgrLock.ctor();
 
-	char * end = (char *)sbrk( 0 );
-	heapMaster.sbrkStart = heapMaster.sbrkEnd = sbrk( (char *)uCeiling( (long unsigned int)end, uAlign() ) - end ); // move start of heap to multiple of alignment
-	heapMaster.sbrkRemaining = 0;
-	heapMaster.sbrkExtend = malloc_extend();
+	heapMaster.hugePages = malloc_hugepage();
+	heapMaster.arenaAlign = heapMaster.hugePages ? (size_t)HugePageSize : heapMaster.pageSize;
+	heapMaster.arenaExtend = uCeiling( malloc_extend(), heapMaster.arenaAlign );
+	#ifdef __NUMA__
+	heapMaster.numaNodes = malloc_numa() ? numaNodes() : 1;
+	#else
+	heapMaster.numaNodes = 1;
+	#endif // __NUMA__
+	#ifdef __SAMPLE__
+	heapMaster.sampleRate = malloc_sample_rate();
+	sampleProfile.lock.ctor();
+	#endif // __SAMPLE__
+
+	// Reserve address space for the arenas. An inaccessible private mapping does not commit storage; storage is committed
+	// when an arena is given to a heap.
+	size_t reserve;
+	void * region = MAP_FAILED;
+	for ( reserve = __DEFAULT_HEAP_RESERVE__; reserve >= heapMaster.arenaExtend; reserve /= 2 ) {
+		region = mmap( 0, reserve + heapMaster.arenaAlign, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+	  if ( region != MAP_FAILED ) break;
+	} // for
+	if ( UNLIKELY( region == MAP_FAILED ) ) {
+		// Do not call strerror( errno ) as it may call malloc.
+		abort( "attempt to reserve address space for the heap and mmap failed with errno %d.", errno );
+	} // if
+	heapMaster.heapStart = heapMaster.heapEnd = (void *)uCeiling( (uintptr_t)region, heapMaster.arenaAlign );
+	heapMaster.heapRemaining = reserve;
 	heapMaster.mmapStart = malloc_mmap_start();
 
 	// find the closest bucket size less than or equal to the mmapStart size
@@ -355,6 +568,21 @@ static void heapMasterCtor( void ) {
 	assert( heapMaster.maxBucketsUsed < Heap::NoBucketSizes ); // subscript failure ?
 	assert( heapMaster.mmapStart <= bucketSizes[heapMaster.maxBucketsUsed] ); // search failure ?
 
+	#ifdef __SLAB__
+	// Reserve address space for slab pages, aligned on the slab page size. Failure is not an error, as small
+	// allocations then use buckets with headers.
+	heapMaster.slabStart = heapMaster.slabNext = nullptr;
+	heapMaster.slabSize = uCeiling( malloc_slab_region(), SlabPageSize );
+	if ( heapMaster.slabSize != 0 ) {
+		void * region = mmap( 0, heapMaster.slabSize + SlabPageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0 );
+		if ( region == MAP_FAILED ) {
+			heapMaster.slabSize = 0;					// no slabs
+		} else {
+			heapMaster.slabStart = heapMaster.slabNext = (char *)uCeiling( (uintptr_t)region, SlabPageSize );
+		} // if
+	} // if
+	#endif // __SLAB__
+
 	#if defined( __U_STATISTICS__ ) || defined( __U_DEBUG__ )
 	heapMaster.heapManagersList = nullptr;
 	#endif // __U_STATISTICS__ || __U_DEBUG__
@@ -368,7 +596,9 @@ static void heapMasterCtor( void ) {
 	heapMaster.nremainder = heapMaster.remainder = 0;
 	heapMaster.threads_started = heapMaster.threads_exited = 0;
 	heapMaster.reused_heap = heapMaster.new_heap = 0;
-	heapMaster.sbrk_calls = heapMaster.sbrk_storage = 0;
+	heapMaster.arena_calls = heapMaster.arena_storage = 0;
+	heapMaster.slab_pages = heapMaster.slab_storage = 0;
+	memset( heapMaster.nodeStats, '\0', sizeof(heapMaster.nodeStats) );
 	heapMaster.stats_fd = STDERR_FILENO;
 	#endif // __U_STATISTICS__
 
@@ -389,15 +619,19 @@ static void heapMasterCtor( void ) {
 
 #define NO_MEMORY_MSG "insufficient heap memory available to allocate %zd new bytes."
 
-static Heap * getHeap( void ) {
-	Heap * heap;
-	if ( heapMaster.freeHeapManagersList ) {			// free heap for reused ?
-		// pop heap from stack of free heaps for reusability
-		heap = heapMaster.freeHeapManagersList;
-		heapMaster.freeHeapManagersList = heap->nextFreeHeapManager;
+// A free heap is only reused on the node of its storage, otherwise a thread allocates remote memory for the life of the
+// heap. With one node, the first free heap is taken.
+static Heap * getHeap( unsigned int node ) {
+	Heap * heap, ** prev;
+	for ( prev = &heapMaster.freeHeapManagersList; *prev != nullptr && (*prev)->node != node; prev = &(*prev)->nextFreeHeapManager );
+	if ( *prev != nullptr ) {							// free heap on node for reuse ?
+		// remove heap from stack of free heaps for reusability
+		heap = *prev;
+		*prev = heap->nextFreeHeapManager;
 
 		#ifdef __U_STATISTICS__
 		heapMaster.reused_heap += 1;
+		heapMaster.nodeStats[node].reused_heap += 1;
 		#endif // __U_STATISTICS__
 	} else {											// free heap not found, create new
 		// Heap size is about 12K, FreeHeader (128 bytes because of cache alignment) * NoBucketSizes (91) => 128 heaps *
@@ -427,6 +661,7 @@ static Heap * getHeap( void ) {
 
 		#ifdef __U_STATISTICS__
 		heapMaster.new_heap += 1;
+		heapMaster.nodeStats[node].new_heap += 1;
 		#endif // __U_STATISTICS__
 
 		for ( unsigned int j = 0; j < Heap::NoBucketSizes; j += 1 ) { // initialize free lists
@@ -447,9 +682,35 @@ static Heap * getHeap( void ) {
 			#endif // __U_STATISTICS__
 		} // for
 
+		#ifdef __SLAB__
+		for ( unsigned int j = 0; j < Heap::NoSlabSizes; j += 1 ) { // initialize slab lists
+			#ifdef __OWNERSHIP__
+			#ifdef __REMOTESPIN__
+			heap->slabLists[j].remoteLock.ctor();
+			#endif // __REMOTESPIN__
+			heap->slabLists[j].remoteList = nullptr;
+			#endif // __OWNERSHIP__
+
+			heap->slabLists[j].freeList = nullptr;
+			heap->slabLists[j].homeManager = heap;
+			heap->slabLists[j].blockSize = (j + 1) * Heap::SlabStep; // no header
+			heap->slabLists[j].slabNext = heap->slabLists[j].slabEnd = nullptr;
+
+			#if defined( __U_STATISTICS__ )
+			heap->slabLists[j].allocations = 0;
+			heap->slabLists[j].reuses = 0;
+			#endif // __U_STATISTICS__
+		} // for
+		#endif // __SLAB__
+
 		heap->bufStart = nullptr;
 		heap->bufRemaining = 0;
 		heap->nextFreeHeapManager = nullptr;
+		heap->node = node;
+		#ifdef __SAMPLE__
+		heap->sampleSeed = (uintptr_t)heap | 1;			// non-zero, different for each heap
+		heap->sampleCountdown = sampleInterval( heap );
+		#endif // __SAMPLE__
 
 		uDEBUG( heap->allocUnfreed = 0; );
 	} // if
@@ -458,6 +719,22 @@ static Heap * getHeap( void ) {
 } // HeapMaster::getHeap
 
 
+static void putHeap( Heap * heap ) {					// pre: mgrLock acquired
+	// push heap onto stack of free heaps for reusability
+	heap->nextFreeHeapManager = heapMaster.freeHeapManagersList;
+	heapMaster.freeHeapManagersList = heap;
+
+	#ifdef __U_STATISTICS__
+	heapMaster.stats += heap->stats;					// retain this heap's statistics
+	HeapMaster::NodeStatistics & nodeStats = heapMaster.nodeStats[heap->node];
+	nodeStats.node_pushes += heap->stats.node_pushes;
+	nodeStats.node_storage_request += heap->stats.node_storage_request;
+	nodeStats.node_storage_alloc += heap->stats.node_storage_alloc;
+	HeapStatisticsCtor( heap->stats );					// reset heap counters for next usage
+	#endif // __U_STATISTICS__
+} // putHeap
+
+
 // Always called from uKernelModule::startThread.
 __attribute__(( visibility ("hidden") ))
 void heapManagerDtor( void ) {							// called by uKernelModule::startThread
@@ -465,13 +742,9 @@ void heapManagerDtor( void ) {							// called by uKernelModule::startThread
 
 	heapMaster.mgrLock->acquire_( true );				// protect heapMaster counters
 
-	// push heap onto stack of free heaps for reusability
-	heapManager->nextFreeHeapManager = heapMaster.freeHeapManagersList;
-	heapMaster.freeHeapManagersList = heapManager;
+	putHeap( heapManager );
 
 	#ifdef __U_STATISTICS__
-	heapMaster.stats += heapManager->stats;				// retain this heap's statistics
-	HeapStatisticsCtor( heapManager->stats );			// reset heap counters for next usage
 	heapMaster.threads_exited += 1;
 	#endif // __U_STATISTICS__
 
@@ -489,7 +762,7 @@ void heapManagerCtor( void ) {
 
 	// get storage for heap manager
 
-	heapManager = getHeap();
+	heapManager = getHeap( currentNode() );
 
 	#ifdef __U_STATISTICS__
 	HeapStatisticsCtor( heapManager->stats );			// heap local
@@ -500,6 +773,26 @@ void heapManagerCtor( void ) {
 } // heapManagerCtor
 
 
+// Called by the processor kernel after the processor's affinity is set. If the processor's kernel thread has moved to
+// another node, its heap is released and replaced by a heap on the new node, so later allocations use local memory.
+// Storage allocated from the released heap is returned to it when freed.
+__attribute__(( visibility ("hidden") ))
+void heapManagerRebind( void ) {
+  if ( heapMaster.numaNodes == 1 || heapManager == nullptr || heapManager == (Heap *)1 ) return;
+	unsigned int node = currentNode();
+  if ( node == heapManager->node ) return;			// same node ?
+
+	heapMaster.mgrLock->acquire_( true );				// protect heapMaster counters
+	putHeap( heapManager );
+	heapManager = getHeap( node );
+	#ifdef __U_STATISTICS__
+	HeapStatisticsCtor( heapManager->stats );			// heap local
+	heapMaster.nodeStats[node].rebinds += 1;
+	#endif // __U_STATISTICS__
+	heapMaster.mgrLock->release_( true );
+} // heapManagerRebind
+
+
 //####################### Memory Allocation Routines Helpers ####################
 
 
@@ -535,6 +828,17 @@ void UPP::uHeapControl::shutdown( void ) {				// singleton => called once at end
 				} // if
 			} // for
 			unused = write( STDERR_FILENO, "\n", 1 );	// file might be closed
+			#ifdef __SLAB__
+			for ( size_t b = 0, c = 0; b < Heap::NoSlabSizes; b += 1 ) {
+				if ( heap->slabLists[b].allocations != 0 ) {
+					total += heap->slabLists[b].blockSize * heap->slabLists[b].allocations;
+					len = snprintf( helpText, sizeof(helpText), "%sslab %'zd/%'zd/%'zd",
+									c++ == 0 ? "" : ", ", heap->slabLists[b].blockSize, heap->slabLists[b].allocations, heap->slabLists[b].reuses );
+					unused = write( STDERR_FILENO, helpText, len ); // file might be closed
+				} // if
+			} // for
+			unused = write( STDERR_FILENO, "\n", 1 );	// file might be closed
+			#endif // __SLAB__
 			#ifdef __U_DEBUG__
 			len = snprintf( helpText, sizeof(helpText), "allocUnfreed storage %'zd\n", heap->allocUnfreed );
 			unused = write( STDERR_FILENO, helpText, len ); // file might be closed
@@ -587,7 +891,8 @@ void UPP::uHeapControl::prepareTask( uBaseTask * /* task */ ) {
 	"            copies %'llu; smaller %'llu; alignment %'llu; 0 fill %'llu\n" \
 	"  free      !null calls %'llu; null/0 calls %'llu; storage %'llu/%'llu bytes\n" \
 	"  remote    pushes %'llu; pulls %'llu; storage %'llu/%'llu bytes\n" \
-	"  sbrk      calls %'llu; storage %'llu bytes\n" \
+	"  arena     calls %'llu; storage %'llu bytes\n" \
+	"  slab      pages %'llu; storage %'llu bytes\n" \
 	"  mmap      calls %'llu; storage %'llu/%'llu bytes\n" \
 	"  munmap    calls %'llu; storage %'llu/%'llu bytes\n" \
 	"  remainder calls %'llu; storage %'llu bytes\n" \
@@ -609,7 +914,8 @@ static int printStats( HeapStatistics & stats, const char * title = "" ) { // se
 		stats.realloc_copy, stats.realloc_smaller, stats.realloc_align, stats.realloc_0_fill,
 		stats.free_calls, stats.free_null_0_calls, stats.free_storage_request, stats.free_storage_alloc,
 		stats.remote_pushes, stats.remote_pulls, stats.remote_storage_request, stats.remote_storage_alloc,
-		heapMaster.sbrk_calls, heapMaster.sbrk_storage,
+		heapMaster.arena_calls, heapMaster.arena_storage,
+		heapMaster.slab_pages, heapMaster.slab_storage,
 		stats.mmap_calls, stats.mmap_storage_request, stats.mmap_storage_alloc,
 		stats.munmap_calls, stats.munmap_storage_request, stats.munmap_storage_alloc,
 		heapMaster.nremainder, heapMaster.remainder,
@@ -618,6 +924,35 @@ static int printStats( HeapStatistics & stats, const char * title = "" ) { // se
 	);
 } // printStats
 
+#define prtFmtNode \
+	"  node %-5u heaps new %'llu; reused %'llu; rebinds %'llu\n" \
+	"            arenas %'llu; slab pages %'llu; storage %'llu bytes\n" \
+	"            remote pushes %'llu; storage %'llu/%'llu bytes\n"
+
+// Remote pushes of active heaps are added to those of heaps retained by putHeap.
+static int printNodeStats( void ) {						// see malloc_stats
+	HeapMaster::NodeStatistics nodeStats[MaxNumaNodes];
+	heapMaster.mgrLock->acquire();
+	memcpy( nodeStats, heapMaster.nodeStats, sizeof(nodeStats) );
+	for ( Heap * heap = heapMaster.heapManagersList; heap; heap = heap->nextHeapManager ) {
+		nodeStats[heap->node].node_pushes += heap->stats.node_pushes;
+		nodeStats[heap->node].node_storage_request += heap->stats.node_storage_request;
+		nodeStats[heap->node].node_storage_alloc += heap->stats.node_storage_alloc;
+	} // for
+	heapMaster.mgrLock->release();
+
+	char helpText[sizeof(prtFmtNode) + 256];			// space for message and values
+	int len = 0;
+	for ( unsigned int n = 0; n < heapMaster.numaNodes; n += 1 ) {
+		len += uDebugPrtBuf2( heapMaster.stats_fd, helpText, sizeof(helpText), prtFmtNode, n,
+			nodeStats[n].new_heap, nodeStats[n].reused_heap, nodeStats[n].rebinds,
+			nodeStats[n].arena_calls, nodeStats[n].slab_pages, nodeStats[n].storage,
+			nodeStats[n].node_pushes, nodeStats[n].node_storage_request, nodeStats[n].node_storage_alloc
+		);
+	} // for
+	return len;
+} // printNodeStats
+
 #define prtFmtXML \
 	"<malloc version=\"1\">\n" \
 	"<heap nr=\"0\">\n" \
@@ -634,7 +969,8 @@ static int printStats( HeapStatistics & stats, const char * title = "" ) { // se
 	"<total type=\"       \" copy count=\"%'llu;\" smaller count=\"%'llu;\" size=\"%'llu/%'llu\"/> bytes\n" \
 	"<total type=\"free\" !null=\"%'llu;\" 0 null/0=\"%'llu;\" size=\"%'llu/%'llu\"/> bytes\n" \
 	"<total type=\"remote\" pushes=\"%'llu;\" 0 pulls=\"%'llu;\" size=\"%'llu/%'llu\"/> bytes\n" \
-	"<total type=\"sbrk\" count=\"%'llu;\" size=\"%'llu\"/> bytes\n" \
+	"<total type=\"arena\" count=\"%'llu;\" size=\"%'llu\"/> bytes\n" \
+	"<total type=\"slab\" count=\"%'llu;\" size=\"%'llu\"/> bytes\n" \
 	"<total type=\"mmap\" count=\"%'llu;\" size=\"%'llu/%'llu\"/> bytes\n" \
 	"<total type=\"munmap\" count=\"%'llu;\" size=\"%'llu/%'llu\"/> bytes\n" \
 	"<total type=\"remainder\" count=\"%'llu;\" size=\"%'llu\"/> bytes\n" \
@@ -656,7 +992,8 @@ static int printStatsXML( HeapStatistics & stats, FILE * stream ) { // see mallo
 		stats.realloc_copy, stats.realloc_smaller, stats.realloc_align, stats.realloc_0_fill,
 		stats.free_calls, stats.free_null_0_calls, stats.free_storage_request, stats.free_storage_alloc,
 		stats.remote_pushes, stats.remote_pulls, stats.remote_storage_request, stats.remote_storage_alloc,
-		heapMaster.sbrk_calls, heapMaster.sbrk_storage,
+		heapMaster.arena_calls, heapMaster.arena_storage,
+		heapMaster.slab_pages, heapMaster.slab_storage,
 		stats.mmap_calls, stats.mmap_storage_request, stats.mmap_storage_alloc,
 		stats.munmap_calls, stats.munmap_storage_request, stats.munmap_storage_alloc,
 		heapMaster.nremainder, heapMaster.remainder,
@@ -686,12 +1023,15 @@ static void clearStats( void ) {
 	for ( Heap * heap = heapMaster.heapManagersList; heap; heap = heap->nextHeapManager ) {
 		HeapStatisticsCtor( heap->stats );
 	} // for
+	for ( unsigned int n = 0; n < MaxNumaNodes; n += 1 ) {
+		heapMaster.nodeStats[n].node_pushes = heapMaster.nodeStats[n].node_storage_request = heapMaster.nodeStats[n].node_storage_alloc = 0;
+	} // for
 
 	heapMaster.mgrLock->release();
 } // clearStats
 #endif // __U_STATISTICS__
 
-static inline __attribute__((always_inline)) bool setMmapStart( size_t value ) { // true => mmapped, false => sbrk
+static inline __attribute__((always_inline)) bool setMmapStart( size_t value ) { // true => mmapped, false => arena
   if ( value < heapMaster.pageSize || bucketSizes[Heap::NoBucketSizes - 1] < value ) return false;
 	heapMaster.mmapStart = value;						// set global
 
@@ -733,7 +1073,7 @@ static inline __attribute__((always_inline)) void checkHeader( bool check, const
 	if ( UNLIKELY( check ) ) {							// bad address ?
 		abort( "attempt to %s storage %p with address outside the heap range %p<->%p.\n"
 			   "Possible cause is duplicate free on same block or overwriting of memory.",
-			   name, addr, heapMaster.sbrkStart, heapMaster.sbrkEnd );
+			   name, addr, heapMaster.heapStart, heapMaster.heapEnd );
 	} // if
 } // checkHeader
 
@@ -753,7 +1093,8 @@ static inline __attribute__((always_inline)) bool headers( const char name[] __a
 					 Heap::FreeHeader *& freeHead, size_t & size, size_t & alignment ) {
 	header = HeaderAddr( addr );
 
-	uDEBUG( if ( LIKELY( ! MmappedBit( header ) ) ) checkHeader( header < heapMaster.sbrkStart, name, addr ); ); // bad low address ?
+	// Mapped storage can be below the arenas, and a fake header may have any alignment bits, so only check a plain header.
+	uDEBUG( if ( LIKELY( ! StickyBits( header ) ) ) checkHeader( header < heapMaster.heapStart, name, addr ); ); // bad low address ?
 
 	if ( LIKELY( ! StickyBits( header ) ) ) {			// no sticky bits ?
 		freeHead = header->kind.real.home;
@@ -761,7 +1102,7 @@ static inline __attribute__((always_inline)) bool headers( const char name[] __a
 	} else {
 		fakeHeader( header, alignment );
 		if ( UNLIKELY( MmappedBit( header ) ) ) {		// mapped storage ?
-			assert( addr < heapMaster.sbrkStart || heapMaster.sbrkEnd < addr );
+			assert( addr < heapMaster.heapStart || heapMaster.heapEnd < addr );
 			size = ClearStickyBits( header->kind.real.blockSize ); // mmap size
 			freeHead = nullptr;							// prevent uninitialized warning
 			return true;
@@ -772,7 +1113,7 @@ static inline __attribute__((always_inline)) bool headers( const char name[] __a
 	size = freeHead->blockSize;
 
 	#ifdef __U_DEBUG__
-	checkHeader( header < heapMaster.sbrkStart || heapMaster.sbrkEnd < header, name, addr ); // bad address ? (offset could be + or -)
+	checkHeader( header < heapMaster.heapStart || heapMaster.heapEnd < header, name, addr ); // bad address ? (offset could be + or -)
 
 	Heap * homeManager;
 	if ( UNLIKELY( freeHead == nullptr || // freed and only free-list node => null link
@@ -789,36 +1130,256 @@ static inline __attribute__((always_inline)) bool headers( const char name[] __a
 } // headers
 
 
-static inline __attribute__((always_inline)) void * master_extend( size_t size ) {
+#ifdef __SLAB__
+static inline __attribute__((always_inline)) bool slabObject( void * addr ) {
+	// Addresses below the reserve wrap to large unsigned values, so one comparison checks both ends.
+	return (uintptr_t)addr - (uintptr_t)heapMaster.slabStart < heapMaster.slabSize;
+} // slabObject
+
+
+static inline __attribute__((always_inline)) Heap::FreeHeader * slabHome( const char name[] __attribute__(( unused )), void * addr ) {
+	SlabPage * page = SlabPageAddr( addr );
+	Heap::FreeHeader * freeHead = page->home;
+
+	#ifdef __U_DEBUG__
+	if ( UNLIKELY( (char *)addr >= heapMaster.slabNext || (char *)addr < (char *)page + SlabPageHeader ||
+				   ((char *)addr - ((char *)page + SlabPageHeader)) % freeHead->blockSize != 0 ) ) {
+		abort( "attempt to %s storage %p that is not the start of a small allocation.\n"
+			   "Possible cause is an address inside an allocation or overwriting of memory.",
+			   name, addr );
+	} // if
+	#endif // __U_DEBUG__
+
+	return freeHead;
+} // slabHome
+
+
+// Carve a new slab page for a slab bucket and return the first object, or nullptr when the slab reserve is exhausted.
+static inline __attribute__((always_inline)) Heap::Storage * slab_extend( Heap::FreeHeader * freeHead ) {
+	char * end = heapMaster.slabStart + heapMaster.slabSize;
+  if ( UNLIKELY( heapMaster.slabNext == end ) ) return nullptr; // no slabs or reserve exhausted ?
+
 	heapMaster.extLock->acquire_( true );
+	char * page = heapMaster.slabNext;
+	if ( UNLIKELY( page == end ) ) { heapMaster.extLock->release_( true ); return nullptr; } // lost race for last page
+	heapMaster.slabNext = page + SlabPageSize;
 
-	ptrdiff_t rem = heapMaster.sbrkRemaining - size;
-	if ( UNLIKELY( rem < 0 ) ) {						// negative ?
-		// If the size requested is bigger than the current remaining storage, increase the size of the heap.
-		size_t increase = uCeiling( size > heapMaster.sbrkExtend ? size : heapMaster.sbrkExtend, uAlign() );
-		if ( UNLIKELY( sbrk( increase ) == (void *)-1 ) ) { heapMaster.extLock->release_( true ); return nullptr; } // failed, no memory, errnor == ENOMEM
-		rem = heapMaster.sbrkRemaining + increase - size;
+	unsigned int node = freeHead->homeManager->node;
+	#ifdef __U_STATISTICS__
+	heapMaster.slab_pages += 1;
+	heapMaster.slab_storage += SlabPageSize;
+	heapMaster.nodeStats[node].slab_pages += 1;
+	heapMaster.nodeStats[node].storage += SlabPageSize;
+	#endif // __U_STATISTICS__
 
-		#ifdef __U_STATISTICS__
-		heapMaster.sbrk_calls += 1;
-		heapMaster.sbrk_storage += increase;
-		#endif // __U_STATISTICS__
+	heapMaster.extLock->release_( true );
+
+	bindNode( page, SlabPageSize, node );				// before first touch
+	((SlabPage *)page)->home = freeHead;
+	char * first = page + SlabPageHeader;
+	freeHead->slabNext = first + freeHead->blockSize;
+	freeHead->slabEnd = first + (SlabPageSize - SlabPageHeader) / freeHead->blockSize * freeHead->blockSize;
+	return (Heap::Storage *)first;
+} // slab_extend
+#endif // __SLAB__
+
+
+#ifdef __SAMPLE__
+static inline size_t samplePtrHash( const void * p ) {
+	return ((uintptr_t)p >> 4) * 0x9e3779b97f4a7c15;
+} // samplePtrHash
+
+static SampleSite * sampleSite( void * stack[], unsigned int depth ) { // pre: lock acquired
+	size_t h = depth;
+	for ( unsigned int i = 0; i < depth; i += 1 ) h = (h ^ (uintptr_t)stack[i]) * 0x100000001b3; // FNV
+	for ( size_t i = h & (SampleSites - 1);; i = (i + 1) & (SampleSites - 1) ) {
+		SampleSite & site = sampleProfile.sites[i];
+		if ( site.depth == 0 ) {						// new site ?
+		  if ( sampleProfile.noSites >= SampleSites / 4 * 3 ) return nullptr; // table full ?
+			sampleProfile.noSites += 1;
+			site.depth = depth;
+			memcpy( site.stack, stack, depth * sizeof(stack[0]) );
+			return &site;
+		} // if
+		if ( site.depth == depth && memcmp( site.stack, stack, depth * sizeof(stack[0]) ) == 0 ) return &site;
+	} // for
+} // sampleSite
+
+static SampleTask * sampleTask( uBaseTask * task, const char * name ) { // pre: lock acquired
+	for ( size_t i = samplePtrHash( task ) & (SampleTasks - 1);; i = (i + 1) & (SampleTasks - 1) ) {
+		SampleTask & entry = sampleProfile.tasks[i];
+		if ( ! entry.used ) {							// new task ?
+		  if ( sampleProfile.noTasks >= SampleTasks / 4 * 3 ) return nullptr; // table full ?
+			sampleProfile.noTasks += 1;
+			entry.used = true;
+			entry.task = task;
+			strncpy( entry.name, name, SampleNameLen - 1 );
+			return &entry;
+		} // if
+		// A deleted task's address can be reused by a new task, which usually has a different name.
+		if ( entry.task == task && strncmp( entry.name, name, SampleNameLen - 1 ) == 0 ) return &entry;
+	} // for
+} // sampleTask
+
+static inline void sampleAdd( SampleCounts & counts, double objs, double bytes ) {
+	counts.liveObjs += objs;
+	counts.liveBytes += bytes;
+	counts.allocObjs += objs;
+	counts.allocBytes += bytes;
+} // sampleAdd
+
+static inline void sampleSub( SampleCounts & counts, double objs, double bytes ) {
+	counts.liveObjs -= objs;
+	counts.liveBytes -= bytes;
+} // sampleSub
+
+// Called at the end of doMalloc, after the heap is no longer accessed, as the stack trace is taken with interrupts
+// enabled and may allocate.
+__attribute__(( noinline ))
+static void sampleAlloc( Heap::Storage::Header * header, size_t size ) {
+	void * stack[SampleFrames + SampleSkip];
+	int depth = backtrace( stack, SampleFrames + SampleSkip ) - SampleSkip; // skip sampleAlloc and doMalloc
+	uBaseTask * task = UPP::uHeapControl::activeTask();
+	const char * name = task != nullptr && task->getName() != nullptr ? task->getName() : "*kernel*";
+	// Inverse of the sampling probability. Large sizes are always sampled, and exp must not underflow as floating-point
+	// exceptions may be enabled.
+	double ratio = (double)size / heapMaster.sampleRate;
+	double objs = ratio < 32 ? 1.0 / -expm1( -ratio ) : 1.0;
+	double bytes = size * objs;
+
+	sampleProfile.lock->acquire_( true );
+	sampleProfile.samples += 1;
+	if ( UNLIKELY( sampleProfile.sites == nullptr ) ) {	// first sample ?
+		size_t tablesSize = sizeof(SampleSite) * SampleSites + sizeof(SampleTask) * SampleTasks + sizeof(SampleObject) * SampleObjects;
+		char * tables = (char *)mmap( 0, tablesSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0 );
+		if ( tables != MAP_FAILED ) {					// zero filled => empty entries
+			sampleProfile.sites = (SampleSite *)tables;
+			sampleProfile.tasks = (SampleTask *)(tables + sizeof(SampleSite) * SampleSites);
+			sampleProfile.objects = (SampleObject *)(tables + sizeof(SampleSite) * SampleSites + sizeof(SampleTask) * SampleTasks);
+		} // if
+	} // if
+
+	SampleSite * site;
+	if ( sampleProfile.sites == nullptr || depth <= 0 || sampleProfile.noObjects >= SampleObjects / 4 * 3 ||
+		 (site = sampleSite( &stack[SampleSkip], depth )) == nullptr ) {
+		sampleProfile.dropped += 1;
+		ClearSampledBit( header );						// free does not look it up
+		sampleProfile.lock->release_( true );
+		return;
+	} // if
+	SampleTask * entry = sampleTask( task, name );		// nullptr => counted by site only
+
+	sampleAdd( site->counts, objs, bytes );
+	if ( entry != nullptr ) sampleAdd( entry->counts, objs, bytes );
+
+	size_t i;
+	for ( i = samplePtrHash( header ) & (SampleObjects - 1); sampleProfile.objects[i].header != nullptr; i = (i + 1) & (SampleObjects - 1) );
+	sampleProfile.objects[i] = { header, site, entry, objs, bytes };
+	sampleProfile.noObjects += 1;
+	sampleProfile.lock->release_( true );
+} // sampleAlloc
+
+// Called by doFree with interrupts disabled, before the storage can be reallocated and sampled again.
+static void sampleFree( Heap::Storage::Header * header ) {
+	sampleProfile.lock->acquire_( true );
+	SampleObject * objects = sampleProfile.objects;
+	size_t i;
+	for ( i = samplePtrHash( header ) & (SampleObjects - 1); objects[i].header != header; i = (i + 1) & (SampleObjects - 1) ) {
+		assert( objects[i].header != nullptr );			// sampled object must be in table
+	} // for
+
+	sampleSub( objects[i].site->counts, objects[i].objs, objects[i].bytes );
+	if ( objects[i].task != nullptr ) sampleSub( objects[i].task->counts, objects[i].objs, objects[i].bytes );
+	sampleProfile.noObjects -= 1;
+
+	// Remove by moving back later entries of the probe sequence, so no deleted markers are needed.
+	for ( size_t j = i;; ) {
+		j = (j + 1) & (SampleObjects - 1);
+	  if ( objects[j].header == nullptr ) break;
+		size_t k = samplePtrHash( objects[j].header ) & (SampleObjects - 1);
+	  if ( i <= j ? (i < k && k <= j) : (i < k || k <= j) ) continue; // home between hole and entry => stays
+		objects[i] = objects[j];
+		i = j;
+	} // for
+	objects[i].header = nullptr;
+	sampleProfile.lock->release_( true );
+} // sampleFree
+
+#define prtFmtProfile \
+	"\nPID: %d Heap profile: sample rate %zu bytes; samples %'llu; dropped %'llu (estimated objects/bytes)\n"
+#define prtFmtProfileTask "  task %-31s (%p) live %'llu/%'llu; allocated %'llu/%'llu\n"
+#define prtFmtProfileSite "  site live %'llu/%'llu; allocated %'llu/%'llu\n"
+
+static inline unsigned long long int sampleRound( double estimate ) {
+	return estimate < 0.5 ? 0 : estimate + 0.5;			// live estimates can be slightly negative from rounding
+} // sampleRound
+
+// Use "write" because streams may be shutdown when calls are made.
+static int printProfile( int fd ) {						// see malloc_profile
+	char helpText[sizeof(prtFmtProfileTask) + SampleNameLen + 128]; // space for message and values
+	sampleProfile.lock->acquire();
+	int len = uDebugPrtBuf2( fd, helpText, sizeof(helpText), prtFmtProfile, getpid(), heapMaster.sampleRate,
+							 sampleProfile.samples, sampleProfile.dropped );
+	for ( size_t i = 0; sampleProfile.tasks != nullptr && i < SampleTasks; i += 1 ) {
+		SampleTask & entry = sampleProfile.tasks[i];
+	  if ( ! entry.used ) continue;
+		len += uDebugPrtBuf2( fd, helpText, sizeof(helpText), prtFmtProfileTask, entry.name, entry.task,
+							  sampleRound( entry.counts.liveObjs ), sampleRound( entry.counts.liveBytes ),
+							  sampleRound( entry.counts.allocObjs ), sampleRound( entry.counts.allocBytes ) );
+	} // for
+	for ( size_t i = 0; sampleProfile.sites != nullptr && i < SampleSites; i += 1 ) {
+		SampleSite & site = sampleProfile.sites[i];
+	  if ( site.depth == 0 ) continue;
+		len += uDebugPrtBuf2( fd, helpText, sizeof(helpText), prtFmtProfileSite,
+							  sampleRound( site.counts.liveObjs ), sampleRound( site.counts.liveBytes ),
+							  sampleRound( site.counts.allocObjs ), sampleRound( site.counts.allocBytes ) );
+		backtrace_symbols_fd( site.stack, site.depth, fd ); // no allocation
+	} // for
+	sampleProfile.lock->release();
+	return len;
+} // printProfile
+#endif // __SAMPLE__
+
+
+// Give the calling heap a new arena from the reserve. Each heap allocates from its own arenas, so storage of different
+// heaps is not interleaved, and the lock is only acquired once per arena.
+static inline __attribute__((always_inline)) void * master_extend( size_t size, unsigned int node ) {
+	heapMaster.extLock->acquire_( true );
+
+	if ( UNLIKELY( size > heapMaster.heapRemaining ) ) { // reserve exhausted ?
+		heapMaster.extLock->release_( true );
+		errno = ENOMEM;
+		return nullptr;
 	} // if
 
-	void * newblock = (Heap::Storage *)heapMaster.sbrkEnd;
-	heapMaster.sbrkRemaining = rem;
-	heapMaster.sbrkEnd = (char *)heapMaster.sbrkEnd + size;
+	void * newblock = heapMaster.heapEnd;
+	heapMaster.heapRemaining -= size;
+	heapMaster.heapEnd = (char *)heapMaster.heapEnd + size;
+
+	#ifdef __U_STATISTICS__
+	heapMaster.arena_calls += 1;
+	heapMaster.arena_storage += size;
+	heapMaster.nodeStats[node].arena_calls += 1;
+	heapMaster.nodeStats[node].storage += size;
+	#endif // __U_STATISTICS__
 
 	heapMaster.extLock->release_( true );
+
+	// Commit storage outside the lock. On failure, the arena is left in the reserve as inaccessible address space.
+	if ( UNLIKELY( mprotect( newblock, size, PROT_READ | PROT_WRITE ) == -1 ) ) return nullptr; // errno == ENOMEM
+	#ifdef MADV_HUGEPAGE
+	if ( heapMaster.hugePages ) madvise( newblock, size, MADV_HUGEPAGE ); // failure => normal pages
+	#endif // MADV_HUGEPAGE
+	bindNode( newblock, size, node );
 	return newblock;
 } // master_extend
 
 
 __attribute__(( noinline ))
 static void * manager_extend( size_t size ) {
-	// If the size requested is bigger than the current remaining reserve, so increase the reserve.
-	size_t increase = uCeiling( size > ( heapMaster.sbrkExtend / 16 ) ? size : ( heapMaster.sbrkExtend / 16 ), uAlign() );
-	void * newblock = master_extend( increase );
+	// If the size requested is bigger than the current remaining arena, get a new arena.
+	size_t increase = uCeiling( size > heapMaster.arenaExtend ? size : heapMaster.arenaExtend, heapMaster.arenaAlign );
+	void * newblock = master_extend( increase, heapManager->node );
 	if ( UNLIKELY( newblock == nullptr ) ) return nullptr;
 
 	// Check if the new reserve block is contiguous with the old block (The only good storage is contiguous storage!)
@@ -884,7 +1445,7 @@ static void * manager_extend( size_t size ) {
 #define SCRUB_SIZE 1024lu								// scrub size, front/back/all of allocation area
 
 __attribute__(( noinline, noclone, section( "text_nopreempt" ) ))
-static void * doMalloc( size_t size STAT_PARM ) {
+static void * doMalloc( size_t size STAT_PARM, bool header ) { // header => allocation needs a header for sticky properties
 	BOOT_HEAP_MANAGER();
 
 	#ifdef __NULL_0_ALLOC__
@@ -921,7 +1482,90 @@ static void * doMalloc( size_t size STAT_PARM ) {
 
 	uDEBUG( heap->allocUnfreed += size; );
 
-	if ( LIKELY( size < heapMaster.mmapStart ) ) {		// small size => sbrk
+	#ifdef __SAMPLE__
+	bool sample = false;
+	if ( UNLIKELY( (heap->sampleCountdown -= size) < 0 ) ) { // sample ?
+		// The countdown and seed belong to this heap, so a preemption that moves the task must not split their update.
+		// The sample is recorded by sampleAlloc at the end of doMalloc, after interrupts are enabled.
+		uKernelModule::uKernelModuleData::disableInterrupts();
+		heap->sampleCountdown = sampleInterval( heap );
+		uKernelModule::uKernelModuleData::enableInterruptsNoRF();
+		sample = heapMaster.sampleRate != 0;
+		header = header || sample;					// sampled object is marked in its header
+	} // if
+	#endif // __SAMPLE__
+
+	#ifdef __SLAB__
+	if ( LIKELY( size <= SlabMaxSize && ! header ) ) {	// headerless ?
+		Heap::FreeHeader * freeHead = &heap->slabLists[SlabIndex( size )];
+
+		block = freeHead->freeList;						// remove node from stack
+		if ( LIKELY( block != nullptr ) ) {				// free object ?
+			freeHead->freeList = block->header.kind.real.next;
+
+			#ifdef __U_STATISTICS__
+			freeHead->reuses += 1;
+			#endif // __U_STATISTICS__
+		} else {
+			if ( LIKELY( freeHead->slabNext != freeHead->slabEnd ) ) { // bump storage in slab page ?
+				block = (Heap::Storage *)freeHead->slabNext;
+				freeHead->slabNext += freeHead->blockSize;
+				uDEBUG( memset( block, SCRUB, freeHead->blockSize ); );
+			#ifdef __OWNERSHIP__
+			} else if ( UNLIKELY( freeHead->remoteList ) ) { // returned space ?
+				#ifdef __REMOTESPIN__
+				freeHead->remoteLock->acquire_( true );
+				block = freeHead->remoteList;
+				freeHead->remoteList = nullptr;
+				freeHead->remoteLock->release_( true );
+				#else
+				block = uFetchAssign( freeHead->remoteList, (decltype(freeHead->remoteList))nullptr ); // must be same type
+				#endif // __REMOTESPIN__
+
+				assert( block );
+				#ifdef __U_STATISTICS__
+				heap->stats.remote_pulls += 1;
+				#endif // __U_STATISTICS__
+
+				freeHead->freeList = block->header.kind.real.next; // merge remoteList into freeHead
+			#endif // __OWNERSHIP__
+			} else {
+				// Get storage from a *new* slab page.
+				uKernelModule::uKernelModuleData::disableInterrupts();
+				block = slab_extend( freeHead );		// mutual exclusion on call
+				uKernelModule::uKernelModuleData::enableInterruptsNoRF();
+				uDEBUG( if ( block ) memset( block, SCRUB, freeHead->blockSize ); );
+			} // if
+
+			#ifdef __U_STATISTICS__
+			if ( LIKELY( block != nullptr ) ) freeHead->allocations += 1;
+			#endif // __U_STATISTICS__
+		} // if
+
+		if ( LIKELY( block != nullptr ) ) {
+			#ifdef __U_STATISTICS__
+			heap->stats.counters[STAT_NAME].alloc += freeHead->blockSize;
+			#endif // __U_STATISTICS__
+
+			// There is no header to remember the request size, so free subtracts the bucket size.
+			uDEBUG( heap->allocUnfreed += freeHead->blockSize - size; );
+
+			#ifdef __U_DEBUG__
+			if ( UPP::uHeapControl::traceHeap() ) {
+				enum { BufferSize = 64 };
+				char helpText[BufferSize];
+				int len = snprintf( helpText, BufferSize, "%p = Malloc( %zu ) (allocated %zu)\n", block, size, freeHead->blockSize );
+				uDebugWrite( STDERR_FILENO, helpText, len ); // print debug/nodebug
+			} // if
+			#endif // __U_DEBUG__
+
+			return block;
+		} // if
+		// slab reserve exhausted => allocate with header
+	} // if
+	#endif // __SLAB__
+
+	if ( LIKELY( size < heapMaster.mmapStart ) ) {		// small size => arena
 		Heap::FreeHeader * freeHead =
 			#ifdef __FASTLOOKUP__
 			LIKELY( tsize < LookupSizes ) ? &(heap->freeLists[lookup[tsize]]) :
@@ -983,6 +1627,7 @@ static void * doMalloc( size_t size STAT_PARM ) {
 				uKernelModule::uKernelModuleData::disableInterrupts();
 				block = (Heap::Storage *)manager_extend( tsize ); // mutual exclusion on call
 				uKernelModule::uKernelModuleData::enableInterruptsNoRF();
+			  if ( UNLIKELY( block == nullptr ) ) return nullptr; // no memory, errno == ENOMEM
 
 				// OK TO BE PREEMPTED HERE AS heapManager IS NO LONGER ACCESSED.
 
@@ -1046,6 +1691,14 @@ static void * doMalloc( size_t size STAT_PARM ) {
 	} // if
 	#endif // __U_DEBUG__
 
+	#ifdef __SAMPLE__
+	if ( UNLIKELY( sample ) ) {
+		MarkSampledBit( &block->header );
+		// OK TO BE PREEMPTED HERE AS heapManager IS NO LONGER ACCESSED.
+		sampleAlloc( &block->header, size );
+	} // if
+	#endif // __SAMPLE__
+
 	return addr;
 } // doMalloc
 
@@ -1070,11 +1723,38 @@ static void doFree( void * addr ) {
 	Heap::Storage::Header * header;
 	Heap::FreeHeader * freeHead;
 	size_t tsize, alignment;
-
-	bool mapped = headers( "free", addr, header, freeHead, tsize, alignment );
+	bool mapped;
 	#if defined( __U_STATISTICS__ ) || defined( __U_DEBUG__ )
-	size_t size = header->kind.real.size;				// optimization
+	size_t size;
 	#endif // __U_STATISTICS__ || __U_DEBUG__
+	uDEBUG( size_t hsize = sizeof(Heap::Storage); );	// header size
+
+	#ifdef __SLAB__
+	if ( LIKELY( slabObject( addr ) ) ) {				// headerless ?
+		freeHead = slabHome( "free", addr );
+		header = (Heap::Storage::Header *)addr;			// object is its own free-list node
+		tsize = freeHead->blockSize;
+		mapped = false;
+		#if defined( __U_STATISTICS__ ) || defined( __U_DEBUG__ )
+		size = tsize;									// request size unknown, see doMalloc
+		#endif // __U_STATISTICS__ || __U_DEBUG__
+		uDEBUG( hsize = 0; );
+	} else
+	#endif // __SLAB__
+	{
+		mapped = headers( "free", addr, header, freeHead, tsize, alignment );
+		#if defined( __U_STATISTICS__ ) || defined( __U_DEBUG__ )
+		size = header->kind.real.size;					// optimization
+		#endif // __U_STATISTICS__ || __U_DEBUG__
+
+		#ifdef __SAMPLE__
+		if ( UNLIKELY( SampledBit( header ) ) ) {		// sampled by heap profiler ?
+			uKernelModule::uKernelModuleData::disableInterrupts();
+			sampleFree( header );
+			uKernelModule::uKernelModuleData::enableInterruptsNoRF();
+		} // if
+		#endif // __SAMPLE__
+	} // if
 
 	#ifdef __U_STATISTICS__
 	#ifndef __NULL_0_ALLOC__
@@ -1089,14 +1769,14 @@ static void doFree( void * addr ) {
 
 	uDEBUG( heap->allocUnfreed -= size; );
 
-	if ( LIKELY( ! mapped ) ) {							// sbrk ?
+	if ( LIKELY( ! mapped ) ) {							// arena ?
 		assert( freeHead );
 		#ifdef __U_DEBUG__
 		// memset is NOT always inlined!
 		uKernelModule::uKernelModuleData::disableInterrupts();
 		// Scrub old memory so subsequent usages might fail. Only scrub the first/last SCRUB_SIZE bytes.
-		char * data = ((Heap::Storage *)header)->data;	// data address
-		size_t dsize = tsize - sizeof(Heap::Storage);	// data size
+		char * data = (char *)header + hsize;			// data address
+		size_t dsize = tsize - hsize;					// data size
 		if ( dsize <= SCRUB_SIZE * 2 ) {
 			memset( data, SCRUB, dsize );				// scrub all
 		} else {
@@ -1126,6 +1806,11 @@ static void doFree( void * addr ) {
 			heap->stats.remote_pushes += 1;
 			heap->stats.remote_storage_request += size;
 			heap->stats.remote_storage_alloc += tsize;
+			if ( heap->node != freeHead->homeManager->node ) { // storage on another node ?
+				heap->stats.node_pushes += 1;
+				heap->stats.node_storage_request += size;
+				heap->stats.node_storage_alloc += tsize;
+			} // if
 			#endif // __U_STATISTICS__
 		} // if
 
@@ -1134,7 +1819,12 @@ static void doFree( void * addr ) {
 		assert( heap );
 
 		// kind.real.home is address in owner thread's freeLists, so compute the equivalent position in this thread's freeList.
-		freeHead = &heap->freeLists[ClearStickyBits( header->kind.real.home ) - &freeHead->homeManager->freeLists[0]];
+		#ifdef __SLAB__
+		if ( (char *)header == (char *)addr ) {			// headerless ?
+			freeHead = &heap->slabLists[freeHead - &freeHead->homeManager->slabLists[0]];
+		} else
+		#endif // __SLAB__
+			freeHead = &heap->freeLists[ClearStickyBits( header->kind.real.home ) - &freeHead->homeManager->freeLists[0]];
 		header->kind.real.next = freeHead->freeList;	// push on stack
 		freeHead->freeList = (Heap::Storage *)header;
 		#endif // __OWNERSHIP__
@@ -1165,6 +1855,72 @@ static void doFree( void * addr ) {
 } // doFree
 
 
+// Sized deallocation from C++ delete or free_sized. The request size gives the bucket the storage came from, so a
+// local object with no sticky bits is found by comparing its home bucket with the bucket for the size, without decoding
+// the header or loading the bucket's owner. Any mismatch, including a wrong size, is handled by doFree.
+__attribute__(( noinline, noclone, section( "text_nopreempt" ) ))
+static void doFreeSized( void * addr, size_t size ) {
+	#if defined( __U_DEBUG__ ) || ! defined( __OWNERSHIP__ )
+	#ifdef __U_DEBUG__
+	// C++ delete passes 0 for new( 0 ), which is malloc( 1 ).
+	if ( UNLIKELY( size > malloc_usable_size( addr ) ) ) {
+		abort( "attempt to free storage %p with size %zu larger than its allocation %zu.\n"
+			   "Possible cause is a delete of a base pointer with a non-virtual destructor or a wrong size to free_sized.",
+			   addr, size, malloc_usable_size( addr ) );
+	} // if
+	#endif // __U_DEBUG__
+	doFree( addr );										// scrubbing and debug checks
+	#else
+	Heap * heap = heapManager;							// optimization, as heapManager is thread_local
+	if ( UNLIKELY( heap == nullptr ) ) { doFree( addr ); return; } // thread_local deallocation after heap released ?
+	Heap::FreeHeader * freeHead;
+	Heap::Storage * block;
+
+	#ifdef __SLAB__
+	if ( LIKELY( slabObject( addr ) ) ) {				// headerless ?
+	  if ( UNLIKELY( size > SlabMaxSize ) ) { doFree( addr ); return; } // wrong size => checked by doFree
+		freeHead = &heap->slabLists[SlabIndex( size )];
+	  if ( UNLIKELY( SlabPageAddr( addr )->home != freeHead ) ) { doFree( addr ); return; } // remote ?
+		block = (Heap::Storage *)addr;					// object is its own free-list node
+		#ifdef __U_STATISTICS__
+		size = freeHead->blockSize;						// request size unknown, see doFree
+		#endif // __U_STATISTICS__
+	} else
+	#endif // __SLAB__
+	{
+		size_t tsize = size + sizeof(Heap::Storage);	// bucket search as in doMalloc
+		#ifdef __FASTLOOKUP__
+	  if ( UNLIKELY( tsize >= LookupSizes ) ) { doFree( addr ); return; } // large or mmapped ?
+		freeHead = &heap->freeLists[lookup[tsize]];
+		#else
+	  if ( UNLIKELY( size >= heapMaster.mmapStart ) ) { doFree( addr ); return; } // mmapped ?
+		freeHead = &heap->freeLists[Bsearchl( tsize, bucketSizes, heapMaster.maxBucketsUsed )];
+		#endif // __FASTLOOKUP__
+		block = (Heap::Storage *)HeaderAddr( addr );
+		// Sticky bits, including sampled, and remote ownership make the home differ from the local bucket.
+	  if ( UNLIKELY( block->header.kind.real.home != freeHead ) ) { doFree( addr ); return; }
+		#ifdef __U_STATISTICS__
+		size = block->header.kind.real.size;			// request size from malloc, which may differ
+		#endif // __U_STATISTICS__
+	} // if
+
+	#ifdef __U_STATISTICS__
+	#ifndef __NULL_0_ALLOC__
+	if ( UNLIKELY( size == 0 ) )						// malloc( 0 ) ?
+		heap->stats.free_null_0_calls += 1;
+	else
+	#endif // __NULL_0_ALLOC__
+		heap->stats.free_calls += 1;
+	heap->stats.free_storage_request += size;
+	heap->stats.free_storage_alloc += freeHead->blockSize;
+	#endif // __U_STATISTICS__
+
+	block->header.kind.real.next = freeHead->freeList; // push on stack
+	freeHead->freeList = block;
+	#endif // __U_DEBUG__ || ! __OWNERSHIP__
+} // doFreeSized
+
+
 // A preemption can change heapManager so statistic updates are associated with the wrong heap. However, all the heap
 // statistics are normally aggregated (see malloc_stats), so data in the wrong heap is always counted. Only, for
 // heap_stats can potential incorrect statistics be seen, but calling heap_stats is unusual.
@@ -1189,11 +1945,11 @@ static void doFree( void * addr ) {
 // #endif // __U_DEBUG__
 
 
-static inline __attribute__((always_inline)) void * memalignNoStats( size_t alignment, size_t size STAT_PARM ) {
+static inline __attribute__((always_inline)) void * memalignNoStats( size_t alignment, size_t size STAT_PARM, bool header ) {
 	checkAlign( alignment );							// check alignment
 
 	// if alignment <= default alignment or size == 0, do normal malloc as two headers are unnecessary
-  if ( UNLIKELY( alignment <= uAlign() || size == 0 ) ) return doMalloc( size STAT_ARG( STAT_NAME ) );
+  if ( UNLIKELY( alignment <= uAlign() || size == 0 ) ) return doMalloc( size STAT_ARG( STAT_NAME ), header );
 
 	// Allocate enough storage to guarantee an address on the alignment boundary, and sufficient space before it for
 	// administrative storage. NOTE, WHILE THERE ARE 2 HEADERS, THE FIRST ONE IS IMPLICITLY CREATED BY DOMALLOC.
@@ -1205,7 +1961,7 @@ static inline __attribute__((always_inline)) void * memalignNoStats( size_t alig
 	// subtract uAlign() because it is already the minimum alignment
 	// add sizeof(Heap::Storage) for fake header
 	size_t offset = alignment - uAlign() + sizeof(Heap::Storage);
-	char * addr = (char *)doMalloc( size + offset STAT_ARG( STAT_NAME ) );
+	char * addr = (char *)doMalloc( size + offset STAT_ARG( STAT_NAME ), true ); // real header precedes fake header
 
   if ( UNLIKELY( addr == nullptr ) ) return nullptr;	// stop further processing if nullptr is returned
 
@@ -1262,7 +2018,7 @@ extern "C" {
 	// Same as aalloc() with memory set to zero.
 	void * calloc( size_t dimension, size_t elemSize ) __THROW {
 		size_t size = dimension * elemSize;
-		char * addr = (char *)doMalloc( size STAT_ARG( HeapStatistics::CALLOC ) );
+		char * addr = (char *)doMalloc( size STAT_ARG( HeapStatistics::CALLOC ), true ); // header remembers zero fill
 
 	  if ( UNLIKELY( addr == nullptr ) ) return nullptr; // stop further processing if nullptr is returned
 
@@ -1297,6 +2053,20 @@ extern "C" {
 			return nullptr;
 		} // if
 
+		#ifdef __SLAB__
+		if ( slabObject( oaddr ) ) {					// headerless => no sticky properties
+			size_t odsize = slabHome( "resize", oaddr )->blockSize; // data storage available in bucket
+			if ( size <= odsize && odsize <= size * 2 ) { // allow 50% wasted storage for smaller size
+				#ifdef __U_STATISTICS__
+				heapManager->stats.resize_calls += 1;
+				#endif // __U_STATISTICS__
+				return oaddr;
+			} // if
+			doFree( oaddr );							// free original storage
+			return doMalloc( size STAT_ARG( HeapStatistics::RESIZE ) ); // create new area
+		} // if
+		#endif // __SLAB__
+
 		Heap::Storage::Header * header;
 		Heap::FreeHeader * freeHead;
 		size_t bsize, oalignment;
@@ -1339,6 +2109,29 @@ extern "C" {
 			return nullptr;
 		} // if
 
+		#ifdef __SLAB__
+		if ( slabObject( oaddr ) ) {					// headerless => no sticky properties
+			size_t odsize = slabHome( "realloc", oaddr )->blockSize; // data storage available in bucket
+			if ( size <= odsize && odsize <= size * 2 ) { // allow up to 50% wasted storage
+				#ifdef __U_STATISTICS__
+				heapManager->stats.realloc_calls += 1;
+				heapManager->stats.realloc_smaller += 1;
+				#endif // __U_STATISTICS__
+				return oaddr;
+			} // if
+
+			#ifdef __U_STATISTICS__
+			heapManager->stats.realloc_copy += 1;
+			#endif // __U_STATISTICS__
+
+			void * naddr = doMalloc( size STAT_ARG( HeapStatistics::REALLOC ) ); // create new area
+		  if ( UNLIKELY( naddr == nullptr ) ) return nullptr; // stop further processing if nullptr is returned
+			memcpy( naddr, oaddr, Min( odsize, size ) ); // request size unknown, so copy bucket
+			doFree( oaddr );							// free previous storage
+			return naddr;
+		} // if
+		#endif // __SLAB__
+
 		Heap::Storage::Header * header;
 		Heap::FreeHeader * freeHead;
 		size_t bsize, oalignment;
@@ -1371,25 +2164,24 @@ extern "C" {
 
 		void * naddr;
 		if ( LIKELY( oalignment <= uAlign() ) ) {		// previous request not aligned ?
-			naddr = doMalloc( size STAT_ARG( HeapStatistics::REALLOC ) ); // create new area
+			naddr = doMalloc( size STAT_ARG( HeapStatistics::REALLOC ), ozfill ); // create new area
 		} else {
 			#ifdef __U_STATISTICS__
 			heapManager->stats.realloc_align += 1;
 			#endif // __U_STATISTICS__
-			naddr = memalignNoStats( oalignment, size STAT_ARG( HeapStatistics::REALLOC ) ); // create new aligned area
+			naddr = memalignNoStats( oalignment, size STAT_ARG( HeapStatistics::REALLOC ), ozfill ); // create new aligned area
 		} // if
 
 	if ( UNLIKELY( naddr == nullptr ) ) return nullptr;	// stop further processing if nullptr is returned
 
-		header = HeaderAddr( naddr );					// new header
-		size_t alignment;
-		fakeHeader( header, alignment );				// could have a fake header
-
 		// To preserve prior fill, the entire bucket must be copied versus the size.
 		memcpy( naddr, oaddr, Min( osize, size ) );		// copy bytes
 		doFree( oaddr );								// free previous storage
 
 		if ( UNLIKELY( ozfill ) ) {						// previous request zero fill ?
+			header = HeaderAddr( naddr );				// new header
+			size_t alignment;
+			fakeHeader( header, alignment );			// could have a fake header
 			MarkZeroFilledBit( header );				// mark new request as zero filled
 			if ( size > osize ) {						// previous request larger ?
 				#ifdef __U_STATISTICS__
@@ -1436,6 +2228,14 @@ extern "C" {
 			return nullptr;
 		} // if
 
+		#ifdef __SLAB__
+		if ( slabObject( oaddr ) ) {					// headerless => minimum alignment
+			if ( nalignment == uAlign() ) return resize( oaddr, size ); // duplicate special case checks
+			doFree( oaddr );							// free original storage
+			return memalignNoStats( nalignment, size STAT_ARG( HeapStatistics::RESIZE ) ); // create new aligned area
+		} // if
+		#endif // __SLAB__
+
 		// Attempt to reuse existing alignment.
 		Heap::Storage::Header * header = HeaderAddr( oaddr );
 		bool isFakeHeader = AlignmentBit( header );		// old fake header ?
@@ -1496,6 +2296,18 @@ extern "C" {
 			return nullptr;
 		} // if
 
+		#ifdef __SLAB__
+		if ( slabObject( oaddr ) ) {					// headerless => minimum alignment
+			if ( nalignment == uAlign() ) return realloc( oaddr, size ); // duplicate special case checks
+			size_t odsize = slabHome( "aligned_realloc", oaddr )->blockSize; // data storage available in bucket
+			void * naddr = memalignNoStats( nalignment, size STAT_ARG( HeapStatistics::REALLOC ) ); // create new aligned area
+		  if ( UNLIKELY( naddr == nullptr ) ) return nullptr; // stop further processing if nullptr is returned
+			memcpy( naddr, oaddr, Min( odsize, size ) ); // request size unknown, so copy bucket
+			doFree( oaddr );							// free previous storage
+			return naddr;
+		} // if
+		#endif // __SLAB__
+
 		// Attempt to reuse existing alignment.
 		Heap::Storage::Header * header = HeaderAddr( oaddr );
 		bool isFakeHeader = AlignmentBit( header );		// old fake header ?
@@ -1525,18 +2337,17 @@ extern "C" {
 		size_t osize = header->kind.real.size;			// old allocation size
 		bool ozfill = ZeroFillBit( header );			// old allocation zero filled
 
-		void * naddr = memalignNoStats( nalignment, size STAT_ARG( HeapStatistics::REALLOC ) ); // create new aligned area
+		void * naddr = memalignNoStats( nalignment, size STAT_ARG( HeapStatistics::REALLOC ), ozfill ); // create new aligned area
 
 	if ( UNLIKELY( naddr == nullptr ) ) return nullptr;	// stop further processing if nullptr is returned
 
-		header = HeaderAddr( naddr );					// new header
-		size_t alignment;
-		fakeHeader( header, alignment );				// could have a fake header
-
 		memcpy( naddr, oaddr, Min( osize, size ) );		// copy bytes
 		doFree( oaddr );								// free previous storage
 
 		if ( UNLIKELY( ozfill ) ) {						// previous request zero fill ?
+			header = HeaderAddr( naddr );				// new header
+			size_t alignment;
+			fakeHeader( header, alignment );			// could have a fake header
 			MarkZeroFilledBit( header );				// mark new request as zero filled
 			if ( size > osize ) {						// previous request larger ?
 				memset( (char *)naddr + osize, '\0', size - osize ); // initialize added storage
@@ -1581,7 +2392,7 @@ extern "C" {
 	// Same as calloc() with memory alignment.
 	void * cmemalign( size_t alignment, size_t dimension, size_t elemSize ) __THROW {
 		size_t size = dimension * elemSize;
-		char * addr = (char *)memalignNoStats( alignment, size STAT_ARG( HeapStatistics::CMEMALIGN ) );
+		char * addr = (char *)memalignNoStats( alignment, size STAT_ARG( HeapStatistics::CMEMALIGN ), true ); // header remembers zero fill
 
 	  if ( UNLIKELY( addr == nullptr ) ) return nullptr; // stop further processing if nullptr is returned
 
@@ -1650,19 +2461,63 @@ extern "C" {
 	} // free
 
 
+	// Same as free, but size must be the size requested when ptr was allocated by malloc, calloc or realloc (C23). A
+	// correct size lets the storage be freed without decoding its header.
+	void free_sized( void * addr, size_t size ) __THROW {
+	  if ( UNLIKELY( addr == nullptr ) ) {				// special case
+			#ifdef __U_STATISTICS__
+			heapManager->stats.free_null_0_calls += 1;
+			#endif // __U_STATISTICS__
+			return;
+		} // if
+
+		doFreeSized( addr, size );						// handles heapManager == nullptr
+	} // free_sized
+
+
+	// Same as free_sized, but ptr must have been allocated by aligned_alloc or memalign with alignment (C23).
+	void free_aligned_sized( void * addr, size_t alignment, size_t size ) __THROW {
+	  if ( UNLIKELY( addr == nullptr ) ) {				// special case
+			#ifdef __U_STATISTICS__
+			heapManager->stats.free_null_0_calls += 1;
+			#endif // __U_STATISTICS__
+			return;
+		} // if
+
+		if ( alignment <= uAlign() ) doFreeSized( addr, size ); // minimum alignment => no fake header
+		else doFree( addr );							// fake header => decode
+	} // free_aligned_sized
+
+
 	// Sets the amount (bytes) to extend the heap when there is insufficent free storage to service an allocation.
 	__attribute__((weak)) size_t malloc_extend( void ) { return __DEFAULT_HEAP_EXTEND__; }
 
-	// Sets the crossover point between allocations occuring in the sbrk area or separately mmapped.
+	// Sets the crossover point between allocations occuring in the heap arenas or separately mmapped.
 	__attribute__((weak)) size_t malloc_mmap_start( void ) { return __DEFAULT_MMAP_START__; }
 
 	// Amount subtracted to adjust for unfreed program storage (debug only).
 	__attribute__((weak)) size_t malloc_unfreed( void ) { return __DEFAULT_HEAP_UNFREED__; }
 
+	// Sets whether heap arenas use transparent huge pages, which reduces TLB misses for large heaps.
+	__attribute__((weak)) bool malloc_hugepage( void ) { return false; }
+
+	// Sets the address space reserved for headerless small allocations; 0 => all allocations have a header.
+	__attribute__((weak)) size_t malloc_slab_region( void ) { return __DEFAULT_SLAB_REGION__; }
+
+	// Sets whether heaps and their storage are placed on the NUMA node of their thread, when there are several nodes.
+	__attribute__((weak)) bool malloc_numa( void ) { return true; }
 
-	// Returns original total allocation size (not bucket size) => array size is dimension * sizeof(T).
+	// Sets the mean bytes allocated between heap-profile samples, e.g., 512K; 0 => no sampling.
+	__attribute__((weak)) size_t malloc_sample_rate( void ) { return 0; }
+
+
+	// Returns original total allocation size (not bucket size) => array size is dimension * sizeof(T). A headerless slab
+	// object does not record its request size, so its bucket size is returned, i.e., malloc_size == malloc_usable_size.
 	size_t malloc_size( void * addr ) __THROW {
 	  if ( UNLIKELY( addr == nullptr ) ) return 0;		// null allocation has zero size
+		#ifdef __SLAB__
+	  if ( slabObject( addr ) ) return slabHome( "malloc_size", addr )->blockSize; // headerless => bucket size
+		#endif // __SLAB__
 		Heap::Storage::Header * header = HeaderAddr( addr );
 		if ( UNLIKELY( AlignmentBit( header ) ) ) {		// fake header ?
 			header = RealHeader( header );				// backup from fake to real header
@@ -1674,6 +2529,9 @@ extern "C" {
 	// Returns the alignment of an allocation.
 	size_t malloc_alignment( void * addr ) __THROW {
 	  if ( UNLIKELY( addr == nullptr ) ) return uAlign(); // minimum alignment
+		#ifdef __SLAB__
+	  if ( slabObject( addr ) ) return uAlign();		// headerless => minimum alignment
+		#endif // __SLAB__
 		Heap::Storage::Header * header = HeaderAddr( addr );
 		if ( UNLIKELY( AlignmentBit( header ) ) ) {		// fake header ?
 			return ClearAlignmentBit( header );			// clear flag from value
@@ -1686,6 +2544,9 @@ extern "C" {
 	// Returns true if the allocation is zero filled, e.g., allocated by calloc().
 	bool malloc_zero_fill( void * addr ) __THROW {
 	  if ( UNLIKELY( addr == nullptr ) ) return false;	// null allocation is not zero fill
+		#ifdef __SLAB__
+	  if ( slabObject( addr ) ) return false;			// headerless => zero fill has a header
+		#endif // __SLAB__
 		Heap::Storage::Header * header = HeaderAddr( addr );
 		if ( UNLIKELY( AlignmentBit( header ) ) ) {		// fake header ?
 			header = RealHeader( header );				// backup from fake to real header
@@ -1696,6 +2557,9 @@ extern "C" {
 
 	bool malloc_remote( void * addr ) __THROW {
 	  if ( UNLIKELY( addr == nullptr ) ) return false;	// null allocation is not zero fill
+		#ifdef __SLAB__
+	  if ( slabObject( addr ) ) return heapManager == slabHome( "malloc_remote", addr )->homeManager;
+		#endif // __SLAB__
 		Heap::Storage::Header * header = HeaderAddr( addr );
 		if ( UNLIKELY( AlignmentBit( header ) ) ) {		// fake header ?
 			header = RealHeader( header );				// backup from fake to real header
@@ -1708,6 +2572,9 @@ extern "C" {
 	// malloc or a related function. Returned size is >= allocation size (bucket size).
 	size_t malloc_usable_size( void * addr ) __THROW {
 	  if ( UNLIKELY( addr == nullptr ) ) return 0;		// null allocation has zero size
+		#ifdef __SLAB__
+	  if ( slabObject( addr ) ) return slabHome( "malloc_usable_size", addr )->blockSize; // headerless => bucket size
+		#endif // __SLAB__
 		Heap::Storage::Header * header;
 		Heap::FreeHeader * freeHead;
 		size_t bsize, alignment;
@@ -1723,12 +2590,29 @@ extern "C" {
 		HeapStatistics stats;
 		HeapStatisticsCtor( stats );
 		printStats( collectStats( stats ) );			// file might be closed
+		printNodeStats();
+		#ifdef __SAMPLE__
+		if ( heapMaster.sampleRate != 0 ) printProfile( heapMaster.stats_fd );
+		#endif // __SAMPLE__
 		#else
 		#define MALLOC_STATS_MSG "malloc_stats statistics disabled.\n"
 		uDebugWrite( STDERR_FILENO, MALLOC_STATS_MSG, sizeof( MALLOC_STATS_MSG ) - 1 /* size includes '\0' */ ); // file might be closed
+		#ifdef __SAMPLE__
+		if ( heapMaster.sampleRate != 0 ) printProfile( STDERR_FILENO );
+		#endif // __SAMPLE__
 		#endif // __U_STATISTICS__
 	} // malloc_stats
 
+	// Prints the heap profile collected by sampling on file descriptor fd.
+	int malloc_profile( int fd __attribute__(( unused )) ) __THROW {
+		#ifdef __SAMPLE__
+	  if ( heapMaster.sampleRate == 0 ) return 0;		// not sampling
+		return printProfile( fd );						// returns bytes written
+		#else
+		return 0;										// unsupported
+		#endif // __SAMPLE__
+	} // malloc_profile
+
 	// Zero the heap master and all active thread heaps.
 	void malloc_stats_clear( void ) __THROW {
 		#ifdef __U_STATISTICS__
@@ -1780,7 +2664,7 @@ extern "C" {
 	  if ( value < 0 ) return 0;
 		switch( option ) {
 		  case M_TOP_PAD:
-			heapMaster.sbrkExtend = uCeiling( value, heapMaster.pageSize );
+			heapMaster.arenaExtend = uCeiling( value, heapMaster.arenaAlign );
 			return 1;
 		  case M_MMAP_THRESHOLD:
 			if ( setMmapStart( value ) ) return 1;
@@ -1812,6 +2696,42 @@ extern "C" {
 	} // malloc_set_state
 } // extern "C"
 
+
+// The sized forms of delete receive the object size, so replace them to use the sized fast path. The unsized forms are
+// replaced with them, as the C++ runtime requires.
+
+void operator delete( void * addr ) noexcept {
+	free( addr );
+} // operator delete
+
+void operator delete[]( void * addr ) noexcept {
+	free( addr );
+} // operator delete[]
+
+void operator delete( void * addr, std::align_val_t ) noexcept {
+	free( addr );
+} // operator delete
+
+void operator delete[]( void * addr, std::align_val_t ) noexcept {
+	free( addr );
+} // operator delete[]
+
+void operator delete( void * addr, std::size_t size ) noexcept {
+	free_sized( addr, size );
+} // operator delete
+
+void operator delete[]( void * addr, std::size_t size ) noexcept {
+	free_sized( addr, size );
+} // operator delete[]
+
+void operator delete( void * addr, std::size_t size, std::align_val_t alignment ) noexcept {
+	free_aligned_sized( addr, (size_t)alignment, size );
+} // operator delete
+
+void operator delete[]( void * addr, std::size_t size, std::align_val_t alignment ) noexcept {
+	free_aligned_sized( addr, (size_t)alignment, size );
+} // operator delete[]
+
 // Local Variables: //
 // tab-width: 4 //
 // compile-command: "make install" //
@@ -44,13 +44,21 @@ extern "C" {
 	int posix_aligned_realloc( void ** oaddrp, size_t nalignment, size_t size ) __THROW;
 	int posix_aligned_reallocarray( void ** oaddrp, size_t nalignment, size_t dimension, size_t elemSize ) __THROW;
 
+	// New deallocation operations (C23)
+	void free_sized( void * addr, size_t size ) __THROW; // free with allocation request size
+	void free_aligned_sized( void * addr, size_t alignment, size_t size ) __THROW; // free_sized + alignment
+
 	// New control operations
-	size_t malloc_extend( void );						// heap extend size (bytes)
-	size_t malloc_mmap_start( void );					// crossover allocation size from sbrk to mmap
+	size_t malloc_extend( void );						// heap arena size (bytes)
+	size_t malloc_mmap_start( void );					// crossover allocation size from arena to mmap
 	size_t malloc_unfreed( void );						// amount subtracted to adjust for unfreed program storage (debug only)
+	bool malloc_hugepage( void );						// true => heap arenas use transparent huge pages
+	size_t malloc_slab_region( void );					// address space for headerless small allocations, 0 => none
+	bool malloc_numa( void );							// true => heaps are placed on the NUMA node of their thread
+	size_t malloc_sample_rate( void );					// mean bytes allocated between heap-profile samples, 0 => none
 
 	// Preserved properties
-	size_t malloc_size( void * addr ) __THROW __attribute_warn_unused_result__;		 // object's request size, malloc_size <= malloc_usable_size
+	size_t malloc_size( void * addr ) __THROW __attribute_warn_unused_result__;		 // object's request size (bucket size if headerless), malloc_size <= malloc_usable_size
 	size_t malloc_alignment( void * addr ) __THROW __attribute_warn_unused_result__; // object alignment
 	bool malloc_zero_fill( void * addr ) __THROW __attribute_warn_unused_result__;	 // true if object is zero filled
 	bool malloc_remote( void * addr ) __THROW __attribute_warn_unused_result__;		 // true if object is remote
@@ -59,6 +67,7 @@ extern "C" {
 	int malloc_stats_fd( int fd ) __THROW;				// file descriptor global malloc_stats() writes (default stdout)
 	void malloc_stats_clear( void ) __THROW;			// clear global heap statistics
 	void heap_stats( void ) __THROW;					// print thread per heap statistics
+	int malloc_profile( int fd ) __THROW;				// print sampled heap profile by task and call site
 
 	// If unsupport, create them, as supported in mallopt.
 	#ifndef M_MMAP_THRESHOLD
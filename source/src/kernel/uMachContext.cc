@@ -32,6 +32,7 @@
 #include <uProfiler.h>
 #endif // __U_PROFILER__
 #include <uHeapLmmm.h>
+#include <uEpoch.h>
 
 #include <uDebug.h>										// access: uDebugWrite
 #undef __U_DEBUG_H__									// turn off debug prints
@@ -160,6 +161,7 @@ namespace UPP {
 		if ( This.pthreadData != nullptr ) {
 			pthread_deletespecific_( This.pthreadData );
 		} // if
+		uHazardPointer::release( This );				// hazard slot kept by task
 
 //		uHeapControl::finishTask();
 
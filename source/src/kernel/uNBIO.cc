@@ -937,7 +937,7 @@ namespace UPP {
 				waitOrPoll( node );
 			} else {
 				uDuration delay( timeout->tv_sec, timeout->tv_usec * 1000 );
-				uTime time = uClock::currTime() + delay;
+				uTime time = uClock::monoTime() + delay;
 				uSelectTimeoutHndlr handler( uThisTask(), node );
 
 				uEventNode timeoutEvent( uThisTask(), handler, time ); // event node for event list
@@ -997,7 +997,7 @@ namespace UPP {
 				waitOrPoll( nfds, node );
 			} else {
 				uDuration delay( timeout->tv_sec, timeout->tv_usec * 1000 );
-				uTime time = uClock::currTime() + delay;
+				uTime time = uClock::monoTime() + delay;
 				uSelectTimeoutHndlr handler( uThisTask(), node );
 
 				uEventNode timeoutEvent( uThisTask(), handler, time ); // event node for event list
@@ -34,6 +34,7 @@
 #include <uProfiler.h>
 #endif // __U_PROFILER__
 #include <uProcessor.h>
+#include <uEpoch.h>
 
 #include <uDebug.h>										// access: uDebugWrite
 #undef __U_DEBUG_H__									// turn off debug prints
@@ -148,9 +149,37 @@ void uProcessorTask::main() {
 			#endif // __U_LOCALDEBUGGER_H__
 
 			result.signalBlock();
+		} or _Accept( setHWCounters ) {
+			uDEBUGPRT( uDebugPrt( "(uProcessorTask &)%p.main, setHWCounters( %d )\n", this, hwCounters ); );
+
+			// Counters must be opened by the kernel thread they count. Changing processor.hwCounters is safe because
+			// the processor kernel only reads it while switching user tasks on this kernel thread.
+
+			if ( hwCounters ) {
+				if ( processor.hwCounters == nullptr ) {
+					uHWCounters * counters = new uHWCounters;
+					if ( counters->opened() ) {
+						processor.hwCounters = counters;
+					} else {
+						delete counters;
+						hwCounters = false;			// indicate failure
+					} // if
+				} // if
+			} else if ( processor.hwCounters != nullptr ) {
+				delete processor.hwCounters;
+				processor.hwCounters = nullptr;
+			} // if
+
+			result.signalBlock();
+		} or _Accept( readHWCounters ) {
 		} // _Accept
 	} // for
 
+	if ( processor.hwCounters != nullptr ) {			// close counters on this kernel thread
+		delete processor.hwCounters;
+		processor.hwCounters = nullptr;
+	} // if
+
 	#if defined( __U_MULTI__ )
 	processor.setContextSwitchEvent( 0 );				// clear the alarm on this processor
 	assert( ! processor.contextEvent->listed() );
@@ -182,6 +211,22 @@ void uProcessorTask::setCluster( uCluster & cluster ) {
 } // uProcessorTask::setCluster
 
 
+bool uProcessorTask::setHWCounters( bool on ) {
+	hwCounters = on;									// copy arguments
+	result.wait();										// wait for result
+	return hwCounters;
+} // uProcessorTask::setHWCounters
+
+
+uHWCounters::Counts uProcessorTask::readHWCounters() {
+	// Reading a counter file descriptor is valid from any kernel thread, and the counters cannot be closed while this
+	// mutex member executes.
+	uHWCounters::Counts counts;
+	if ( processor.hwCounters != nullptr ) processor.hwCounters->read( counts );
+	return counts;
+} // uProcessorTask::readHWCounters
+
+
 uProcessorTask::uProcessorTask( uCluster & cluster, uProcessor & processor ) : uBaseTask( cluster, processor ), processor( processor ) {
 } // uProcessorTask::uProcessorTask
 
@@ -211,6 +256,9 @@ uProcessorTask::~uProcessorTask() {
 
 extern void heapManagerCtor();
 extern void heapManagerDtor();
+#if defined( __U_AFFINITY__ )
+extern void heapManagerRebind();
+#endif // __U_AFFINITY__
 
 // Safe to make direct accesses through TLS pointer because Kernel thread just started so no concurrency.
 void * uKernelModule::startThread( void * p __attribute__(( unused )) ) {
@@ -398,9 +446,9 @@ void uProcessorKernel::setTimer( uTime time ) {
 	);
   if ( time <= uTime() ) return;						// if time is zero or negative, it is invalid
 
-	// The time parameter is always in real-time (not virtual time)
+	// The time parameter is always on the deadline clock (not virtual time)
 
-	uDuration dur = time - uClock::currTime();
+	uDuration dur = time - uClock::monoTime();
   if ( dur <= 0 ) return;								// if duration is zero or negative, it has already past
 	setTimer( dur );
 } // uProcessorKernel::setTimer
@@ -588,8 +636,15 @@ void uProcessorKernel::main() {
 			uFetchAdd( UPP::Statistics::user_context_switches, 1 );
 			#endif // __U_STATISTICS__
 
+			// Counters are bound to this kernel thread, so use the same counters after the switch even if the
+			// processor changes.
+			uHWCounters * hwCounters = processor->hwCounters;
+			if ( UNLIKELY( hwCounters != nullptr ) ) hwCounters->switchIn();
+
 			uSwitch( context_, readyTask->currCoroutine_->context_ );
 
+			if ( UNLIKELY( hwCounters != nullptr ) ) hwCounters->switchOut( readyTask->hwCounters_ );
+
 			assert( uKernelModule::uKernelModuleBoot.disableInt && uKernelModule::uKernelModuleBoot.disableIntCnt > 0 );
 			// activeTask is set to the uProcessorTask and MUST stay set until another task is selected to ensure that
 			// errno works correctly should a SIGALRM occurs while in the kernel.
@@ -625,6 +680,17 @@ void uProcessorKernel::main() {
 			onBehalfOfUser();							// execute code on scheduler stack on behalf of user
 		} // if
 
+		if ( UNLIKELY( processor->epochRecord != nullptr ) ) { // quiescent point for memory reclamation
+			uEpoch::quiescent( *processor );
+		} // if
+
+		#if defined( __U_AFFINITY__ )
+		if ( UNLIKELY( processor->affinityChanged ) ) {	// heap is thread local, so rebind on this kernel thread
+			processor->affinityChanged = false;
+			heapManagerRebind();
+		} // if
+		#endif // __U_AFFINITY__
+
 		#ifdef __U_MULTI__
 		if ( ! uKernelModule::uKernelModuleBoot.RFinprogress && uKernelModule::uKernelModuleBoot.RFpending ) { // run roll forward ?
 			uKernelModule::rollForward( true );
@@ -788,6 +854,12 @@ void uProcessor::createProcessor( uCluster & cluster, bool detached, int ms, int
 	#endif // __U_MULTI__
 
 	terminated = false;
+	hwCounters = nullptr;
+	logBuffer = nullptr;
+	epochRecord = nullptr;
+	#if defined( __U_AFFINITY__ )
+	affinityChanged = false;
+	#endif // __U_AFFINITY__
 	currCluster_->processorAdd( *this );
 
 	uKernelModule::globalProcessorLock->acquire();		// add processor to global processor list.
@@ -865,6 +937,7 @@ uProcessor::~uProcessor() {
 	uDEBUGPRT( uDebugPrt( "(uProcessor &)%p.~uProcessor\n", this ); );
 
 	delete procTask;
+	uEpoch::detach( *this );							// no more tasks execute on this processor
 
 	#if defined( __U_MULTI__ )
 	#ifdef __U_PROFILER__
@@ -965,12 +1038,12 @@ void uProcessor::setContextSwitchEvent( uDuration duration ) {
 	assert( duration >= 0 );
 
 	if ( ! contextEvent->listed() && duration != 0 ) {	// first context switch event ?
-		contextEvent->alarm = uClock::currTime() + duration;
+		contextEvent->alarm = uClock::monoTime() + duration;
 		contextEvent->period = duration;
 		contextEvent->add();
 	} else if ( duration > 0 && contextEvent->period != duration ) { // if event is different from previous ? change it
 		contextEvent->remove();
-		contextEvent->alarm = uClock::currTime() + duration;
+		contextEvent->alarm = uClock::monoTime() + duration;
 		contextEvent->period = duration;
 		contextEvent->add();
 	} else if ( duration == 0 && contextEvent->alarm != uTime() ) { // zero duration and current CS is nonzero ?
@@ -1029,6 +1102,7 @@ void uProcessor::setAffinity( const cpu_set_t & mask ) {
 	#endif // __U_MULTI__
 		abort( "(uProcessor &)%p.setAffinity() : internal error, could not set processor affinity, error(%d) %s.", this, errno, strerror( errno ) );
 	} // if
+	affinityChanged = true;
 } // uProcessor::setAffinity
 
 void uProcessor::setAffinity( unsigned int cpu ) {
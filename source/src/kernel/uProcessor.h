@@ -33,6 +33,7 @@
 
 _Task uProcessorTask {
 	friend class uProcessor;				// access: setPreemption
+	friend class uHWCounters;				// access: setHWCounters, readHWCounters
 
 	uProcessor &processor;				// associated processor
 	uCondition result;
@@ -40,10 +41,13 @@ _Task uProcessorTask {
 
 	unsigned int preemption;				// communication: setPreemption
 	uCluster *cluster;					// communication: setCluster
+	bool hwCounters;					// communication: setHWCounters
 
 	void main();
 	_Mutex void setPreemption( unsigned int ms );
 	_Mutex void setCluster( uCluster &cluster );
+	_Mutex bool setHWCounters( bool on );
+	_Mutex uHWCounters::Counts readHWCounters();
 
 	uProcessorTask( uCluster &cluster, uProcessor &processor );
 	~uProcessorTask();
@@ -0,0 +1,109 @@
+//                              -*- Mode: C++ -*-
+//
+// uC++ Version 7.0.0, Copyright (C) Peter A. Buhr 2026
+//
+// uRegion.cc --
+//
+// Author           : agent
+// Created On       : Mon Oct 19 03:20:18 2026
+// Last Modified By : agent
+// Last Modified On : Mon Oct 19 03:20:18 2026
+// Update Count     : 1
+//
+// This  library is free  software; you  can redistribute  it and/or  modify it
+// under the terms of the GNU Lesser General Public License as published by the
+// Free Software  Foundation; either  version 2.1 of  the License, or  (at your
+// option) any later version.
+//
+// This library is distributed in the  hope that it will be useful, but WITHOUT
+// ANY  WARRANTY;  without even  the  implied  warranty  of MERCHANTABILITY  or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+// for more details.
+//
+// You should  have received a  copy of the  GNU Lesser General  Public License
+// along  with this library.
+//
+
+
+#define __U_KERNEL__
+#include <uC++.h>
+#include <uRegion.h>
+
+
+// The first chunk is allocated on the first allocation, so an unused region costs nothing.
+uRegion::uRegion( size_t chunkSize ) : owner( uThisTask() ), outer( current() ), chunks( nullptr ), next( nullptr ), end( nullptr ), chunkSize( chunkSize ) {
+	uDEBUG( if ( chunkSize < sizeof(Chunk) * 2 ) abort( "uRegion::uRegion : chunk size %zu is too small.", chunkSize ); );
+	owner.heapData = this;
+} // uRegion::uRegion
+
+
+uRegion::~uRegion() {
+	uDEBUG(
+		if ( &uThisTask() != &owner ) {
+			abort( "Attempt by task %.256s (%p) to delete region %p declared by task %.256s (%p).",
+				   uThisTask().getName(), &uThisTask(), this, owner.getName(), &owner );
+		} // if
+		if ( owner.heapData != this ) {
+			abort( "Attempt to delete region %p before its nested region %p.", this, owner.heapData );
+		} // if
+	);
+	for ( Chunk * c = chunks; c != nullptr; ) {
+		Chunk * n = c->next;
+		free( c );
+		c = n;
+	} // for
+	owner.heapData = outer;
+} // uRegion::~uRegion
+
+
+// A request larger than a quarter of a chunk gets its own chunk behind the newest one, so the bump storage in the newest
+// chunk is not abandoned.
+void * uRegion::extend( size_t size, size_t alignment ) {
+	uDEBUG( if ( &uThisTask() != &owner ) abort( "Attempt by task %.256s (%p) to allocate from region %p declared by task %.256s (%p).",
+												 uThisTask().getName(), &uThisTask(), this, owner.getName(), &owner ); );
+	size_t hsize = uCeiling( sizeof(Chunk), alignment );	// header padded to alignment
+	bool large = size > (chunkSize - sizeof(Chunk)) / 4;
+	size_t csize = large ? hsize + size : chunkSize;
+	if ( ! large && hsize + size > csize ) csize = hsize + size; // alignment larger than a chunk quarter
+	Chunk * c = (Chunk *)(alignment <= uAlign() ? malloc( csize ) : memalign( alignment, csize ));
+  if ( UNLIKELY( c == nullptr ) ) abort( "attempt to allocate region chunk of size %zu bytes failed with errno %d.", csize, errno );
+	c->size = csize;
+	char * addr = (char *)c + hsize;
+
+	if ( large && chunks != nullptr ) {					// keep newest chunk for bump allocation
+		c->next = chunks->next;
+		chunks->next = c;
+	} else {
+		c->next = chunks;
+		chunks = c;
+		next = addr + size;
+		end = (char *)c + csize;
+	} // if
+	return addr;
+} // uRegion::extend
+
+
+// Keep the newest chunk, which holds the bump storage.
+void uRegion::release() {
+  if ( chunks == nullptr ) return;
+	for ( Chunk * c = chunks->next; c != nullptr; ) {
+		Chunk * n = c->next;
+		free( c );
+		c = n;
+	} // for
+	chunks->next = nullptr;
+	next = (char *)chunks + sizeof(Chunk);
+	end = (char *)chunks + chunks->size;
+} // uRegion::release
+
+
+size_t uRegion::storage() const {
+	size_t total = 0;
+	for ( Chunk * c = chunks; c != nullptr; c = c->next ) total += c->size;
+	return total;
+} // uRegion::storage
+
+
+// Local Variables: //
+// compile-command: "make install" //
+// End: //
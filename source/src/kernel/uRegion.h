@@ -0,0 +1,120 @@
+//                              -*- Mode: C++ -*-
+//
+// uC++ Version 7.0.0, Copyright (C) Peter A. Buhr 2026
+//
+// uRegion.h -- Bump-pointer region allocation scoped to a task
+//
+// Author           : agent
+// Created On       : Mon Oct 19 03:20:18 2026
+// Last Modified By : agent
+// Last Modified On : Mon Oct 19 03:20:18 2026
+// Update Count     : 1
+//
+// This  library is free  software; you  can redistribute  it and/or  modify it
+// under the terms of the GNU Lesser General Public License as published by the
+// Free Software  Foundation; either  version 2.1 of  the License, or  (at your
+// option) any later version.
+//
+// This library is distributed in the  hope that it will be useful, but WITHOUT
+// ANY  WARRANTY;  without even  the  implied  warranty  of MERCHANTABILITY  or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+// for more details.
+//
+// You should  have received a  copy of the  GNU Lesser General  Public License
+// along  with this library.
+//
+
+
+#pragma once
+
+
+#include <cstddef>										// max_align_t
+
+
+// A region allocates storage by bumping a pointer through large chunks obtained from the heap, and frees all of its
+// storage at once when it is released or destroyed. Individual objects are never freed, so an allocation has no header
+// and no bucket, and freeing a request's objects is one operation. Objects are not destructed when storage is
+// released, so a region holds objects with trivial destructors or objects destructed explicitly.
+//
+// Regions are declared in a task and nest: the innermost region of the executing task is uRegion::current(), so code
+// called by the task can allocate from it without passing it along. A region is used only by the task that declared
+// it, and regions must be destroyed in reverse order of declaration.
+
+class uRegion {
+	struct Chunk {										// header at the start of each chunk
+		Chunk * next;									// older chunks
+		size_t size;									// chunk size in bytes, including header
+	}; // Chunk
+
+	uBaseTask & owner;									// task that declared the region
+	uRegion * outer;									// enclosing region of owner
+	Chunk * chunks;										// newest chunk first
+	char * next, * end;									// bump storage in newest chunk
+	size_t chunkSize;									// size of each new chunk
+
+	void * extend( size_t size, size_t alignment );		// allocate from a new chunk
+  public:
+	enum : size_t { DefaultChunkSize = 64 * 1024 };
+
+	uRegion( const uRegion & ) = delete;				// no copy
+	uRegion( uRegion && ) = delete;
+	uRegion & operator=( const uRegion & ) = delete;	// no assignment
+	uRegion & operator=( uRegion && ) = delete;
+
+	uRegion( size_t chunkSize = DefaultChunkSize );		// becomes the task's current region
+	~uRegion();											// free all storage, enclosing region becomes current
+
+	void * alloc( size_t size, size_t alignment = alignof( std::max_align_t ) ) {
+		char * addr = (char *)uCeiling( (uintptr_t)next, alignment );
+	  if ( UNLIKELY( addr >= end || size > (size_t)(end - addr) ) ) return extend( size, alignment ); // chunk full ?
+		next = addr + size;
+		return addr;
+	} // uRegion::alloc
+
+	void release();										// free all storage, keeping one chunk for reuse
+	size_t storage() const;								// bytes of chunks held by the region
+
+	static uRegion * current() {						// innermost region of the executing task, nullptr => none
+		return (uRegion *)uThisTask().heapData;
+	} // uRegion::current
+
+	// STL allocator drawing storage from a region, by default the current region. Deallocation is a no-op; storage
+	// is freed when the region is released.
+	template< typename T > class Allocator {
+		template< typename U > friend class Allocator;	// access: region
+		uRegion * region;
+	  public:
+		typedef T value_type;
+
+		Allocator() : region( current() ) {
+			uDEBUG( if ( region == nullptr ) abort( "uRegion::Allocator : no current region for task %.256s (%p).", uThisTask().getName(), &uThisTask() ); );
+		} // Allocator::Allocator
+		Allocator( uRegion & region ) : region( &region ) {}
+		template< typename U > Allocator( const Allocator< U > & other ) : region( other.region ) {}
+
+		T * allocate( size_t n ) {
+			return (T *)region->alloc( n * sizeof(T), alignof(T) ); // pack to type alignment
+		} // Allocator::allocate
+		void deallocate( T *, size_t ) {}				// storage freed with region
+
+		template< typename U > bool operator==( const Allocator< U > & other ) const { return region == other.region; }
+		template< typename U > bool operator!=( const Allocator< U > & other ) const { return region != other.region; }
+	}; // Allocator
+}; // uRegion
+
+
+inline void * operator new( size_t size, uRegion & region ) {
+	return region.alloc( size );
+} // operator new
+
+inline void * operator new[]( size_t size, uRegion & region ) {
+	return region.alloc( size );
+} // operator new[]
+
+inline void operator delete( void *, uRegion & ) {}		// called if constructor raises exception, storage freed with region
+inline void operator delete[]( void *, uRegion & ) {}
+
+
+// Local Variables: //
+// compile-command: "make install" //
+// End: //
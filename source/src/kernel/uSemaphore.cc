@@ -90,22 +90,26 @@ namespace UPP {
 
 
 	bool uSemaphore::P( uDuration duration ) {			// semaphore wait
-		return P( uClock::currTime() + duration );
+		return PDeadline( uClock::monoTime() + duration );
 	} // uSemaphore::P
 
 	bool uSemaphore::P( uintptr_t info, uDuration duration ) { // semaphore wait
 		uThisTask().info_ = info;						// store the information with this task
-		return P( uClock::currTime() + duration );
+		return PDeadline( uClock::monoTime() + duration );
 	} // uSemaphore::P
 
 
 	bool uSemaphore::P( uTime time ) {					// semaphore wait
+		return PDeadline( uClock::monoTime( time ) );
+	} // uSemaphore::P
+
+	bool uSemaphore::PDeadline( uTime deadline ) {		// semaphore wait
 		spinLock.acquire();
 		count -= 1;
 		if ( count < 0 ) {
 			uBaseTask &task = uThisTask();				// optimization
 			TimedWaitHandler handler( task, *this );	// handler to wake up blocking task
-			uEventNode timeoutEvent( task, handler, time, 0 );
+			uEventNode timeoutEvent( task, handler, deadline, 0 );
 			timeoutEvent.executeLocked = true;
 			timeoutEvent.add();
 			waiting.addTail( &(task.entryRef_) );		// queue current task
@@ -117,7 +121,7 @@ namespace UPP {
 			spinLock.release();
 			return true;
 		} // if
-	} // uSemaphore::P
+	} // uSemaphore::PDeadline
 
 	bool uSemaphore::P( uintptr_t info, uTime time ) {	// semaphore wait
 		uThisTask().info_ = info;						// store the information with this task
@@ -152,16 +156,20 @@ namespace UPP {
 
 
 	bool uSemaphore::P( uSemaphore & s, uDuration duration ) { // wait on semaphore and release another
-		return P( s, uClock::currTime() + duration );
+		return PDeadline( s, uClock::monoTime() + duration );
 	} // uSemaphore::P
 
 	bool uSemaphore::P( uSemaphore & s, uintptr_t info, uDuration duration ) { // wait on semaphore and release another
 		uThisTask().info_ = info;						// store the information with this task
-		return P( s, uClock::currTime() + duration );
+		return PDeadline( s, uClock::monoTime() + duration );
 	} // uSemaphore::P
 
 
 	bool uSemaphore::P( uSemaphore & s, uTime time ) {	// wait on semaphore and release another
+		return PDeadline( s, uClock::monoTime( time ) );
+	} // uSemaphore::P
+
+	bool uSemaphore::PDeadline( uSemaphore & s, uTime deadline ) { // wait on semaphore and release another
 		spinLock.acquire();
 		if ( &s == this ) {								// perform operation on self ?
 			if ( count < 0 ) {							// V my semaphore
@@ -176,7 +184,7 @@ namespace UPP {
 		if ( count < 0 ) {
 			uBaseTask &task = uThisTask();				// optimization
 			TimedWaitHandler handler( task, *this );	// handler to wake up blocking task
-			uEventNode timeoutEvent( task, handler, time, 0 );
+			uEventNode timeoutEvent( task, handler, deadline, 0 );
 			timeoutEvent.executeLocked = true;
 			timeoutEvent.add();
 			waiting.addTail( &(task.entryRef_) );		// queue current task
@@ -188,7 +196,7 @@ namespace UPP {
 			spinLock.release();
 			return true;
 		} // if
-	} //  uSemaphore::P
+	} // uSemaphore::PDeadline
 
 	bool uSemaphore::P( uSemaphore & s, uintptr_t info, uTime time ) { // wait on semaphore and release another
 		uThisTask().info_ = info;						// store the information with this task
@@ -37,6 +37,9 @@ using std::min;
 #include <cstring>										// strerror
 #include <unistd.h>										// read, write, close, etc.
 #include <sys/uio.h>									// readv, writev
+#include <sys/ioctl.h>									// FIONREAD
+#include <fcntl.h>
+#include <poll.h>
 
 
 //######################### uFileIO #########################
@@ -148,6 +151,14 @@ int uFileIO::readv( const struct iovec *iov, int iovcnt, uDuration *timeout ) {
 
 
 int uFileIO::write( const char *buf, int len, uDuration *timeout ) {
+	struct iovec iov = { (void *)buf, (size_t)len };
+	int wlen;
+	if ( writeHook( &iov, 1, timeout, "write", wlen ) ) return wlen;
+	return write_( buf, len, timeout );
+} // uFileIO::write
+
+
+int uFileIO::write_( const char *buf, int len, uDuration *timeout ) {
 	int wlen;
 
 	struct Write : public uIOClosure {
@@ -192,11 +203,12 @@ int uFileIO::write( const char *buf, int len, uDuration *timeout ) {
 	uFetchAdd( UPP::Statistics::write_bytes, len );
 #endif // __U_STATISTICS__
 	return len;											// always return the specified length
-} // uFileIO::write
+} // uFileIO::write_
 
 
 int uFileIO::writev( const struct iovec *iov, int iovcnt, uDuration *timeout ) {
 	int wlen;
+	if ( writeHook( iov, iovcnt, timeout, "writev", wlen ) ) return wlen;
 
 	struct Writev : public uIOClosure {
 		const struct iovec *iov;
@@ -225,6 +237,181 @@ int uFileIO::writev( const struct iovec *iov, int iovcnt, uDuration *timeout ) {
 } // uFileIO::writev
 
 
+// Write all the data in the I/O vector, which is modified. Like write, EIO discards the output.
+void uFileIO::writeall( struct iovec *iov, int iovcnt ) {
+	for ( ;; ) {
+		for ( ; iovcnt > 0 && iov[0].iov_len == 0; iov += 1, iovcnt -= 1 ); // skip empty vectors
+	  if ( iovcnt == 0 ) break;
+		int wbytes = writev( iov, iovcnt );
+	  if ( wbytes == -1 ) break;						// EIO => output discarded
+		size_t w = wbytes;
+		for ( ; w >= iov[0].iov_len; iov += 1, iovcnt -= 1 ) { // remove written vectors
+			w -= iov[0].iov_len;
+		  if ( iovcnt == 1 ) return;
+		} // for
+		iov[0].iov_base = (char *)iov[0].iov_base + w;	// partially written vector
+		iov[0].iov_len -= w;
+	} // for
+} // uFileIO::writeall
+
+
+// Block until a splice, tee or vmsplice that failed with EAGAIN can make progress. The input is the cause when it has
+// no data, so the task waits for the input in that case and otherwise for this descriptor, which is full. Like
+// sendfile, the transfer is retried by the caller rather than performed by the poller when the descriptor becomes
+// ready, because the other descriptor may be a file that blocks on disk I/O.
+void uFileIO::transferWait( uFileIO *in, const size_t len, uDuration *timeout, const char *const op ) {
+	int ready;
+
+	struct Ready : public uIOClosure {
+		int action() { return 0; }						// transfer performed by caller
+		Ready( uIOaccess &access, int &ready ) : uIOClosure( access, ready ) {}
+	};
+
+	if ( in != nullptr ) {
+		int avail;
+		if ( ::ioctl( in->access.fd, FIONREAD, &avail ) == -1 ) { // no byte count ?
+			struct pollfd fd = { in->access.fd, POLLIN, 0 };
+			avail = ::poll( &fd, 1, 0 ) == 1;			// no wait, EINTR => no data
+		} // if
+		if ( avail == 0 ) {								// no input => input caused EAGAIN
+			Ready readyClosure( in->access, ready );
+			if ( ! readyClosure.select( uCluster::ReadSelect, timeout ) ) {
+				in->readTimeout( nullptr, len, timeout, op );
+			} // if
+			return;
+		} // if
+	} // if
+	Ready readyClosure( access, ready );
+	if ( ! readyClosure.select( uCluster::WriteSelect, timeout ) ) {
+		writeTimeout( nullptr, len, timeout, op );
+	} // if
+} // uFileIO::transferWait
+
+
+// Raise the failure of a splice or tee on the descriptor that caused it. The error number does not say which side is
+// wrong, so the input is blamed when it is not open for reading or when it is given an offset but cannot seek.
+void uFileIO::transferFailure( uFileIO &in, int errno_, const size_t len, loff_t *inoff, uDuration *timeout, const char *const op ) {
+	bool input = false;
+	switch ( errno_ ) {
+	  case EBADF: {
+		  int flags = ::fcntl( in.access.fd, F_GETFL );
+		  input = flags == -1 || (flags & O_ACCMODE) == O_WRONLY;
+		  break;
+	  }
+	  case ESPIPE:
+		input = inoff != nullptr && ::lseek( in.access.fd, 0, SEEK_CUR ) == -1;
+		break;
+	} // switch
+	if ( input ) {
+		in.readFailure( errno_, nullptr, len, timeout, op );
+	} else {
+		writeFailure( errno_, nullptr, len, timeout, op );
+	} // if
+} // uFileIO::transferFailure
+
+
+ssize_t uFileIO::splice( uFileIO &in, size_t len, loff_t *inoff, loff_t *outoff, uDuration *timeout ) {
+	int ret;
+	ssize_t slen;
+
+	struct Splice : public uIOClosure {
+		int in_fd;
+		loff_t *inoff, *outoff;
+		size_t len;
+		ssize_t &slen;									// number of bytes moved
+
+		int action() {
+			slen = ::splice( in_fd, inoff, access.fd, outoff, len, SPLICE_F_MOVE | SPLICE_F_NONBLOCK );
+			return slen == -1 ? -1 : 0;
+		} // action
+		Splice( uIOaccess &access, int &ret, int in_fd, loff_t *inoff, loff_t *outoff, size_t len, ssize_t &slen ) :
+			uIOClosure( access, ret ), in_fd( in_fd ), inoff( inoff ), outoff( outoff ), len( len ), slen( slen ) {}
+	} spliceClosure( access, ret, in.access.fd, inoff, outoff, len, slen );
+
+	for ( ;; ) {
+		spliceClosure.wrapper();
+	  if ( ret != -1 ) break;
+		if ( spliceClosure.errno_ != U_EWOULDBLOCK ) {
+			transferFailure( in, spliceClosure.errno_, len, inoff, timeout, "splice" );
+		} // if
+		transferWait( &in, len, timeout, "splice" );
+	} // for
+
+#ifdef __U_STATISTICS__
+	uFetchAdd( UPP::Statistics::read_bytes, slen );
+	uFetchAdd( UPP::Statistics::write_bytes, slen );
+#endif // __U_STATISTICS__
+	return slen;
+} // uFileIO::splice
+
+
+ssize_t uFileIO::tee( uFileIO &in, size_t len, uDuration *timeout ) {
+	int ret;
+	ssize_t tlen;
+
+	struct Tee : public uIOClosure {
+		int in_fd;
+		size_t len;
+		ssize_t &tlen;									// number of bytes duplicated
+
+		int action() {
+			tlen = ::tee( in_fd, access.fd, len, SPLICE_F_NONBLOCK );
+			return tlen == -1 ? -1 : 0;
+		} // action
+		Tee( uIOaccess &access, int &ret, int in_fd, size_t len, ssize_t &tlen ) :
+			uIOClosure( access, ret ), in_fd( in_fd ), len( len ), tlen( tlen ) {}
+	} teeClosure( access, ret, in.access.fd, len, tlen );
+
+	for ( ;; ) {
+		teeClosure.wrapper();
+	  if ( ret != -1 ) break;
+		if ( teeClosure.errno_ != U_EWOULDBLOCK ) {
+			transferFailure( in, teeClosure.errno_, len, nullptr, timeout, "tee" );
+		} // if
+		transferWait( &in, len, timeout, "tee" );
+	} // for
+
+#ifdef __U_STATISTICS__
+	uFetchAdd( UPP::Statistics::read_bytes, tlen );
+	uFetchAdd( UPP::Statistics::write_bytes, tlen );
+#endif // __U_STATISTICS__
+	return tlen;
+} // uFileIO::tee
+
+
+ssize_t uFileIO::vmsplice( const struct iovec *iov, unsigned long int iovcnt, uDuration *timeout ) {
+	int ret;
+	ssize_t vlen;
+
+	struct Vmsplice : public uIOClosure {
+		const struct iovec *iov;
+		unsigned long int iovcnt;
+		ssize_t &vlen;									// number of bytes moved
+
+		int action() {
+			vlen = ::vmsplice( access.fd, iov, iovcnt, SPLICE_F_NONBLOCK );
+			return vlen == -1 ? -1 : 0;
+		} // action
+		Vmsplice( uIOaccess &access, int &ret, const struct iovec *iov, unsigned long int iovcnt, ssize_t &vlen ) :
+			uIOClosure( access, ret ), iov( iov ), iovcnt( iovcnt ), vlen( vlen ) {}
+	} vmspliceClosure( access, ret, iov, iovcnt, vlen );
+
+	for ( ;; ) {
+		vmspliceClosure.wrapper();
+	  if ( ret != -1 ) break;
+		if ( vmspliceClosure.errno_ != U_EWOULDBLOCK ) {
+			writeFailure( vmspliceClosure.errno_, (const char *)iov, iovcnt, timeout, "vmsplice" );
+		} // if
+		transferWait( nullptr, iovcnt, timeout, "vmsplice" );
+	} // for
+
+#ifdef __U_STATISTICS__
+	uFetchAdd( UPP::Statistics::write_bytes, vlen );
+#endif // __U_STATISTICS__
+	return vlen;
+} // uFileIO::vmsplice
+
+
 //######################### FileAccess #########################
 
 
@@ -331,13 +518,22 @@ void uFile::FileAccess::writeTimeout( const char *buf, const int len, const uDur
 } // uFile::FileAccess::writeTimeout
 
 
+// File-system operations that can block the kernel thread are executed by uBlockingCall. Because errno belongs to the
+// kernel thread executing the call, it is copied before returning to the caller's cluster.
+
 void uFile::FileAccess::createAccess( int flags, int mode ) {
-	for ( ;; ) {
-		access.fd = ::open( file->name, flags, mode );
-	  if ( access.fd != -1 || errno != EINTR ) break;	// timer interrupt ?
-	} // for
+	int errno_;
+	access.fd = uBlockingCall( [&]() {
+		int fd;
+		for ( ;; ) {
+			fd = ::open( file->name, flags, mode );
+		  if ( fd != -1 || errno != EINTR ) break;		// timer interrupt ?
+		} // for
+		errno_ = errno;
+		return fd;
+	} );
 	if ( access.fd == -1 ) {
-		_Throw uFile::FileAccess::OpenFailure( *this, errno, flags, mode, "unable to access file" );
+		_Throw uFile::FileAccess::OpenFailure( *this, errno_, flags, mode, "unable to access file" );
 	} // if
 	access.poll.computeStatus( access.fd );
 	if ( access.poll.getStatus() == uPoll::AlwaysPoll ) access.poll.setPollFlag( access.fd );
@@ -364,14 +560,19 @@ uFile::FileAccess::~FileAccess() {
 	file->unaccess();
 	if ( access.poll.getStatus() == uPoll::AlwaysPoll ) access.poll.clearPollFlag( access.fd );
 	if ( access.fd >= 3 ) {								// don't close the standard file descriptors
-		int retcode;
-
-		for ( ;; ) {
-			retcode = ::close( access.fd );
-		  if ( retcode != -1 || errno != EINTR ) break;	// timer interrupt ?
-		} // for
+		int retcode, errno_;
+
+		retcode = uBlockingCall( [&]() {				// close flushes some file systems
+			int ret;
+			for ( ;; ) {
+				ret = ::close( access.fd );
+			  if ( ret != -1 || errno != EINTR ) break;	// timer interrupt ?
+			} // for
+			errno_ = errno;
+			return ret;
+		} );
 		if ( retcode == -1 ) {
-			if ( ! std::__U_UNCAUGHT_EXCEPTION__() ) _Throw uFile::FileAccess::CloseFailure( *this, errno, "unable to terminate access to file" );
+			if ( ! std::__U_UNCAUGHT_EXCEPTION__() ) _Throw uFile::FileAccess::CloseFailure( *this, errno_, "unable to terminate access to file" );
 		} // if
 	} // if
 	if ( own ) delete file;
@@ -399,14 +600,19 @@ off_t uFile::FileAccess::lseek( off_t offset, int whence ) {
 
 
 int uFile::FileAccess::fsync() {
-	int retcode;
+	int retcode, errno_;
 
-	for ( ;; ) {
-		retcode = ::fsync( access.fd );
-	  if ( retcode != -1 || errno != EINTR ) break;		// timer interrupt ?
-	} // for
+	retcode = uBlockingCall( [&]() {
+		int ret;
+		for ( ;; ) {
+			ret = ::fsync( access.fd );
+		  if ( ret != -1 || errno != EINTR ) break;		// timer interrupt ?
+		} // for
+		errno_ = errno;
+		return ret;
+	} );
 	if ( retcode == -1 ) {
-		_Throw uFile::FileAccess::SyncFailure( *this, errno, "could not fsync file" );
+		_Throw uFile::FileAccess::SyncFailure( *this, errno_, "could not fsync file" );
 	} // if
 	return retcode;
 } // uFile::FileAccess::fsync
@@ -473,14 +679,19 @@ const char *uFile::getName() const {
 
 
 void uFile::status( struct stat &buf ) {
-	int retcode;
+	int retcode, errno_;
 
-	for ( ;; ) {
-		retcode = ::stat( name, &buf );
-	  if ( retcode != -1 || errno != EINTR ) break;		// timer interrupt ?
-	} // for
+	retcode = uBlockingCall( [&]() {
+		int ret;
+		for ( ;; ) {
+			ret = ::stat( name, &buf );
+		  if ( ret != -1 || errno != EINTR ) break;		// timer interrupt ?
+		} // for
+		errno_ = errno;
+		return ret;
+	} );
 	if ( retcode == -1 ) {
-		_Throw uFile::StatusFailure( *this, errno, buf, "could not obtain statistical information for file" );
+		_Throw uFile::StatusFailure( *this, errno_, buf, "could not obtain statistical information for file" );
 	} // if
 } // uFile::status
 
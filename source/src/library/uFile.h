@@ -49,6 +49,17 @@ class uFileIO {											// monitor
 	virtual void writeFailure( int errno_, const char *buf, const int len, const uDuration *timeout, const char *const op ) = 0;
 	virtual void writeTimeout( const char *buf, const int len, const uDuration *timeout, const char *const op ) = 0;
 
+	_Mutex int write_( const char *buf, int len, uDuration *timeout ); // write all the data in the monitor
+
+	// Called by write and writev before writing, so a derived class can take over every write to the descriptor, e.g.,
+	// to combine concurrent writers. Returns true with the number of bytes written in wlen if the data was written.
+	virtual bool writeHook( const struct iovec *, int, uDuration *, const char *const, int & ) {
+		return false;
+	} // uFileIO::writeHook
+
+	void transferWait( uFileIO *in, const size_t len, uDuration *timeout, const char *const op );
+	void transferFailure( uFileIO &in, int errno_, const size_t len, loff_t *inoff, uDuration *timeout, const char *const op );
+
 	uFileIO( uIOaccess &acc ) : access( acc ) {
 	} // uFileIO::uFileIO
 
@@ -57,8 +68,18 @@ class uFileIO {											// monitor
   public:
 	int read( char *buf, int len, uDuration *timeout = nullptr );
 	int readv( const struct iovec *iov, int iovcnt, uDuration *timeout = nullptr );
-	_Mutex int write( const char *buf, int len, uDuration *timeout = nullptr );
+	int write( const char *buf, int len, uDuration *timeout = nullptr );
 	int writev( const struct iovec *iov, int iovcnt, uDuration *timeout = nullptr );
+	void writeall( struct iovec *iov, int iovcnt );	// write all the data, iov is modified
+
+	// Zero-copy transfers into this descriptor, which block the task (not the processor) until data can be moved. For
+	// splice, this descriptor or in must be a pipe, and the offsets are used when the corresponding descriptor is a
+	// file; for tee, both must be pipes and the data is copied without being consumed from in; for vmsplice, this
+	// descriptor must be a pipe and the user pages are referenced by the pipe, so they must not be modified until the
+	// data is consumed. Like read, the number of bytes moved is returned, which is 0 at end of file.
+	ssize_t splice( uFileIO &in, size_t len, loff_t *inoff = nullptr, loff_t *outoff = nullptr, uDuration *timeout = nullptr );
+	ssize_t tee( uFileIO &in, size_t len, uDuration *timeout = nullptr );
+	ssize_t vmsplice( const struct iovec *iov, unsigned long int iovcnt, uDuration *timeout = nullptr );
 
 	int fd() {
 		return access.fd;
@@ -112,6 +133,7 @@ class uFile {
 	class FileAccess : public uFileIO {					// monitor
 		template< typename char_t, typename traits > friend class std::basic_filebuf; // access: constructor
 		friend class uSocketIO;							// access: access
+		friend _Task uLogWriter;						// access: constructor
 
 		uFile *file;
 		const bool own;
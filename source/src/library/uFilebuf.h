@@ -34,7 +34,14 @@
 
 #include <uFile.h>
 
+#include <sys/uio.h>									// iovec
+
+// Embedded buffer for standard and descriptor streams, where interactive output is common.
 #define __U_BUFFER_SIZE__ 512
+// Initial buffer for streams opened on a file. The buffer adapts by doubling, up to the maximum buffer size, when
+// consecutive transfers fill it completely, so streaming output/input performs few, large system calls.
+#define __U_FILE_BUFFER_SIZE__ (64 * 1024)
+#define __U_MAX_BUFFER_SIZE__ (4 * 1024 * 1024)
 
 namespace std {
 	template< typename char_t, typename traits >
@@ -67,15 +74,25 @@ namespace std {
 		bool endOfFile;
 		char_type *bufptr;
 		streamsize bufsize;
+		char_type *dynbuf;								// buffer allocated by filebuf, if any
+		streamsize maxbufsize;							// adaptive growth limit, 0 => fixed buffer size
+		unsigned int fills;								// consecutive transfers filling the whole buffer
+
+		enum { GrowAfter = 2 };							// consecutive full transfers before buffer grows
 
 		static int IosToUnixMode( ios_base::openmode mode );
 		static int char_tarToUnixMode( const char *mode );
+
+		void resetbuf( char_type *buf, streamsize size );
+		void adapt( streamsize keep = 0 );
 	  protected:
 		uOwnerLock ownerlock;
 
 		int_type underflow();
 		int_type uflow();
 		int_type overflow( int_type c = EOF );
+		streamsize xsputn( const char_type *s, streamsize n );
+		streamsize xsgetn( char_type *s, streamsize n );
 		basic_filebuf *setbuf( char_type *buf, streamsize size );
 		pos_type seekoff( off_type off, ios_base::seekdir dir, ios_base::openmode which = ios_base::in | ios_base::out );
 		pos_type seekpos( pos_type sp, ios_base::openmode which = ios_base::in | ios_base::out );
@@ -93,6 +110,8 @@ namespace std {
 		basic_filebuf *close();
 
 		int fd();
+		basic_filebuf *setbufsize( streamsize size, streamsize maxsize = 0 ); // owned buffer, adaptive up to maxsize
+		streamsize getbufsize() const { return bufsize; }
 	}; // basic_filebuf
 
 
@@ -155,6 +174,7 @@ namespace std {
 	basic_filebuf<char_t, traits>::basic_filebuf() {
 		ufile = nullptr;
 		ufileacc = nullptr;
+		dynbuf = nullptr;
 		setbuf( buffer, __U_BUFFER_SIZE__ );			// reset all buffer pointers
 		endOfFile = false;
 	} // basic_filebuf<char_t, traits>::basic_filebuf
@@ -165,6 +185,7 @@ namespace std {
 	basic_filebuf<char_t, traits>::basic_filebuf( int fd, int bufsize ) {
 		ufile = new uFile( "/dev/tty" );
 		ufileacc = new uFile::FileAccess( fd, *ufile );
+		dynbuf = nullptr;
 		assert( bufsize <= __U_BUFFER_SIZE__ );
 		setbuf( buffer, bufsize );						// reset all buffer pointers
 		endOfFile = false;
@@ -176,6 +197,7 @@ namespace std {
 	basic_filebuf<char_t, traits>::basic_filebuf( int fd, char *buf, int bufsize ) {
 		ufile = new uFile( "unknown" );
 		ufileacc = new uFile::FileAccess( fd, *ufile );
+		dynbuf = nullptr;
 		setbuf( buf, bufsize );							// reset all buffer pointers
 		endOfFile = false;
 	} // basic_filebuf<char_t, traits>::basic_filebuf
@@ -184,6 +206,7 @@ namespace std {
 	template< typename char_t, typename traits >
 	basic_filebuf<char_t, traits>::~basic_filebuf() {
 		close();
+		delete [] dynbuf;
 	} // basic_filebuf<char_t, traits>::~basic_filebuf
 
 
@@ -201,6 +224,9 @@ namespace std {
 		if ( is_open() ) return nullptr;
 		ufile = new uFile( filename );
 		ufileacc = new uFile::FileAccess( *ufile, IosToUnixMode( mode ) );
+		if ( bufptr == buffer && bufsize == __U_BUFFER_SIZE__ ) { // default buffer ? => large adaptive file buffer
+			setbufsize( __U_FILE_BUFFER_SIZE__, __U_MAX_BUFFER_SIZE__ );
+		} // if
 		if ( mode & ios_base::ate ) {					// seek to the end of the file
 			if ( seekoff( 0, ios_base::end ) == pos_type( off_type( -1 ) ) ) {
 				close();
@@ -244,6 +270,45 @@ namespace std {
 	} // basic_filebuf<char_t, traits>::fd
 
 
+	// non-standard
+	template< typename char_t, typename traits >
+	basic_filebuf<char_t, traits> *basic_filebuf<char_t, traits>::setbufsize( streamsize size, streamsize maxsize ) {
+		if ( sync() == -1 || gptr() != egptr() ) return nullptr; // buffered data cannot be moved
+		if ( size < 2 ) size = 2;						// room for the overflow character
+		char_type *buf = new char_type[size];
+		resetbuf( buf, size );
+		delete [] dynbuf;
+		dynbuf = buf;
+		maxbufsize = maxsize > size ? maxsize : 0;
+		return this;
+	} // basic_filebuf<char_t, traits>::setbufsize
+
+
+	template< typename char_t, typename traits >
+	void basic_filebuf<char_t, traits>::resetbuf( char_type *buf, streamsize size ) {
+		bufptr = buf;
+		bufsize = size;
+		fills = 0;
+		setg( bufptr, bufptr, bufptr );					// reset input buffer pointers
+		setp( bufptr, bufptr + bufsize - 1 );			// reset output buffer pointers
+	} // basic_filebuf<char_t, traits>::resetbuf
+
+
+	// Called after a transfer that filled the whole buffer, where the first keep characters of the buffer are retained
+	// and all buffer pointers are reset.
+	template< typename char_t, typename traits >
+	void basic_filebuf<char_t, traits>::adapt( streamsize keep ) {
+		fills += 1;
+	  if ( maxbufsize == 0 || fills < GrowAfter || bufsize >= maxbufsize ) return;
+		streamsize size = bufsize * 2 < maxbufsize ? bufsize * 2 : maxbufsize;
+		char_type *buf = new char_type[size];
+		memcpy( buf, bufptr, keep * sizeof(char_type) );
+		resetbuf( buf, size );
+		delete [] dynbuf;
+		dynbuf = buf;
+	} // basic_filebuf<char_t, traits>::adapt
+
+
 	// 27.8.1.4 Overridden virtual functions
 
 
@@ -259,6 +324,11 @@ namespace std {
 
 		if ( ! endOfFile ) {
 			rbytes = ufileacc->read( eback(), bufsize );
+			if ( rbytes == bufsize && pptr() == pbase() ) {	// buffer filled ? => consider larger buffer for next read
+				adapt( rbytes );
+			} else {
+				fills = 0;
+			} // if
 		} else {
 			rbytes = 0;
 		} // if
@@ -303,24 +373,81 @@ namespace std {
 		} // for
 
 		setp( pbase(), epptr() );						// reset output buffer pointers
+		if ( c != traits::eof() && gptr() == egptr() ) {	// buffer full rather than flush ?
+			adapt();
+		} else {
+			fills = 0;
+		} // if
 
 		return traits::not_eof( c );
 	} // basic_filebuf<char_t, traits>::overflow
 
 
+	// Transfers at least as large as the buffer bypass it, combining any buffered output and the data into a single
+	// writev.
+	template< typename char_t, typename traits >
+	streamsize basic_filebuf<char_t, traits>::xsputn( const char_type *s, streamsize n ) {
+		if ( n < bufsize || ! is_open() || gptr() != egptr() ) return basic_streambuf<char_t, traits>::xsputn( s, n );
+
+		struct iovec iov[2] = {
+			{ pbase(), (size_t)(pptr() - pbase()) * sizeof(char_type) },
+			{ (void *)s, (size_t)n * sizeof(char_type) }
+		};
+		ufileacc->writeall( iov, 2 );
+		setp( pbase(), epptr() );						// reset output buffer pointers
+		fills = 0;
+		return n;
+	} // basic_filebuf<char_t, traits>::xsputn
+
+
+	// Transfers at least as large as the buffer read directly into the destination, refilling the buffer in the same
+	// readv.
+	template< typename char_t, typename traits >
+	streamsize basic_filebuf<char_t, traits>::xsgetn( char_type *s, streamsize n ) {
+		streamsize avail = egptr() - gptr();
+		if ( n - avail < bufsize || ! is_open() || endOfFile || pptr() != pbase() ) {
+			return basic_streambuf<char_t, traits>::xsgetn( s, n );
+		} // if
+
+		memcpy( s, gptr(), avail * sizeof(char_type) );	// buffered characters first
+		streamsize count = avail;
+		setg( bufptr, bufptr, bufptr );					// reset input buffer pointers
+		while ( count < n ) {
+			struct iovec iov[2] = {
+				{ s + count, (size_t)(n - count) * sizeof(char_type) },
+				{ bufptr, (size_t)bufsize * sizeof(char_type) }
+			};
+			int rbytes = ufileacc->readv( iov, 2 ) / sizeof(char_type);
+			if ( rbytes == 0 ) {						// end of file ?
+				endOfFile = true;
+				break;
+			} // if
+			if ( rbytes > n - count ) {					// buffer partially filled ?
+				setg( bufptr, bufptr, bufptr + (rbytes - (n - count)) );
+				count = n;
+			} else {
+				count += rbytes;
+			} // if
+		} // while
+		fills = 0;
+		return count;
+	} // basic_filebuf<char_t, traits>::xsgetn
+
+
 	template< typename char_t, typename traits >
 	basic_filebuf<char_t, traits> *basic_filebuf<char_t, traits>::setbuf( char_type *buf, streamsize size ) {
 		// It is necessary to have at least one character of storage to hold the last character read by underflow.
 		// Having one character also simplifies the implementation of overflow.
 		if ( buf == nullptr || size == 0 ) {
-			bufptr = buffer;
-			bufsize = 1;
+			resetbuf( buffer, 1 );
 		} else {
-			bufptr = buf;
-			bufsize = size;
+			resetbuf( buf, size );
 		} // if
-		setg( bufptr, bufptr, bufptr );					// reset input buffer pointers
-		setp( bufptr, bufptr + bufsize - 1 );			// reset output buffer pointers
+		if ( dynbuf != nullptr ) {						// release filebuf buffer
+			delete [] dynbuf;
+			dynbuf = nullptr;
+		} // if
+		maxbufsize = 0;									// user controls buffer size
 		uDEBUGPRT( uDebugPrt( "setbuf(), eback:%p, gptr:%p, egptr:%p, pbase:%p, pptr:%p, epptr:%p, len:%ld\n", eback(), gptr(), egptr(), pbase(), pptr(), epptr(), (long int)(pptr() - pbase()) ); );
 		return this;
 	} // basic_filebuf<char_t, traits>::setbuf
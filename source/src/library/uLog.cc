@@ -0,0 +1,315 @@
+//                              -*- Mode: C++ -*-
+//
+// uC++ Version 7.0.0, Copyright (C) Peter A. Buhr 2026
+//
+// uLog.cc --
+//
+// Author           : agent
+// Created On       : Mon Oct 19 00:23:51 2026
+// Last Modified By : agent
+// Last Modified On : Mon Oct 19 06:14:17 2026
+// Update Count     : 3
+//
+// This  library is free  software; you  can redistribute  it and/or  modify it
+// under the terms of the GNU Lesser General Public License as published by the
+// Free Software  Foundation; either  version 2.1 of  the License, or  (at your
+// option) any later version.
+//
+// This library is distributed in the  hope that it will be useful, but WITHOUT
+// ANY  WARRANTY;  without even  the  implied  warranty  of MERCHANTABILITY  or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+// for more details.
+//
+// You should  have received a  copy of the  GNU Lesser General  Public License
+// along  with this library.
+//
+
+
+#define __U_KERNEL__
+#include <uC++.h>
+#include <uFile.h>
+#include <uLog.h>
+
+//#include <uDebug.h>
+
+#include <cstring>										// memcpy
+#include <cerrno>										// errno
+#include <unistd.h>										// write, STDERR_FILENO
+#include <sys/uio.h>									// iovec
+
+
+// Ring buffer for records appended on one uProcessor. Positions increase monotonically and are reduced modulo the
+// power-of-two size. Only the processor's tasks advance tail, with interrupts disabled, and only the writer advances
+// head. Buffers are freed only when the log is closed, so the writer can traverse the list without synchronizing
+// with processor deletion.
+
+struct uLogBuffer {
+	uLogBuffer * next;									// list of all buffers
+	char * data;
+	size_t size;										// power of 2
+	volatile size_t head;								// next byte to write
+	volatile size_t tail;								// next byte to append
+
+	uLogBuffer( size_t size ) : next( nullptr ), data( new char[size] ), size( size ), head( 0 ), tail( 0 ) {}
+}; // uLogBuffer
+
+_Task uLogWriter;
+
+static uLogBuffer * volatile buffers = nullptr;			// all processor buffers, push only
+static uLogWriter * volatile writer = nullptr;			// nullptr => log closed
+static size_t bufferSize = uLog::DefaultBufferSize;
+
+
+//######################### uLogWriter #########################
+
+
+_Task uLogWriter {
+	enum { IOVMax = 64 };								// vectors per writev
+
+	uFile file;
+	uFile::FileAccess access;
+	uDuration interval;
+	UPP::uSemaphore wakeup;
+	uOwnerLock lock;									// protect pass counters
+	uOwnerLock output;									// serialize writes by passes and oversized records
+	uCondLock passed;
+	unsigned long int started, completed;				// pass counters
+	bool done;
+
+	void main();
+  public:
+	uLogWriter( int fd, uDuration interval ) : file( "log" ), access( fd, file ), interval( interval ), wakeup( 0 ), started( 0 ), completed( 0 ), done( false ) {}
+
+	_Nomutex void wake() { wakeup.V(); }
+	_Nomutex void flush();
+	_Nomutex void stop() { done = true; wake(); }
+	_Nomutex void pass();
+	_Nomutex void write( const char * data, size_t len ) { // record larger than a buffer
+		struct iovec iov = { (void *)data, len };
+		output.acquire();								// partial writes must not interleave with a pass
+		access.writeall( &iov, 1 );
+		output.release();
+	} // uLogWriter::write
+}; // uLogWriter
+
+
+// Gather the records in all buffers into as few writev calls as possible. Buffer space is released after the write so
+// producers cannot overwrite data being written.
+void uLogWriter::pass() {
+	lock.acquire();
+	started += 1;
+	unsigned long int pass = started;
+	lock.release();
+
+	struct iovec iov[IOVMax];
+	uLogBuffer * written[IOVMax / 2];
+	size_t tails[IOVMax / 2];
+	int iovcnt = 0, bufcnt = 0;
+
+	output.acquire();
+	for ( uLogBuffer * b = __atomic_load_n( &buffers, __ATOMIC_ACQUIRE ); ; b = b->next ) {
+		if ( ( b == nullptr && bufcnt != 0 ) || bufcnt == IOVMax / 2 ) { // write batch
+			access.writeall( iov, iovcnt );
+			for ( int i = 0; i < bufcnt; i += 1 ) {
+				__atomic_store_n( &written[i]->head, tails[i], __ATOMIC_RELEASE ); // release buffer space
+			} // for
+			iovcnt = bufcnt = 0;
+		} // if
+	  if ( b == nullptr ) break;
+		size_t head = b->head, tail = __atomic_load_n( &b->tail, __ATOMIC_ACQUIRE );
+	  if ( head == tail ) continue;						// empty ?
+		size_t start = head & (b->size - 1), len = tail - head;
+		size_t first = len < b->size - start ? len : b->size - start;
+		iov[iovcnt] = { b->data + start, first };
+		iovcnt += 1;
+		if ( len > first ) {							// wrap around ?
+			iov[iovcnt] = { b->data, len - first };
+			iovcnt += 1;
+		} // if
+		written[bufcnt] = b;
+		tails[bufcnt] = tail;
+		bufcnt += 1;
+	} // for
+	output.release();
+
+	lock.acquire();
+	completed = pass;
+	passed.broadcast();
+	lock.release();
+} // uLogWriter::pass
+
+
+void uLogWriter::flush() {
+	lock.acquire();
+	unsigned long int target = started + 1;				// a pass starting now covers all previous records
+	wake();
+	while ( completed < target ) passed.wait( lock );
+	lock.release();
+} // uLogWriter::flush
+
+
+void uLogWriter::main() {
+	for ( ;; ) {
+		wakeup.P( interval );							// woken by a producer or write periodically
+		pass();
+	  if ( done ) break;
+	} // for
+} // uLogWriter::main
+
+
+//######################### uLog #########################
+
+
+uLog::Record::Record() : buf( inlineBuf ), size( InlineSize ) {
+	setp( buf, buf + size );
+} // uLog::Record::Record
+
+
+uLog::Record::~Record() {
+	if ( buf != inlineBuf ) delete [] buf;
+} // uLog::Record::~Record
+
+
+uLog::Record::int_type uLog::Record::overflow( int_type c ) {
+	if ( c == traits_type::eof() ) return traits_type::not_eof( c );
+	size_t len = length();
+	char * nbuf = new char[size * 2];
+	memcpy( nbuf, buf, len );
+	if ( buf != inlineBuf ) delete [] buf;
+	buf = nbuf;
+	size *= 2;
+	setp( buf, buf + size );
+	pbump( len );
+	*pptr() = c;
+	pbump( 1 );
+	return c;
+} // uLog::Record::overflow
+
+
+uLog::uLog() : std::ostream( nullptr ) {
+	rdbuf( &record );									// record constructed after base class
+} // uLog::uLog
+
+
+uLog::~uLog() {
+	if ( record.length() != 0 ) append( record.data(), record.length() );
+} // uLog::~uLog
+
+
+void uLog::append( const char * data, size_t len ) {
+	uLogWriter * w = writer;
+	if ( w == nullptr ) {								// log closed ?
+		writeDirect( STDERR_FILENO, data, len );
+		return;
+	} // if
+
+	for ( ;; ) {
+		// Interrupts are disabled so the task cannot migrate or be preempted by another task on this processor while
+		// appending, making each processor buffer single producer.
+		uKernelModule::uKernelModuleData::disableInterrupts();
+		uLogBuffer * b = uThisProcessor().logBuffer;
+		if ( UNLIKELY( b == nullptr ) ) {				// first record on this processor ?
+			uKernelModule::uKernelModuleData::enableInterrupts();
+			uLogBuffer * nb = new uLogBuffer( bufferSize );
+			uKernelModule::uKernelModuleData::disableInterrupts();
+			uProcessor & processor = uThisProcessor();	// task may have migrated
+			if ( processor.logBuffer == nullptr ) {
+				processor.logBuffer = nb;
+				nb->next = buffers;
+				while ( ! uCompareAssignValue( buffers, nb->next, nb ) ); // push, failure updates nb->next
+				nb = nullptr;
+			} // if
+			uKernelModule::uKernelModuleData::enableInterrupts();
+			if ( nb != nullptr ) {						// another task installed a buffer
+				delete [] nb->data;
+				delete nb;
+			} // if
+			continue;
+		} // if
+
+		if ( UNLIKELY( len > b->size ) ) {				// record cannot fit ?
+			uKernelModule::uKernelModuleData::enableInterrupts();
+			w->flush();									// previous records from all processors first
+			w->write( data, len );
+			return;
+		} // if
+
+		size_t tail = b->tail, used = tail - __atomic_load_n( &b->head, __ATOMIC_ACQUIRE );
+		if ( LIKELY( b->size - used >= len ) ) {		// room ?
+			size_t start = tail & (b->size - 1);
+			size_t first = len < b->size - start ? len : b->size - start;
+			memcpy( b->data + start, data, first );
+			memcpy( b->data, data + first, len - first ); // wrap around
+			__atomic_store_n( &b->tail, tail + len, __ATOMIC_RELEASE ); // publish complete record
+			uKernelModule::uKernelModuleData::enableInterrupts();
+			if ( used < b->size / 2 && used + len >= b->size / 2 ) w->wake(); // half full ? => write early
+			return;
+		} // if
+		uKernelModule::uKernelModuleData::enableInterrupts();
+
+		w->flush();										// buffer full => block until writer drains it
+	} // for
+} // uLog::append
+
+
+// Write a record without the writer task. The record is normally written by a single write, so records from different
+// tasks do not interleave. Like uFileIO::write, EIO discards the output.
+void uLog::writeDirect( int fd, const char * data, size_t len ) {
+	for ( size_t count = 0; count < len; ) {
+		ssize_t wlen = ::write( fd, data + count, len - count );
+		if ( wlen == -1 ) {
+		  if ( errno == EINTR ) continue;
+			break;										// EIO => output discarded
+		} // if
+		count += wlen;
+	} // for
+} // uLog::writeDirect
+
+
+void uLog::open( int fd, size_t bufferSize, uDuration interval ) {
+	if ( writer != nullptr ) {
+		abort( "uLog::open : attempt to open log when already open." );
+	} // if
+	size_t size = 1024;
+	while ( size < bufferSize ) size *= 2;				// power of 2 for modulo by masking
+	::bufferSize = size;
+	writer = new uLogWriter( fd, interval );
+} // uLog::open
+
+
+void uLog::flush() {
+	uLogWriter * w = writer;
+	if ( w != nullptr ) w->flush();
+} // uLog::flush
+
+
+void uLog::close() {
+	uLogWriter * w = writer;
+  if ( w == nullptr ) return;
+	writer = nullptr;									// subsequent records written directly
+	w->stop();											// final pass writes remaining records
+	delete w;
+
+	uKernelModule::globalProcessorLock->acquire();		// detach buffers from processors
+	for ( uProcessorDL * p = uKernelModule::globalProcessors->head(); p != nullptr; p = uKernelModule::globalProcessors->succ( p ) ) {
+		p->processor().logBuffer = nullptr;
+	} // for
+	uKernelModule::globalProcessorLock->release();
+	for ( uLogBuffer * b = buffers; b != nullptr; ) {
+		uLogBuffer * next = b->next;
+		delete [] b->data;
+		delete b;
+		b = next;
+	} // for
+	buffers = nullptr;
+} // uLog::close
+
+
+bool uLog::isOpen() {
+	return writer != nullptr;
+} // uLog::isOpen
+
+
+// Local Variables: //
+// compile-command: "make install" //
+// End: //
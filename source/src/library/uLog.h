@@ -0,0 +1,88 @@
+//                              -*- Mode: C++ -*-
+//
+// uC++ Version 7.0.0, Copyright (C) Peter A. Buhr 2026
+//
+// uLog.h -- Asynchronous logging with per-processor buffers.
+//
+// Author           : agent
+// Created On       : Mon Oct 19 00:23:51 2026
+// Last Modified By : agent
+// Last Modified On : Mon Oct 19 04:59:06 2026
+// Update Count     : 2
+//
+// This  library is free  software; you  can redistribute  it and/or  modify it
+// under the terms of the GNU Lesser General Public License as published by the
+// Free Software  Foundation; either  version 2.1 of  the License, or  (at your
+// option) any later version.
+//
+// This library is distributed in the  hope that it will be useful, but WITHOUT
+// ANY  WARRANTY;  without even  the  implied  warranty  of MERCHANTABILITY  or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+// for more details.
+//
+// You should  have received a  copy of the  GNU Lesser General  Public License
+// along  with this library.
+//
+
+
+#pragma once
+
+
+#include <ostream>
+#include <streambuf>
+
+
+// A uLog object is an output stream for one log record, e.g.:
+//
+//   uLog() << "task " << id << " value " << v << endl;
+//
+// The record is formatted into storage local to the uLog object, so formatting is not serialized. When the uLog object
+// is destroyed, the complete record is copied into a buffer belonging to the executing uProcessor, which is a
+// single-producer/single-consumer ring: the producer side is non-preemptive so tasks on the same processor never
+// interleave, and the consumer is a writer task that periodically gathers the records from all processor buffers into
+// large writev calls. Records are never split or interleaved, but records are ordered only among those appended on the
+// same processor. Producers only block when their processor's buffer is full, until the writer drains it. When no log
+// is open, each record is written directly to standard error with a single write.
+
+class uLog : public std::ostream {
+	class Record : public std::streambuf {				// storage for formatting one record
+		enum { InlineSize = 256 };
+		char inlineBuf[InlineSize];
+		char * buf;
+		size_t size;
+	  protected:
+		int_type overflow( int_type c );
+	  public:
+		Record();
+		~Record();
+		const char * data() const { return pbase(); }
+		size_t length() const { return pptr() - pbase(); }
+	}; // Record
+
+	Record record;
+
+	static void append( const char * data, size_t len );
+	static void writeDirect( int fd, const char * data, size_t len );
+  public:
+	uLog( const uLog & ) = delete;						// no copy
+	uLog( uLog && ) = delete;
+	uLog & operator=( const uLog & ) = delete;			// no assignment
+	uLog & operator=( uLog && ) = delete;
+
+	uLog();
+	~uLog();											// append record to log
+
+	enum { DefaultBufferSize = 64 * 1024 };				// bytes per processor buffer
+	enum { DefaultInterval = 10 };						// milliseconds between writes when idle
+
+	// Start the writer task for file descriptor fd. Descriptors other than the standard ones are closed by close.
+	static void open( int fd = 2, size_t bufferSize = DefaultBufferSize, uDuration interval = uDuration( 0, DefaultInterval * 1000000 ) );
+	static void flush();								// wait until records appended before the call are written
+	static void close();								// flush and stop the writer; producers must have stopped logging
+	static bool isOpen();
+}; // uLog
+
+
+// Local Variables: //
+// compile-command: "make install" //
+// End: //
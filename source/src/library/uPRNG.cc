@@ -29,6 +29,9 @@
 #define __U_KERNEL__
 #include <uC++.h>
 #include <uPRNG.h>
+#include <cstring>										// memcpy
+#include <limits>										// numeric_limits
+#include <type_traits>									// is_floating_point
 
 //=========================================================
 
@@ -47,6 +50,134 @@ size_t get_seed() { return uBaseTask::thread_random_seed; }
 size_t prng() { return PRNG_NAME( uThisTask().random_state ); }
 
 
+//=========================================================
+
+
+// Bulk generation runs interleaved xoshiro streams held in the lanes of a 512-bit vector, so one step of all the
+// streams is a few vector instructions. The streams are seeded with splitmix from one value of the PRNG, as is done for
+// a single stream. The fill routines are cloned for AVX-512 and AVX2, where the vector is one or two registers, and the
+// clone for the processor is selected when the program is loaded.
+
+#if defined( __x86_64__ ) && defined( __has_attribute )
+#if __has_attribute( target_clones )
+#define PRNG_FILL_CLONES __attribute__(( target_clones( "avx512f", "avx2", "default" ) ))
+#endif // __has_attribute
+#endif // __x86_64__
+#ifndef PRNG_FILL_CLONES
+#define PRNG_FILL_CLONES
+#endif // ! PRNG_FILL_CLONES
+
+namespace {
+	typedef uint64_t U64x8 __attribute__(( vector_size( 64 ) ));
+	typedef uint32_t U32x16 __attribute__(( vector_size( 64 ) ));
+
+	// One step of xoshiro256++ (A, B, C = 23, 17, 45) or xoshiro128++ (7, 9, 11) in each lane.
+	template< typename V, int A, int B, int C > inline __attribute__(( always_inline )) void xoshiropp( V s[4], V & result ) {
+		enum { Bits = sizeof(s[0][0]) * 8 };
+		V sum = s[0] + s[3];
+		result = ((sum << A) | (sum >> (Bits - A))) + s[0];
+		const V t = s[1] << B;
+
+		s[2] ^= s[0];
+		s[3] ^= s[1];
+		s[1] ^= s[2];
+		s[0] ^= s[3];
+		s[2] ^= t;
+		s[3] = (s[3] << C) | (s[3] >> (Bits - C));
+	} // xoshiropp
+
+	// A floating-point value is made from the high-order bits of a random value as the mantissa of a value in [1,2),
+	// less 1, giving a value in [0,1) without an integer conversion, which has no vector instruction before AVX512DQ.
+	template< typename V, int A, int B, int C, typename T > inline __attribute__(( always_inline ))
+	void xoshiro_fill( uint64_t seed, T buf[], size_t n ) {
+		enum { Lanes = sizeof(V) / sizeof(T), Bits = sizeof(T) * 8, Mantissa = std::numeric_limits<T>::digits - 1 };
+		typedef T TV __attribute__(( vector_size( sizeof(V) ) ));
+		typedef std::remove_reference_t<decltype( V{}[0] )> E;	// lane type
+		V s[4];
+		for ( unsigned int l = 0; l < Lanes; l += 1 ) {	// seed each stream
+			for ( unsigned int i = 0; i < 4; i += 1 ) s[i][l] = splitmix64( seed );
+		} // for
+
+		for ( size_t i = 0; i < n; i += Lanes ) {
+			V v;
+			TV r;
+			xoshiropp<V, A, B, C>( s, v );
+			if constexpr ( std::is_floating_point<T>::value ) {
+				const V one = V{} + ((E)(std::numeric_limits<T>::max_exponent - 1) << Mantissa); // 1.0
+				r = (TV)((v >> (Bits - Mantissa)) | one) - 1;
+			} else {
+				r = v;
+			} // if
+			if ( __builtin_expect( n - i >= size_t(Lanes), true ) ) {
+				memcpy( &buf[i], &r, sizeof(r) );		// unaligned store
+			} else {									// remainder
+				memcpy( &buf[i], &r, (n - i) * sizeof(T) );
+			} // if
+		} // for
+	} // xoshiro_fill
+
+	PRNG_FILL_CLONES void fill64( uint64_t seed, uint64_t buf[], size_t n ) {
+		xoshiro_fill<U64x8, 23, 17, 45>( seed, buf, n );
+	} // fill64
+
+	PRNG_FILL_CLONES void fill64( uint64_t seed, double buf[], size_t n ) {
+		xoshiro_fill<U64x8, 23, 17, 45>( seed, buf, n );
+	} // fill64
+
+	PRNG_FILL_CLONES void fill32( uint64_t seed, uint32_t buf[], size_t n ) {
+		xoshiro_fill<U32x16, 7, 9, 11>( seed, buf, n );
+	} // fill32
+
+	PRNG_FILL_CLONES void fill32( uint64_t seed, float buf[], size_t n ) {
+		xoshiro_fill<U32x16, 7, 9, 11>( seed, buf, n );
+	} // fill32
+} // namespace
+
+
+void PRNG64::fill( uint64_t buf[], size_t n ) {
+	callcnt += n;
+	fill64( PRNG_NAME_64( state ), buf, n );
+} // PRNG64::fill
+
+void PRNG64::fill( uint64_t buf[], size_t n, uint64_t u ) {
+	fill( buf, n );
+	for ( size_t i = 0; i < n; i += 1 ) buf[i] %= u;	// same mapping as operator()( u )
+} // PRNG64::fill
+
+void PRNG64::fill( uint64_t buf[], size_t n, uint64_t l, uint64_t u ) {
+	fill( buf, n, u - l + 1 );
+	for ( size_t i = 0; i < n; i += 1 ) buf[i] += l;
+} // PRNG64::fill
+
+void PRNG64::fill( double buf[], size_t n ) {
+	callcnt += n;
+	fill64( PRNG_NAME_64( state ), buf, n );
+} // PRNG64::fill
+
+
+void PRNG32::fill( uint32_t buf[], size_t n ) {
+	callcnt += n;
+	uint64_t seed = PRNG_NAME_32( state );
+	fill32( seed << 32 | PRNG_NAME_32( state ), buf, n );
+} // PRNG32::fill
+
+void PRNG32::fill( uint32_t buf[], size_t n, uint32_t u ) {
+	fill( buf, n );
+	for ( size_t i = 0; i < n; i += 1 ) buf[i] %= u;	// same mapping as operator()( u )
+} // PRNG32::fill
+
+void PRNG32::fill( uint32_t buf[], size_t n, uint32_t l, uint32_t u ) {
+	fill( buf, n, u - l + 1 );
+	for ( size_t i = 0; i < n; i += 1 ) buf[i] += l;
+} // PRNG32::fill
+
+void PRNG32::fill( float buf[], size_t n ) {
+	callcnt += n;
+	uint64_t seed = PRNG_NAME_32( state );
+	fill32( seed << 32 | PRNG_NAME_32( state ), buf, n );
+} // PRNG32::fill
+
+
 // Local Variables: //
 // compile-command: "make install" //
 // End: //
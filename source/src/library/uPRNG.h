@@ -29,6 +29,7 @@
 #pragma once
 
 #include <cstdint>										// uint32_t
+#include <cstddef>										// size_t
 
 // Sequential Pseudo Random-Number Generator : generate repeatable sequence of values that appear random.
 //
@@ -42,12 +43,20 @@
 //   sprng( u ) - generate random value in range [0,u)
 //   sprng( l, u ) - generate random value in range [l,u]
 //   sprng.calls() - number of generated random value so far
+//   sprng.fill( buf, n ) - fill buf with n random values in range [0,UINT_MAX]
+//   sprng.fill( buf, n, u ) - fill buf with n random values in range [0,u)
+//   sprng.fill( buf, n, l, u ) - fill buf with n random values in range [l,u]
+//   sprng.fill( fbuf, n ) - fill floating-point buf with n random values in range [0,1)
 //
 // Examples : generate random number between 5-21
 //   sprng() % 17 + 5;	values 0-16 + 5 = 5-21
 //   sprng( 16 + 1 ) + 5;
 //   sprng( 5, 21 );
 //   sprng.calls();
+//   sprng.fill( buf, 1000, 5, 21 );
+//
+// fill generates values with several interleaved streams, whose seeds are generated by the PRNG, so the values differ
+// from calling the PRNG n times but are repeatable for a given seed.
 
 class PRNG32 {
 	uint32_t callcnt = 0;
@@ -65,6 +74,10 @@ class PRNG32 {
 	uint32_t operator()( uint32_t u ) __attribute__(( warn_unused_result )) { return operator()() % u; } // [0,u)
 	uint32_t operator()( uint32_t l, uint32_t u ) __attribute__(( warn_unused_result )) { return operator()( u - l + 1 ) + l; } // [l,u]
 	uint32_t calls() const __attribute__(( warn_unused_result )) { return callcnt; }
+	void fill( uint32_t buf[], size_t n );				// [0,UINT_MAX]
+	void fill( uint32_t buf[], size_t n, uint32_t u );	// [0,u)
+	void fill( uint32_t buf[], size_t n, uint32_t l, uint32_t u ); // [l,u]
+	void fill( float buf[], size_t n );					// [0,1)
 	void copy( PRNG32 & src ) { *this = src; }			// checkpoint PRNG state
 }; // PRNG32
 
@@ -84,6 +97,10 @@ class PRNG64 {
 	uint64_t operator()( uint64_t u ) __attribute__(( warn_unused_result )) { return operator()() % u; } // [0,u)
 	uint64_t operator()( uint64_t l, uint64_t u ) __attribute__(( warn_unused_result )) { return operator()( u - l + 1 ) + l; } // [l,u]
 	uint64_t calls() const __attribute__(( warn_unused_result )) { return callcnt; }
+	void fill( uint64_t buf[], size_t n );				// [0,UINT_MAX]
+	void fill( uint64_t buf[], size_t n, uint64_t u );	// [0,u)
+	void fill( uint64_t buf[], size_t n, uint64_t l, uint64_t u ); // [l,u]
+	void fill( double buf[], size_t n );					// [0,1)
 	void copy( PRNG64 & src ) { *this = src; }			// checkpoint PRNG state
 }; // PRNG64
 
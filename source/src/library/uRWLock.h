@@ -126,6 +126,93 @@ class uRWLock {
 }; // uRWLock
 
 
+// Reader-biased readers/writer lock (BRAVO, Dice and Kogan, USENIX ATC 2019). While the lock is biased to readers, a
+// reader announces itself in a slot chosen by hashing its task, writing only that slot's cache line instead of the
+// shared reader count in uRWLock, so read acquires on different processors do not contend. A writer revokes the bias,
+// acquires the underlying uRWLock and waits for the slots to drain. Because revocation is expensive, readers do not
+// restore the bias until Inhibit times the last revocation time has passed. A reader that finds its slot taken uses the
+// underlying lock, so a slot is keyed by task rather than processor, and a task may migrate while holding the lock.
+// Like uRWLock, reads must not nest: a nested read finds the task's own slot taken and blocks on the underlying lock
+// behind a writer that is waiting for that slot to drain.
+
+template< unsigned int Slots = 64 > class uBiasedRWLock {
+	static_assert( Slots != 0 && (Slots & (Slots - 1)) == 0, "uBiasedRWLock slots must be a power of 2" );
+	enum { Inhibit = 9 };								// bias restored after Inhibit times revocation time
+
+	struct __attribute__(( aligned( 64 ) )) Slot {		// cache line per slot
+		uBaseTask * volatile reader;
+	}; // Slot
+
+	volatile bool rbias;								// readers use slots
+	uTime inhibit;										// bias not restored before this time (uClock::monoTime)
+	Slot slots[Slots];
+	uRWLock rwlock;										// writers, and readers while bias revoked
+
+	static Slot & slot( Slot * slots, uBaseTask & task ) {
+		return slots[((uint64_t)(uintptr_t)&task * 0x9e3779b97f4a7c15) >> 40 & (Slots - 1)]; // Fibonacci hash
+	} // uBiasedRWLock::slot
+  public:
+	uBiasedRWLock( const uBiasedRWLock & ) = delete;	// no copy
+	uBiasedRWLock( uBiasedRWLock && ) = delete;
+	uBiasedRWLock & operator=( const uBiasedRWLock & ) = delete; // no assignment
+	uBiasedRWLock & operator=( uBiasedRWLock && ) = delete;
+
+	uBiasedRWLock() : rbias( true ) {
+		for ( unsigned int i = 0; i < Slots; i += 1 ) slots[i].reader = nullptr;
+	} // uBiasedRWLock::uBiasedRWLock
+
+	bool biased() const { return rbias; }
+
+	void rdacquire() {
+		uBaseTask & task = uThisTask();					// optimization
+		if ( rbias ) {									// fast path ?
+			Slot & s = slot( slots, task );
+			#ifdef __U_DEBUG__
+			if ( s.reader == &task ) abort( "(uBiasedRWLock &)%p.rdacquire() : nested read acquire deadlocks with a writer.", this );
+			#endif // __U_DEBUG__
+			uBaseTask * empty = nullptr;
+			if ( __atomic_compare_exchange_n( &s.reader, &empty, &task, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED ) ) {
+			  if ( __atomic_load_n( &rbias, __ATOMIC_SEQ_CST ) ) return; // writer did not revoke bias ?
+				__atomic_store_n( &s.reader, nullptr, __ATOMIC_RELEASE ); // writer may be draining
+			} // if
+		} // if
+		rwlock.rdacquire();
+		if ( ! rbias && uClock::monoTime() >= inhibit ) { // no writer while reading, so restore bias
+			__atomic_store_n( &rbias, true, __ATOMIC_SEQ_CST );
+		} // if
+	} // uBiasedRWLock::rdacquire
+
+	void rdrelease() {
+		uBaseTask & task = uThisTask();					// optimization
+		Slot & s = slot( slots, task );
+		if ( s.reader == &task ) {						// fast path ?
+			__atomic_store_n( &s.reader, nullptr, __ATOMIC_RELEASE );
+		} else {
+			rwlock.rdrelease();
+		} // if
+	} // uBiasedRWLock::rdrelease
+
+	void wracquire() {
+		rwlock.wracquire();
+		if ( rbias ) {									// revoke bias and drain slots
+			__atomic_store_n( &rbias, false, __ATOMIC_SEQ_CST );
+			uTime start = uClock::monoTime();
+			for ( unsigned int i = 0; i < Slots; i += 1 ) {
+				while ( __atomic_load_n( &slots[i].reader, __ATOMIC_ACQUIRE ) != nullptr ) {
+					uThisTask().yield();				// reader may be on this processor
+				} // while
+			} // for
+			uTime now = uClock::monoTime();
+			inhibit = now + (now - start) * Inhibit;
+		} // if
+	} // uBiasedRWLock::wracquire
+
+	void wrrelease() {
+		rwlock.wrrelease();
+	} // uBiasedRWLock::wrrelease
+}; // uBiasedRWLock
+
+
 // Local Variables: //
 // compile-command: "make install" //
 // End: //
@@ -35,6 +35,8 @@
 #include <cstring>										// strerror, memset
 #include <unistd.h>										// read, write, close, etc.
 #include <sys/sendfile.h>
+#include <linux/errqueue.h>								// sock_extended_err
+#include <sys/epoll.h>
 
 #ifndef SUN_LEN
 #define SUN_LEN(su) (sizeof(*(su)) - sizeof((su)->sun_path) + strlen((su)->sun_path))
@@ -156,7 +158,323 @@ void uSocket::CloseFailure::defaultTerminate() {
 //######################### uSocketIO #########################
 
 
+// Queue the request and either wait for another task to send it or, if no task is sending, send queued data until the
+// request is sent. A waiting task is also woken when it must take over sending the queued data.
+void uSocketIO::combineWrite( CombineReq &req ) {
+	combineLock.acquire();
+	combineQueue.addTail( &req );
+	if ( flushing ) {									// another task sending ?
+		combineLock.release();
+		req.wait.P();									// request sent or take over sending
+	} else {
+		flushing = true;
+		combineLock.release();
+	} // if
+	if ( ! req.done ) combineFlush( req );
+} // uSocketIO::combineWrite
+
+
+void uSocketIO::combineFlush( CombineReq &self ) {
+	int slen;
+	struct iovec iov[CombineIOVMax];
+	struct msghdr msg;
+	memset( &msg, 0, sizeof(msg) );
+	msg.msg_iov = iov;
+
+	struct Sendmsg : public uIOClosure {
+		const struct msghdr *msg;
+		int flags;
+
+		int action() { return ::sendmsg( access.fd, msg, flags ); }
+		Sendmsg( uIOaccess &access, int &slen, const struct msghdr *msg ) : uIOClosure( access, slen ), msg( msg ), flags( 0 ) {}
+	} sendmsgClosure( access, slen, &msg );
+
+	for ( ;; ) {
+		// Requests are only removed by the sending task, so the batch remains valid after releasing the lock.
+		combineLock.acquire();
+		CombineReq *first = combineQueue.head();
+		int iovcnt = 0, reqs = 0;
+		for ( CombineReq *r = first; r != nullptr && iovcnt < CombineIOVMax && r->flags == first->flags; r = combineQueue.succ( r ) ) {
+			size_t skip = r->written;					// unsent data of request, which may not all fit
+			for ( int i = 0; i < r->iovcnt && iovcnt < CombineIOVMax; i += 1 ) {
+			  if ( skip >= r->iov[i].iov_len ) { skip -= r->iov[i].iov_len; continue; } // sent or empty vector
+				iov[iovcnt].iov_base = (char *)r->iov[i].iov_base + skip;
+				iov[iovcnt].iov_len = r->iov[i].iov_len - skip;
+				skip = 0;
+				iovcnt += 1;
+			} // for
+			reqs += 1;
+		} // for
+		combineLock.release();
+
+		msg.msg_iovlen = iovcnt;
+		sendmsgClosure.flags = first->flags;
+		sendmsgClosure.wrapper();
+		bool timedout = false;
+		if ( slen == -1 && sendmsgClosure.errno_ == U_EWOULDBLOCK ) {
+			timedout = ! sendmsgClosure.select( uCluster::WriteSelect, self.timeout );
+		} // if
+
+		CombineReq *completed[CombineIOVMax], *successor = nullptr;
+		int ncompleted = 0;
+		bool finished = false;
+		combineLock.acquire();
+		for ( int i = 0; i < reqs; i += 1 ) {			// remove sent or failed requests
+			CombineReq *r = combineQueue.head();
+			if ( slen == -1 ) {							// batch failed
+				r->timedout = timedout;
+				r->errno_ = sendmsgClosure.errno_;
+			} else {
+				int w = slen < r->len - r->written ? slen : r->len - r->written;
+				r->written += w;
+				slen -= w;
+			  if ( r->written != r->len ) break;		// partially sent
+			} // if
+			combineQueue.dropHead();
+			completed[ncompleted] = r;
+			ncompleted += 1;
+			if ( r == &self ) finished = true;
+		} // for
+		if ( finished ) {
+			if ( combineQueue.empty() ) {
+				flushing = false;
+			} else {
+				successor = combineQueue.head();		// waiting task takes over sending
+			} // if
+		} // if
+		combineLock.release();
+
+		// A woken task may delete its request, so it is not accessed after being woken.
+		for ( int i = 0; i < ncompleted; i += 1 ) {
+			completed[i]->done = true;
+			if ( completed[i] != &self ) completed[i]->wait.V();
+		} // for
+		if ( successor != nullptr ) successor->wait.V();
+	  if ( finished ) break;
+	} // for
+} // uSocketIO::combineFlush
+
+
+// Harvest one zero-copy completion message from the error queue, which reports a range of send sequence numbers.
+bool uSocketIO::zerocopyReap() {
+#ifdef SO_ZEROCOPY
+	char control[CMSG_SPACE(sizeof(struct sock_extended_err) + sizeof(struct sockaddr_in6))];
+	struct msghdr msg;
+	memset( &msg, 0, sizeof(msg) );
+	msg.msg_control = control;
+	msg.msg_controllen = sizeof(control);
+
+	int ret;
+	for ( ;; ) {
+		ret = ::recvmsg( access.fd, &msg, MSG_ERRQUEUE );
+	  if ( ret != -1 || errno != EINTR ) break;			// timer interrupt ?
+	} // for
+  if ( ret == -1 ) return false;						// EAGAIN => no completions
+	for ( struct cmsghdr *cm = CMSG_FIRSTHDR( &msg ); cm != nullptr; cm = CMSG_NXTHDR( &msg, cm ) ) {
+		if ( ! ( ( cm->cmsg_level == SOL_IP && cm->cmsg_type == IP_RECVERR ) ||
+				 ( cm->cmsg_level == SOL_IPV6 && cm->cmsg_type == IPV6_RECVERR ) ) ) continue;
+		struct sock_extended_err *serr = (struct sock_extended_err *)CMSG_DATA( cm );
+	  if ( serr->ee_errno != 0 || serr->ee_origin != SO_EE_ORIGIN_ZEROCOPY ) continue;
+		__atomic_fetch_add( &zerocopyCompleted, serr->ee_data - serr->ee_info + 1, __ATOMIC_RELEASE ); // inclusive range
+		if ( serr->ee_code & SO_EE_CODE_ZEROCOPY_COPIED ) __atomic_fetch_add( &zerocopyCopied, 1, __ATOMIC_RELAXED );
+	} // for
+	return true;
+#else
+	return false;
+#endif // SO_ZEROCOPY
+} // uSocketIO::zerocopyReap
+
+
+// Wait until the zero-copy sends up to sequence number target have completed, returning 0, ZeroCopyTimeout at the
+// deadline (on uClock::monoTime), or the socket error if the socket hangs up or fails first, as no more completions
+// arrive. Only the task holding zerocopyLock harvests completions, so a completion is never harvested by another task
+// between checking the sequence number and blocking on the error-queue descriptor.
+int uSocketIO::zerocopyWait( unsigned int target, const uTime *deadline ) {
+	int status = 0;
+	zerocopyLock.acquire();
+	for ( ;; ) {
+		bool reaped = false;
+		while ( zerocopyReap() ) reaped = true;
+	  if ( (int)(zerocopyCompleted - target) >= 0 ) break; // sequence numbers wrap around
+		if ( ! reaped ) {								// woken without completions ?
+			struct epoll_event event;
+			if ( ::epoll_wait( zerocopyErrFD, &event, 1, 0 ) == 1 && ( event.events & (EPOLLHUP | EPOLLERR) ) ) {
+			  if ( zerocopyReap() ) continue;			// completion arrived after harvesting
+				int errno_ = 0;
+				socklen_t len = sizeof(errno_);
+				::getsockopt( access.fd, SOL_SOCKET, SO_ERROR, &errno_, &len );
+				status = errno_ != 0 ? errno_ : EPIPE;	// hangup without error => peer gone
+				break;
+			} // if
+		} // if
+		timeval t, *tp = nullptr;
+		if ( deadline != nullptr ) {
+			uDuration remaining = *deadline - uClock::monoTime();
+			if ( remaining <= 0 ) {
+				status = ZeroCopyTimeout;
+				break;
+			} // if
+			t = remaining;								// convert to timeval for select
+			tp = &t;
+		} // if
+		if ( uThisCluster().select( zerocopyErrFD, uCluster::ReadSelect, tp ) == 0 ) {
+			status = ZeroCopyTimeout;
+			break;
+		} // if
+	} // for
+	zerocopyLock.release();
+	return status;
+} // uSocketIO::zerocopyWait
+
+
+// Send the data from count with MSG_ZEROCOPY until it is all sent, notification memory is exhausted or the send fails,
+// returning 0, ZeroCopyNoBufs, ZeroCopyTimeout or errno. target is set to the sequence number to wait for before the
+// kernel no longer references the buffer.
+int uSocketIO::zerocopyTransmit( const char *buf, int len, int &count, int flags, uDuration *timeout, unsigned int &target ) {
+	int slen, status = 0;
+
+	struct Send : public uIOClosure {
+		const char *buf;
+		int len;
+		int flags;
+
+		int action() {
+#ifdef __U_STATISTICS__
+			uFetchAdd( UPP::Statistics::write_syscalls, 1 );
+#endif // __U_STATISTICS__
+			return ::send( access.fd, buf, len, flags );
+		}
+		Send( uIOaccess &access, int &slen, int flags ) : uIOClosure( access, slen ), flags( flags ) {}
+	} sendClosure( access, slen, flags | MSG_ZEROCOPY );
+
+	while ( count < len ) {								// ensure all data is sent
+		sendClosure.buf = buf + count;
+		sendClosure.len = len - count;
+		sendClosure.wrapper();
+		if ( slen == -1 && sendClosure.errno_ == ENOBUFS && ( sendClosure.flags & MSG_ZEROCOPY ) ) {
+			// Memory for completion notifications exhausted, so wait for the outstanding sends, or copy if none.
+			if ( __atomic_load_n( &zerocopyCompleted, __ATOMIC_ACQUIRE ) != zerocopySent ) {
+				status = ZeroCopyNoBufs;
+				break;
+			} // if
+			sendClosure.flags &= ~MSG_ZEROCOPY;
+			continue;
+		} // if
+		if ( slen == -1 && sendClosure.errno_ == U_EWOULDBLOCK ) {
+#ifdef __U_STATISTICS__
+			uFetchAdd( UPP::Statistics::write_eagain, 1 );
+#endif // __U_STATISTICS__
+			if ( ! sendClosure.select( uCluster::WriteSelect, timeout ) ) {
+				status = ZeroCopyTimeout;
+				break;
+			} // if
+		} // if
+		if ( slen == -1 ) {
+			status = sendClosure.errno_;
+			break;
+		} // if
+		if ( sendClosure.flags & MSG_ZEROCOPY ) zerocopySent += 1;
+		count += slen;
+	} // while
+	target = zerocopySent;
+	return status;
+} // uSocketIO::zerocopyTransmit
+
+
+int uSocketIO::zerocopySend( const char *buf, int len, int flags, uDuration *timeout, const char *const op ) {
+	unsigned int target;
+	int status;
+	uTime deadline, *until = nullptr;					// completion waits share one deadline
+	if ( timeout != nullptr ) {
+		deadline = uClock::monoTime() + *timeout;
+		until = &deadline;
+	} // if
+
+	for ( int count = 0;; ) {
+		status = zerocopyTransmit( buf, len, count, flags, timeout, target );
+	  if ( status != ZeroCopyNoBufs ) break;
+		status = zerocopyWait( target, until );			// outstanding sends release notification memory
+	  if ( status != 0 ) break;
+	} // for
+	if ( status == 0 ) {
+		status = zerocopyWait( target, until );			// buffer reusable
+	} else {
+		zerocopyWait( target, nullptr );				// kernel may still reference the buffer, returns on hangup
+	} // if
+	if ( status == ZeroCopyTimeout ) writeTimeout( buf, len, flags, nullptr, 0, timeout, op );
+	// EIO means the output is discarded like uFileIO::write.
+	if ( status != 0 && status != EIO ) writeFailure( status, buf, len, flags, nullptr, 0, timeout, op );
+
+#ifdef __U_STATISTICS__
+	uFetchAdd( UPP::Statistics::write_bytes, len );
+#endif // __U_STATISTICS__
+	return len;
+} // uSocketIO::zerocopySend
+
+
+int uSocketIO::setZeroCopy( bool on ) {
+#ifdef SO_ZEROCOPY
+	if ( on && zerocopyErrFD == -1 ) {
+		int fd = ::epoll_create1( EPOLL_CLOEXEC );
+	  if ( fd == -1 ) return -1;
+		struct epoll_event event = { 0, { 0 } };		// no events => only error (queue) and hangup reported
+		if ( ::epoll_ctl( fd, EPOLL_CTL_ADD, access.fd, &event ) == -1 ) {
+			int errno_ = errno;
+			::close( fd );
+			errno = errno_;
+			return -1;
+		} // if
+		zerocopyErrFD = fd;
+	} // if
+	int val = on;
+	if ( ::setsockopt( access.fd, SOL_SOCKET, SO_ZEROCOPY, &val, sizeof(val) ) == -1 ) return -1;
+	zerocopy = on;
+	return 0;
+#else
+	errno = ENOPROTOOPT;
+	return -1;
+#endif // SO_ZEROCOPY
+} // uSocketIO::setZeroCopy
+
+
+uSocketIO::~uSocketIO() {
+	if ( zerocopyErrFD != -1 ) ::close( zerocopyErrFD ); // socket closed by derived class
+} // uSocketIO::~uSocketIO
+
+
+// Every write and writev on the socket, including those made through uFileIO, is combined or sent zero-copy here.
+bool uSocketIO::writeHook( const struct iovec *iov, int iovcnt, uDuration *timeout, const char *const op, int &wlen ) {
+	if ( combining ) {
+		CombineReq req( iov, iovcnt, 0, timeout );
+		combineWrite( req );
+		// Like uFileIO, a single buffer is reported for write and the I/O vector for writev.
+		const char *buf = iovcnt == 1 ? (const char *)iov[0].iov_base : (const char *)iov;
+		int len = iovcnt == 1 ? iov[0].iov_len : iovcnt;
+		if ( req.timedout ) writeTimeout( buf, len, timeout, op );
+		// EIO means the write is to stdout but the shell has terminated, so the output is discarded like uFileIO::write.
+		if ( req.errno_ != 0 && req.errno_ != EIO ) writeFailure( req.errno_, buf, len, timeout, op );
+		wlen = req.len;									// always transfer all the data
+		return true;
+	} // if
+	if ( zerocopy && iovcnt == 1 && iov[0].iov_len >= ZeroCopyMin ) {
+		wlen = zerocopySend( (const char *)iov[0].iov_base, iov[0].iov_len, 0, timeout, op );
+		return true;
+	} // if
+	return false;										// uFileIO writes the data
+} // uSocketIO::writeHook
+
+
 int uSocketIO::send( char *buf, int len, int flags, uDuration *timeout ) {
+	if ( zerocopy && ! combining && len >= ZeroCopyMin ) return zerocopySend( buf, len, flags, timeout, "send" );
+	if ( combining ) {
+		struct iovec iov = { buf, (size_t)len };
+		CombineReq req( &iov, 1, flags, timeout );
+		combineWrite( req );
+		if ( req.timedout ) writeTimeout( buf, len, flags, nullptr, 0, timeout, "send" );
+		if ( req.errno_ != 0 ) writeFailure( req.errno_, buf, len, flags, nullptr, 0, timeout, "send" );
+		return len;
+	} // if
+
 	int slen;
 
 	struct Send : public uIOClosure {
@@ -295,6 +613,150 @@ int uSocketIO::recvmsg( struct msghdr *msg, int flags, uDuration *timeout ) {
 } // uSocketIO::recvmsg
 
 
+int uSocketIO::sendmsg( const struct msghdr *msg, int flags, uDuration *timeout ) {
+	int slen;
+
+	struct Sendmsg : public uIOClosure {
+		const struct msghdr *msg;
+		int flags;
+
+		int action() { return ::sendmsg( access.fd, msg, flags ); }
+		Sendmsg( uIOaccess &access, int &slen, const struct msghdr *msg, int flags ) : uIOClosure( access, slen ), msg( msg ), flags( flags ) {}
+	} sendmsgClosure( access, slen, msg, flags );
+
+	sendmsgClosure.wrapper();
+	if ( slen == -1 && sendmsgClosure.errno_ == U_EWOULDBLOCK ) {
+		if ( ! sendmsgClosure.select( uCluster::WriteSelect, timeout ) ) {
+			writeTimeout( (const char *)msg, 0, flags, nullptr, 0, timeout, "sendmsg" );
+		} // if
+	} // if
+	if ( slen == -1 ) {
+		writeFailure( sendmsgClosure.errno_, (const char *)msg, 0, flags, nullptr, 0, timeout, "sendmsg" );
+	} // if
+
+	return slen;
+} // uSocketIO::sendmsg
+
+
+int uSocketIO::sendmmsg( struct mmsghdr *msgvec, unsigned int vlen, int flags, uDuration *timeout ) {
+	int slen;
+
+	struct Sendmmsg : public uIOClosure {
+		struct mmsghdr *msgvec;
+		unsigned int vlen;
+		int flags;
+
+		int action() {
+#ifdef __U_STATISTICS__
+			uFetchAdd( UPP::Statistics::write_syscalls, 1 );
+#endif // __U_STATISTICS__
+			return ::sendmmsg( access.fd, msgvec, vlen, flags );
+		}
+		Sendmmsg( uIOaccess &access, int &slen, int flags ) : uIOClosure( access, slen ), flags( flags ) {}
+	} sendmmsgClosure( access, slen, flags );
+
+	// Messages without an address are sent from a local copy of the headers with the default send address, so the
+	// caller's headers are not modified and may be shared. Only msg_len is returned in the caller's headers.
+	bool defaults = false;
+	for ( unsigned int i = 0; saddr != nullptr && i < vlen; i += 1 ) {
+		if ( msgvec[i].msg_hdr.msg_name == nullptr ) { defaults = true; break; }
+	} // for
+	enum { Batch = 64 };								// headers copied per sendmmsg
+	struct mmsghdr copy[Batch];
+
+	for ( unsigned int count = 0;; ) {					// ensure all messages are sent
+		sendmmsgClosure.msgvec = msgvec + count;
+		sendmmsgClosure.vlen = vlen - count;
+		if ( defaults ) {
+			if ( sendmmsgClosure.vlen > Batch ) sendmmsgClosure.vlen = Batch;
+			for ( unsigned int i = 0; i < sendmmsgClosure.vlen; i += 1 ) {
+				copy[i] = msgvec[count + i];
+				if ( copy[i].msg_hdr.msg_name == nullptr ) { // default send address
+					copy[i].msg_hdr.msg_name = saddr;
+					copy[i].msg_hdr.msg_namelen = saddrlen;
+				} // if
+			} // for
+			sendmmsgClosure.msgvec = copy;
+		} // if
+		sendmmsgClosure.wrapper();
+		if ( slen == -1 && sendmmsgClosure.errno_ == U_EWOULDBLOCK ) {
+#ifdef __U_STATISTICS__
+			uFetchAdd( UPP::Statistics::write_eagain, 1 );
+#endif // __U_STATISTICS__
+			if ( ! sendmmsgClosure.select( uCluster::WriteSelect, timeout ) ) {
+				writeTimeout( (const char *)msgvec, vlen, flags, nullptr, 0, timeout, "sendmmsg" );
+			} // if
+		} // if
+		if ( slen == -1 ) {
+			writeFailure( sendmmsgClosure.errno_, (const char *)msgvec, vlen, flags, nullptr, 0, timeout, "sendmmsg" );
+		} // if
+		if ( defaults ) {
+			for ( int i = 0; i < slen; i += 1 ) msgvec[count + i].msg_len = copy[i].msg_len;
+		} // if
+		count += slen;
+	  if ( count == vlen ) break;						// transferred across all calls
+	} // for
+
+	return vlen;
+} // uSocketIO::sendmmsg
+
+
+int uSocketIO::recvmmsg( struct mmsghdr *msgvec, unsigned int vlen, int flags, uDuration *timeout ) {
+	int rlen;
+
+	struct Recvmmsg : public uIOClosure {
+		struct mmsghdr *msgvec;
+		unsigned int vlen;
+		int flags;
+
+		int action() {
+#ifdef __U_STATISTICS__
+			uFetchAdd( UPP::Statistics::read_syscalls, 1 );
+#endif // __U_STATISTICS__
+			// socket is non-blocking => return the datagrams already queued, without the system-call timeout
+			return ::recvmmsg( access.fd, msgvec, vlen, flags, nullptr );
+		}
+		Recvmmsg( uIOaccess &access, int &rlen, struct mmsghdr *msgvec, unsigned int vlen, int flags ) : uIOClosure( access, rlen ), msgvec( msgvec ), vlen( vlen ), flags( flags ) {}
+	} recvmmsgClosure( access, rlen, msgvec, vlen, flags );
+
+	recvmmsgClosure.wrapper();
+	if ( rlen == -1 && recvmmsgClosure.errno_ == U_EWOULDBLOCK ) {
+#ifdef __U_STATISTICS__
+		uFetchAdd( UPP::Statistics::read_eagain, 1 );
+#endif // __U_STATISTICS__
+		if ( ! recvmmsgClosure.select( uCluster::ReadSelect, timeout ) ) {
+			readTimeout( (const char *)msgvec, vlen, flags, nullptr, nullptr, timeout, "recvmmsg" );
+		} // if
+	} // if
+	if ( rlen == -1 ) {
+		readFailure( recvmmsgClosure.errno_, (const char *)msgvec, vlen, flags, nullptr, nullptr, timeout, "recvmmsg" );
+	} // if
+
+	return rlen;
+} // uSocketIO::recvmmsg
+
+
+int uSocketIO::setSegmentOffload( int size ) {
+#ifdef UDP_SEGMENT
+	return ::setsockopt( access.fd, SOL_UDP, UDP_SEGMENT, &size, sizeof(size) );
+#else
+	errno = ENOPROTOOPT;
+	return -1;
+#endif // UDP_SEGMENT
+} // uSocketIO::setSegmentOffload
+
+
+int uSocketIO::setReceiveOffload( bool on ) {
+#ifdef UDP_GRO
+	int val = on;
+	return ::setsockopt( access.fd, SOL_UDP, UDP_GRO, &val, sizeof(val) );
+#else
+	errno = ENOPROTOOPT;
+	return -1;
+#endif // UDP_GRO
+} // uSocketIO::setReceiveOffload
+
+
 ssize_t uSocketIO::sendfile( uFile::FileAccess &file, off_t *off, size_t len, uDuration *timeout ) {
 	int ret;
 	off_t wlen;
@@ -406,11 +868,18 @@ void uSocketServer::createSocketServer1( const char *name, int type, int protoco
 } // uSockeServer::createSocketServer1
 
 
-void uSocketServer::createSocketServer2( unsigned short port, int type, int protocol, int backlog ) {
+void uSocketServer::createSocketServer2( unsigned short port, int type, int protocol, int backlog, bool reuseport ) {
 	int retcode;
 
 	baddrlen = saddrlen = sizeof(sockaddr_in);
 
+	if ( reuseport ) {									// share port with other servers ?
+		const int enable = 1;							// 1 => enable option
+		if ( setsockopt( socket.access.fd, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable) ) == -1 ) {
+			openFailure( errno, "", port, ((inetAddr *)saddr)->sin_addr, AF_INET, type, protocol, backlog, "unable to set socket-option" );
+		} // if
+	} // if
+
 	uDEBUGPRT( uDebugPrt( "(uSocketServer &)%p.createSocketServer2 attempting binding to port:%d, ip:0x%08x\n", this, port, ((inetAddr *)saddr)->sin_addr.s_addr ); );
 
 	for ( ;; ) {
@@ -437,8 +906,8 @@ void uSocketServer::createSocketServer2( unsigned short port, int type, int prot
 } // uSocketServer::createSocketServer2
 
 
-void uSocketServer::createSocketServer3( unsigned short *port, int type, int protocol, int backlog ) {
-	createSocketServer2( 0, type, protocol, backlog );	// 0 port number => select an used port
+void uSocketServer::createSocketServer3( unsigned short *port, int type, int protocol, int backlog, bool reuseport ) {
+	createSocketServer2( 0, type, protocol, backlog, reuseport ); // 0 port number => select an used port
 
 	getsockname( saddr, &saddrlen );					// insert unsed port number into address ("bind" does not do it)
 	uDEBUGPRT( uDebugPrt( "(uSocketServer &)%p.createSocketServer3 binding to port:%d\n", this, ntohs( ((sockaddr_in *)saddr)->sin_port ) ); );
@@ -531,7 +1000,7 @@ void uSocketAccept::createSocketAcceptor( uDuration *timeout, struct sockaddr *a
 			uFetchAdd( UPP::Statistics::accept_syscalls, 1 );
 #endif // __U_STATISTICS__
 			if ( len != nullptr ) tmp = *len;			// save *len, as it may be set to 0 after each attempt
-			fd = ::accept( access.fd, adr, len );
+			fd = ::accept4( access.fd, adr, len, SOCK_NONBLOCK | SOCK_CLOEXEC );
 			if ( len != nullptr && *len == 0 ) *len = tmp; // reset *len after each attempt
 			return fd;
 		} // action
@@ -557,11 +1026,10 @@ void uSocketAccept::createSocketAcceptor( uDuration *timeout, struct sockaddr *a
 
 	uDEBUGPRT( uDebugPrt( "(uSocketAccept &)%p.uSocketAccept after accept fd:%d\n", this, access.fd ); );
 
-	// On some UNIX systems the file descriptor created by accept inherits the non-blocking characteristic from the base
-	// socket; on other system this does not seem to occur, so explicitly set the file descriptor to non-blocking.
+	// The file descriptor created by accept does not inherit the non-blocking characteristic from the base socket, so
+	// accept4 creates it non-blocking, avoiding the fcntl calls to set the poll flag.
 
 	access.poll.setStatus( uPoll::AlwaysPoll );
-	access.poll.setPollFlag( access.fd );
 	openAccept = true;
 } // uSocketAccept::createSocketAcceptor
 
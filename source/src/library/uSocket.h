@@ -38,6 +38,7 @@
 #include <sys/socket.h>
 #include <sys/un.h>
 #include <netinet/in.h>
+#include <netinet/udp.h>								// UDP_SEGMENT, UDP_GRO
 
 
 //######################### uSocket #########################
@@ -132,6 +133,54 @@ class uSocketIO : public uFileIO {
 	socklen_t saddrlen;									// size of send address
 	socklen_t baddrlen;									// size of address buffer (UNIX/INET)
 
+	// Write combining: concurrent write/writev/send calls queue their data and the task currently writing to the socket
+	// sends all queued data with one sendmsg, so writers do not serialize on monitor entry for the whole write. Writes
+	// through the uFileIO base class, e.g., by a filebuf or uLog, are combined through writeHook.
+	struct CombineReq : public uColable {
+		const struct iovec *iov;
+		int iovcnt;
+		int len, flags;									// total bytes in iov
+		int written;									// bytes sent
+		int errno_;										// 0 => no error
+		bool timedout;
+		bool done;										// sent or failed, otherwise woken to send queued data
+		uDuration *timeout;
+		UPP::uSemaphore wait;
+
+		CombineReq( const struct iovec *iov, int iovcnt, int flags, uDuration *timeout ) :
+			iov( iov ), iovcnt( iovcnt ), len( 0 ), flags( flags ), written( 0 ), errno_( 0 ), timedout( false ), done( false ), timeout( timeout ), wait( 0 ) {
+			for ( int i = 0; i < iovcnt; i += 1 ) len += iov[i].iov_len;
+		} // CombineReq::CombineReq
+	}; // CombineReq
+
+	enum { CombineIOVMax = 64 };						// maximum requests per sendmsg
+	bool combining;										// write combining enabled ?
+	bool flushing;										// task sending queued data ?
+	uSpinLock combineLock;								// protect flushing and combineQueue
+	uQueue<CombineReq> combineQueue;					// requests not completely sent, in arrival order
+
+	void combineWrite( CombineReq &req );
+	void combineFlush( CombineReq &self );
+
+	// Zero-copy send: large write and send calls transmit with MSG_ZEROCOPY and return when the kernel reports, through
+	// the socket error queue, that it no longer references the user pages, so the buffer may be reused. Data is sent in
+	// the monitor, but completions are waited for outside it, by one task at a time, on an epoll descriptor that is
+	// readable only when the error queue is not empty, because received data also makes the socket readable.
+	enum { ZeroCopyMin = 16 * 1024 };					// smaller transfers are cheaper to copy
+	enum { ZeroCopyTimeout = -1, ZeroCopyNoBufs = -2 };	// zerocopyTransmit/zerocopyWait status, otherwise 0 or errno
+	bool zerocopy;										// zero-copy send enabled ?
+	unsigned int zerocopySent, zerocopyCompleted;		// notification sequence numbers
+	unsigned long int zerocopyCopied;					// notifications where the kernel copied the data
+	int zerocopyErrFD;									// epoll descriptor for error queue, -1 => none
+	uOwnerLock zerocopyLock;							// task harvesting completions
+
+	bool zerocopyReap();
+	int zerocopyWait( unsigned int target, const uTime *deadline );
+	_Mutex int zerocopyTransmit( const char *buf, int len, int &count, int flags, uDuration *timeout, unsigned int &target );
+	int zerocopySend( const char *buf, int len, int flags, uDuration *timeout, const char *const op );
+
+	bool writeHook( const struct iovec *iov, int iovcnt, uDuration *timeout, const char *const op, int &wlen ) override;
+
 	using uFileIO::readFailure;
 	using uFileIO::readTimeout;
 	using uFileIO::writeFailure;
@@ -144,9 +193,35 @@ class uSocketIO : public uFileIO {
 	virtual void sendfileFailure( int errno_, const int in_fd, const off_t *off, const size_t len, const uDuration *timeout ) = 0;
 	virtual void sendfileTimeout( const int in_fd, const off_t *off, const size_t len, const uDuration *timeout ) = 0;
 
-	uSocketIO( uIOaccess &acc, struct sockaddr *saddr ) : uFileIO( acc ), saddr( saddr ) {
+	uSocketIO( uIOaccess &acc, struct sockaddr *saddr ) : uFileIO( acc ), saddr( saddr ), combining( false ), flushing( false ),
+		zerocopy( false ), zerocopySent( 0 ), zerocopyCompleted( 0 ), zerocopyCopied( 0 ), zerocopyErrFD( -1 ) {
 	} // uSocketIO::uSocketIO
+
+	virtual ~uSocketIO();
   public:
+	// Enable before the socket is shared. While enabled, write, writev and send always transfer all the data, and send
+	// flags apply to the combined transfer, so only consecutive requests with the same flags are combined.
+	void setWriteCombining( bool combine ) {
+		combining = combine;
+	} // uSocketIO::setWriteCombining
+
+	bool getWriteCombining() const {
+		return combining;
+	} // uSocketIO::getWriteCombining
+
+	// Enable SO_ZEROCOPY, returning -1 and errno if the socket does not support it (e.g., UNIX domain). While enabled
+	// and write combining is disabled, write and send of at least ZeroCopyMin bytes transfer all the data without
+	// copying it and block until the buffer may be reused.
+	_Mutex int setZeroCopy( bool on );
+
+	bool getZeroCopy() const {
+		return zerocopy;
+	} // uSocketIO::getZeroCopy
+
+	unsigned long int getZeroCopyCopied() const {		// sends the kernel copied anyway, e.g., over loopback
+		return __atomic_load_n( &zerocopyCopied, __ATOMIC_RELAXED );
+	} // uSocketIO::getZeroCopyCopied
+
 	_Mutex const struct sockaddr *getsockaddr() {		// must cast result to sockaddr_in or sockaddr_un
 		return saddr;
 	} // uSocketIO::getsockname
@@ -177,6 +252,18 @@ class uSocketIO : public uFileIO {
 
 	int recvmsg( struct msghdr *msg, int flags = 0, uDuration *timeout = nullptr );
 
+	// Batched datagram I/O: sendmmsg sends all vlen messages, where a message without an address is sent to the default
+	// send address, and only sets msg_len in msgvec; recvmmsg blocks until at least one datagram arrives and returns the
+	// number received (<= vlen).
+	int sendmmsg( struct mmsghdr *msgvec, unsigned int vlen, int flags = 0, uDuration *timeout = nullptr );
+	int recvmmsg( struct mmsghdr *msgvec, unsigned int vlen, int flags = 0, uDuration *timeout = nullptr );
+
+	// UDP segmentation offload: each message sent is split by the kernel into datagrams of size bytes, 0 => off.
+	_Mutex int setSegmentOffload( int size );
+	// UDP receive offload: consecutive datagrams are coalesced into one message, with the segment size in a UDP_GRO
+	// control message.
+	_Mutex int setReceiveOffload( bool on );
+
 	ssize_t sendfile( uFile::FileAccess &file, off_t *off, size_t len, uDuration *timeout = nullptr );
 }; // uSocketIO
 
@@ -199,8 +286,8 @@ _Monitor uSocketServer : public uSocketIO {
 	} // uSocketServer::unacceptor
 
 	void createSocketServer1( const char *name, int type, int protocol, int backlog );
-	void createSocketServer2( unsigned short port, int type, int protocol, int backlog );
-	void createSocketServer3( unsigned short *port, int type, int protocol, int backlog );
+	void createSocketServer2( unsigned short port, int type, int protocol, int backlog, bool reuseport );
+	void createSocketServer3( unsigned short *port, int type, int protocol, int backlog, bool reuseport );
   protected:
 	void readFailure( int errno_, const char *buf, const int len, const uDuration *timeout, const char *const op ) __attribute__ ((noreturn));
 	void readTimeout( const char *buf, const int len, const uDuration *timeout, const char *const op ) __attribute__ ((noreturn));
@@ -311,25 +398,26 @@ _Monitor uSocketServer : public uSocketIO {
 		createSocketServer1( name, type, protocol, backlog );
 	} // uSocketServer::uSocketServer
 
-	// AF_INET, local host
-	uSocketServer( unsigned short port, int type = SOCK_STREAM, int protocol = 0, int backlog = 10 ) :
+	// AF_INET, local host. With reuseport, several servers (e.g., one per cluster) can bind the same port and the kernel
+	// distributes incoming connections among their listening sockets (SO_REUSEPORT).
+	uSocketServer( unsigned short port, int type = SOCK_STREAM, int protocol = 0, int backlog = 10, bool reuseport = false ) :
 	    uSocketIO( socket.access, (sockaddr *)new inetAddr( port, uSocket::itoip( INADDR_ANY ) ) ), socket( AF_INET, type, protocol ) {
-		createSocketServer2( port, type, protocol, backlog );
+		createSocketServer2( port, type, protocol, backlog, reuseport );
 	} // uSocketServer::uSocketServer
 
-	uSocketServer( unsigned short port, in_addr ip, int type = SOCK_STREAM, int protocol = 0, int backlog = 10 ) :
+	uSocketServer( unsigned short port, in_addr ip, int type = SOCK_STREAM, int protocol = 0, int backlog = 10, bool reuseport = false ) :
 	    uSocketIO( socket.access, (sockaddr *)new inetAddr( port, ip ) ), socket( AF_INET, type, protocol ) {
-		createSocketServer2( port, type, protocol, backlog );
+		createSocketServer2( port, type, protocol, backlog, reuseport );
 	} // uSocketServer::uSocketServer
 
-	uSocketServer( unsigned short *port, int type = SOCK_STREAM, int protocol = 0, int backlog = 10 ) :
+	uSocketServer( unsigned short *port, int type = SOCK_STREAM, int protocol = 0, int backlog = 10, bool reuseport = false ) :
 	    uSocketIO( socket.access, (sockaddr *)new inetAddr( 0, uSocket::itoip( INADDR_ANY ) ) ), socket( AF_INET, type, protocol ) {
-		createSocketServer3( port, type, protocol, backlog );
+		createSocketServer3( port, type, protocol, backlog, reuseport );
 	} // uSocketServer::uSocketServer
 
-	uSocketServer( unsigned short *port, in_addr ip, int type = SOCK_STREAM, int protocol = 0, int backlog = 10 ) :
+	uSocketServer( unsigned short *port, in_addr ip, int type = SOCK_STREAM, int protocol = 0, int backlog = 10, bool reuseport = false ) :
 	    uSocketIO( socket.access, (sockaddr *)new inetAddr( 0, ip ) ), socket( AF_INET, type, protocol ) {
-		createSocketServer3( port, type, protocol, backlog );
+		createSocketServer3( port, type, protocol, backlog, reuseport );
 	} // uSocketServer::uSocketServer
 
 	virtual ~uSocketServer() {
@@ -0,0 +1,245 @@
+//                              -*- Mode: C++ -*-
+//
+// uC++ Version 7.0.0, Copyright (C) Peter A. Buhr 2026
+//
+// uBitmapQ.cc -- Bitmap priority entry queue and priority ranking.
+//
+// Author           : agent
+// Created On       : Mon Oct 19 01:19:29 2026
+// Last Modified By : agent
+// Last Modified On : Mon Oct 19 01:19:29 2026
+// Update Count     : 1
+//
+// This  library is free  software; you  can redistribute  it and/or  modify it
+// under the terms of the GNU Lesser General Public License as published by the
+// Free Software  Foundation; either  version 2.1 of  the License, or  (at your
+// option) any later version.
+//
+// This library is distributed in the  hope that it will be useful, but WITHOUT
+// ANY  WARRANTY;  without even  the  implied  warranty  of MERCHANTABILITY  or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+// for more details.
+//
+// You should  have received a  copy of the  GNU Lesser General  Public License
+// along  with this library.
+//
+
+
+
+
+#define __U_KERNEL__
+#include <uC++.h>
+#include <uBitmapQ.h>
+//#include <uDebug.h>
+
+#define uLockAcquired  0
+#define uLockReleased  1
+
+
+uPriorityBitmap::uPriorityBitmap() {
+	for ( int i = 0; i < __U_MAX_NUMBER_PRIORITIES__; i += 1 ) {
+		rank[i] = Unranked;
+	} // for
+	ranked = 0;
+	mask = 0;
+} // uPriorityBitmap::uPriorityBitmap
+
+
+// Give a queue the rank for its new priority value, moving the queues between the old and new ranks by one rank, and
+// their mask bits with them. Queues with equal priority values keep their relative order.
+
+void uPriorityBitmap::rerank( int queueNum, int prio ) {
+	bool nonempty = false;
+	int r = rank[queueNum];
+
+	if ( r != Unranked ) {								// remove from current rank
+		unsigned int low = (1u << r) - 1;
+		nonempty = (mask & (1u << r)) != 0;
+		mask = (mask & low) | ((mask >> 1) & ~low);		// close gap
+		for ( int i = r; i < ranked - 1; i += 1 ) {
+			order[i] = order[i + 1];
+			rank[order[i]] = i;
+		} // for
+		ranked -= 1;
+	} // if
+
+	int pos;
+	for ( pos = ranked; pos > 0 && priority[order[pos - 1]] > prio; pos -= 1 ) { // after queues of equal priority
+		order[pos] = order[pos - 1];
+		rank[order[pos]] = pos;
+	} // for
+	order[pos] = queueNum;
+	rank[queueNum] = pos;
+	priority[queueNum] = prio;
+	ranked += 1;
+
+	unsigned int low = (1u << pos) - 1;
+	mask = (mask & low) | ((mask & ~low) << 1);			// open gap
+	if ( nonempty ) mask |= 1u << pos;
+} // uPriorityBitmap::rerank
+
+
+uBitmapPriorityQ::uBitmapPriorityQ() {
+	executeHooks = true;
+	currPriority = -1;
+	currQueueNum = -1;
+} // uBitmapPriorityQ::uBitmapPriorityQ
+
+
+bool uBitmapPriorityQ::empty() const {
+	return bitmap.empty();
+} // uBitmapPriorityQ::empty
+
+
+uBaseTaskDL *uBitmapPriorityQ::head() const {
+	if ( ! empty() ) {
+		return objects[bitmap.first()].head();
+	} else {
+		return nullptr;
+	} // if
+} // uBitmapPriorityQ::head
+
+
+int uBitmapPriorityQ::add( uBaseTaskDL *node, uBaseTask *owner ) {
+	// Dynamic check to verify that the task being added to entry queue is compliant with PIHeap type.
+	uPIHeap *PIHptr = dynamic_cast<uPIHeap *>(node->task().uPIQ);
+	if ( PIHptr == nullptr ) {
+		abort("(uBitmapPriorityQ &)%p.add : Task %p has incorrect uPIQ type for mutex object.", this, &node->task());
+	} //if
+
+	// check if your priority needs to be updated
+	if ( PIHptr->getHighestPriority() < getActivePriorityValue( node->task() )  ) {
+		uThisCluster().taskSetPriority( node->task(), node->task() );
+	} // if
+
+	int priority = getActivePriorityValue( node->task() );
+	int queueNum = getActiveQueueValue( node->task() ); // use the node for you active priority
+
+	objects[queueNum].add(node);
+	bitmap.set( queueNum, priority );
+
+	// only perform inheritance for entry list
+	if ( isEntryBlocked( node->task() ) && checkHookConditions( *owner, node->task() ) ) {
+		return( afterEntry( owner ) );					// perform any priority inheritance
+	} else {
+		return uLockAcquired;
+	} // if
+} // uBitmapPriorityQ::add
+
+
+uBaseTaskDL *uBitmapPriorityQ::drop() {
+	if ( ! empty() ) {
+		int queueNum = bitmap.first();
+		uBaseTaskDL *pnode = objects[queueNum].drop();
+
+		if ( objects[queueNum].empty() ) {
+			bitmap.clr( queueNum );
+		} // if
+		return pnode;
+	} else {
+		return nullptr;
+	} // if
+} // uBitmapPriorityQ::drop
+
+
+void uBitmapPriorityQ::remove( uBaseTaskDL *node ) {
+	// Use stored queue value because this task has entry lock, so its uPIQ may be updated, but not its position on the
+	// entry queue.
+	int queueNum = getActiveQueueValue( node->task() );	// use the node for you active priority
+
+	objects[queueNum].remove(node);
+	if ( objects[queueNum].empty() ) {
+		bitmap.clr( queueNum );
+	} // if
+} // uBitmapPriorityQ::remove
+
+
+int uBitmapPriorityQ::afterEntry(uBaseTask *owner ) {			// use pointer to owner as it could be Null
+	// Static_cast to PIHeap are valid here as add and onAcquire already verify that the associated tasks use type
+	// uPIHeap.
+
+	// assume entry lock acquired
+	int uRelPrevLock = uLockAcquired;
+
+	// if entry queue empty (called by owner) or no owner, then no inheritance
+	if ( empty() || owner == nullptr /* || currPriority == -1 */ ) {
+		return uRelPrevLock;
+	} // if
+
+	uBaseTask &uCalling = head()->task();				// can't be null as not empty
+
+	// does node need to be updated?
+	if ( uCalling.getActivePriorityValue() < currPriority ) {
+	    // only task with entry lock can be modifying this mutex's node remove node
+		(static_cast<uPIHeap *>(owner->uPIQ))->remove( currPriority, currQueueNum );
+
+		// reset priority value for monitor
+		currPriority = uCalling.getActivePriorityValue();
+		currQueueNum = uCalling.getActiveQueueValue();
+
+	    // update mutex owner's uPIQ for new priority
+		(static_cast<uPIHeap *>(owner->uPIQ))->add( currPriority, currQueueNum ) ;
+
+		// does inheritance occur ?
+		if ( currPriority < owner->getActivePriorityValue() ) {
+
+			uRepositionEntry rep(*owner, uCalling);
+	        // if task is blocked on entry list, adjust and perform transitivity
+			if ( isEntryBlocked( *owner ) ) {
+				uRelPrevLock = rep.uReposition(true);
+			} else {
+	            // call cluster routine to adjust ready queue and active priority Note: can only raise priority to at
+	            // most uCalling, otherwise updating owner's priority can conflit with the owner blocking on an entry
+	            // queue at a particular priority level.  Furthermore, uCalling's priority is fixed while the entry lock
+	            // of where it is blocked (s->lock) is acquired, but uThisTask()'s priority can change as entry lock's
+	            // are released along inheritance chain.
+				uThisCluster().taskSetPriority( *owner, uCalling );
+			} // if
+		} // if
+	} // if
+
+	return uRelPrevLock;
+} // uBitmapPriorityQ::afterEntry
+
+
+void uBitmapPriorityQ::onAcquire(uBaseTask &owner ) {
+	// Dynamic check to verify that the task acquiring the serial is compliant with PIHeap type.
+	uPIHeap *PIHptr = dynamic_cast<uPIHeap *>(owner.uPIQ);
+	if ( PIHptr == nullptr ) {
+		abort("(uBitmapPriorityQ &)%p.onAcquire : Task %p has incorrect uPIQ type for mutex object.", this, &owner);
+	} //if
+
+	// check if mutex owner's priority needs to be updated
+	if ( PIHptr->getHighestPriority() < getActivePriorityValue( owner ) ) {
+		uThisCluster().taskSetPriority( owner, owner );
+	} // if
+
+	// remember current priority value, update task's uPIQ
+	currPriority = owner.getBasePriority();
+	currQueueNum = owner.getBaseQueue();
+	PIHptr->add( currPriority, currQueueNum );
+
+	// perform priority inheritance
+	afterEntry( &owner );
+} // uBitmapPriorityQ::onAcquire
+
+
+void uBitmapPriorityQ::onRelease(uBaseTask &uOldOwner ) {
+	// static_cast to PIHeap are valid here as add and onAcquire already verify that the associated tasks use type
+	// uPIHeap.
+
+	// update task's uPIQ, reset stored values
+	(static_cast<uPIHeap *>(uOldOwner.uPIQ))->remove( currPriority, currQueueNum );
+	currPriority  = -1;
+	currQueueNum = -1;
+
+	// reset active priority if necessary only case where priority can decrease
+	if ( (static_cast<uPIHeap *>(uOldOwner.uPIQ))->empty() ||
+		 (static_cast<uPIHeap *>(uOldOwner.uPIQ))->getHighestPriority() > getActivePriorityValue( uOldOwner ) ) {
+		uThisCluster().taskSetPriority( uOldOwner, uOldOwner );
+	} // if
+} // uBitmapPriorityQ::onRelease
+
+// Local Variables: //
+// compile-command: "make install" //
+// End: //
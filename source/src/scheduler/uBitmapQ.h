@@ -0,0 +1,228 @@
+//                              -*- Mode: C++ -*-
+//
+// uC++ Version 7.0.0, Copyright (C) Peter A. Buhr 2026
+//
+// uBitmapQ.h -- Priority queues indexed by a bitmap of non-empty priority levels.
+//
+// Author           : agent
+// Created On       : Mon Oct 19 01:19:29 2026
+// Last Modified By : agent
+// Last Modified On : Mon Oct 19 06:32:23 2026
+// Update Count     : 3
+//
+// This  library is free  software; you  can redistribute  it and/or  modify it
+// under the terms of the GNU Lesser General Public License as published by the
+// Free Software  Foundation; either  version 2.1 of  the License, or  (at your
+// option) any later version.
+//
+// This library is distributed in the  hope that it will be useful, but WITHOUT
+// ANY  WARRANTY;  without even  the  implied  warranty  of MERCHANTABILITY  or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+// for more details.
+//
+// You should  have received a  copy of the  GNU Lesser General  Public License
+// along  with this library.
+//
+
+
+#pragma once
+
+
+//#include <uDebug.h>
+
+#include <uC++.h>
+#include <uHeapQ.h>										// access: __U_MAX_NUMBER_PRIORITIES__
+#include <uPIHeap.h>
+
+#include <limits.h>
+
+
+// Replacements for uPriorityQ and uPriorityScheduleQ(Seq), where the non-empty queues are found with a find-first-set
+// on a bitmap rather than a heap, so add, drop and remove are O(1). Queue numbers are assigned by the scheduler in
+// arrival order, not priority order, so each queue is given a rank by priority value (lower value => higher priority),
+// and bit r of the mask is set when the queue with rank r is non-empty. Ranks only change when a queue is first used or
+// its priority value changes, which happens when the scheduler assigns priorities (addInitialize), not when tasks are
+// scheduled.
+
+class uPriorityBitmap {
+	enum { Unranked = -1 };
+
+	int priority[__U_MAX_NUMBER_PRIORITIES__];			// queue number => priority value when ranked
+	int rank[__U_MAX_NUMBER_PRIORITIES__];				// queue number => rank
+	int order[__U_MAX_NUMBER_PRIORITIES__];				// rank => queue number
+	int ranked;											// number of ranked queues
+	unsigned int mask;									// bit rank set => queue non-empty
+
+	void rerank( int queueNum, int prio );
+  public:
+	uPriorityBitmap();
+
+	bool empty() const {
+		return mask == 0;
+	} // uPriorityBitmap::empty
+
+	int first() const {									// precondition: ! empty()
+		return order[__builtin_ctz( mask )];
+	} // uPriorityBitmap::first
+
+	void set( int queueNum, int prio ) {
+		if ( rank[queueNum] == Unranked || priority[queueNum] != prio ) rerank( queueNum, prio ); // rare
+		mask |= 1u << rank[queueNum];
+	} // uPriorityBitmap::set
+
+	void clr( int queueNum ) {
+		mask &= ~(1u << rank[queueNum]);
+	} // uPriorityBitmap::clr
+}; // uPriorityBitmap
+
+
+class uBitmapPriorityQ : public uBasePrioritySeq {
+	uBaseTaskSeq objects[__U_MAX_NUMBER_PRIORITIES__];
+	uPriorityBitmap bitmap;
+
+	int currPriority;
+	int currQueueNum;
+  public:
+	uBitmapPriorityQ();
+	virtual bool empty() const;
+	virtual uBaseTaskDL *head() const;
+	virtual int add( uBaseTaskDL *node, uBaseTask *owner );
+	virtual uBaseTaskDL *drop();
+	virtual void remove( uBaseTaskDL *node );
+
+	virtual void transfer( uBaseTaskSeq & /* from */ ) {
+		abort( "uBitmapPriorityQ::transfer, internal error, unsupported operation" );
+	} // uBitmapPriorityQ::transfer
+
+	virtual void onAcquire( uBaseTask &uOwner );
+	virtual void onRelease( uBaseTask &uOwner );
+
+	int afterEntry( uBaseTask *owner );
+}; // uBitmapPriorityQ
+
+
+template<typename List, typename Node> class uBitmapPriorityScheduleQ : public uBaseSchedule<Node> {
+	struct uBitmapScheduleSeq {
+		int priority;
+		List queue;
+	};
+  protected:
+	using uBaseSchedule<Node>::getActiveQueueValue;
+
+	uBitmapScheduleSeq objects[ __U_MAX_NUMBER_PRIORITIES__ ];
+	uPriorityBitmap bitmap;
+  public:
+	uBitmapPriorityScheduleQ() {
+		objects[0].priority = INT_MAX;					// non-real-time tasks, use a large number, syn which addInitialize
+	} // uBitmapPriorityScheduleQ::uBitmapPriorityScheduleQ
+
+	virtual bool empty() const {
+		return bitmap.empty();
+	} // uBitmapPriorityScheduleQ::empty
+
+	virtual Node *head() const {
+		if ( ! empty() ) {
+			return objects[bitmap.first()].queue.head();
+		} else {
+			return nullptr;
+		} // if
+	} // uBitmapPriorityScheduleQ::head
+
+	virtual void add( Node *node ) {
+		int queueNum = getActiveQueueValue( node->task() ); // use the node for you active priority
+
+		objects[queueNum].queue.add(node);
+		bitmap.set( queueNum, objects[queueNum].priority ); // priority may have changed since queue last used
+	} // uBitmapPriorityScheduleQ::add
+
+	virtual Node *drop() {
+		if ( ! empty() ) {
+			int queueNum = bitmap.first();
+			Node *pnode = objects[queueNum].queue.drop();
+
+			if ( objects[queueNum].queue.empty() ) {
+				bitmap.clr( queueNum );
+			} // if
+			return pnode;
+		} else {
+			return nullptr;
+		} // if
+	} // uBitmapPriorityScheduleQ::drop
+
+	virtual bool checkPriority( Node &, Node & ) {
+		return false;
+	} // uBitmapPriorityScheduleQ::checkPriority
+
+	virtual void resetPriority( Node &, Node & ) {
+	} // uBitmapPriorityScheduleQ::resetPriority
+
+	virtual void addInitialize( uBaseTaskSeq & ) {
+	} // uBitmapPriorityScheduleQ::addInitialize
+
+	virtual void removeInitialize( uBaseTaskSeq & ) {
+	} // uBitmapPriorityScheduleQ::removeInitialize
+
+	virtual void rescheduleTask( uBaseTaskDL *, uBaseTaskSeq & ) {
+	} // uBitmapPriorityScheduleQ::rescheduleTask
+}; // uBitmapPriorityScheduleQ
+
+
+template<typename List, typename Node> class uBitmapPriorityScheduleQSeq : public uBitmapPriorityScheduleQ<List, Node> {
+  protected:
+	using uBitmapPriorityScheduleQ<List, Node>::objects;
+	using uBitmapPriorityScheduleQ<List, Node>::bitmap;
+	using uBitmapPriorityScheduleQ<List, Node>::setActivePriority;
+	using uBitmapPriorityScheduleQ<List, Node>::setActiveQueue;
+	using uBitmapPriorityScheduleQ<List, Node>::getActivePriorityValue;
+	using uBitmapPriorityScheduleQ<List, Node>::getActiveQueueValue;
+	using uBitmapPriorityScheduleQ<List, Node>::add;
+  public:
+	virtual bool checkPriority( Node &owner, Node &calling ) {
+		return getActivePriorityValue( owner.task() ) > getActivePriorityValue( calling.task() );
+	} // uBitmapPriorityScheduleQSeq::checkPriority
+
+	virtual void resetPriority( Node &owner, Node &calling ) {
+		int queueNum;
+		uBaseTask &uOwner = owner.task();
+		uBaseTask &uCalling = calling.task();
+		// if same, update owner based on uPIQ
+		if ( &uOwner == &uCalling ) {
+			queueNum = (static_cast<uPIHeap *>(uOwner.uPIQ))->head();
+			// if queue is empty use base priority
+			if ( queueNum == -1 ) {
+				queueNum = uOwner.getBaseQueue();
+			} // if
+		} else {  // otherwise, update to atmost calling task's priority
+			if ( uCalling.getActivePriorityValue() > uOwner.getActivePriorityValue() ) return;
+			queueNum = uCalling.getActiveQueueValue();
+		} // if
+
+		if ( owner.listed() ) {
+			remove( &owner );
+			setActivePriority( uOwner, objects[queueNum].priority );
+			setActiveQueue( uOwner, queueNum );
+			add( &owner );
+		} else {
+			setActivePriority( uOwner, objects[queueNum].priority );
+			setActiveQueue( uOwner, queueNum );
+		} // if
+	} // uBitmapPriorityScheduleQSeq::resetPriority
+
+	virtual void remove( Node *node ) {
+		int queueNum = getActiveQueueValue( node->task() ); // use the node for you active priority
+
+		objects[queueNum].queue.remove(node);
+		if ( objects[queueNum].queue.empty() ) {
+			bitmap.clr( queueNum );
+		} // if
+	} // uBitmapPriorityScheduleQSeq::remove
+
+	virtual void transfer( uBaseTaskSeq & /* from */ ) {
+		abort( "uBitmapPriorityScheduleQSeq::transfer, internal error, unsupported operation" );
+	} // uBitmapPriorityScheduleQSeq::transfer
+}; // uBitmapPriorityScheduleQSeq
+
+
+// Local Variables: //
+// compile-command: "make install" //
+// End: //
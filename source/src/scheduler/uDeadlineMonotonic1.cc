@@ -31,7 +31,7 @@
 //#include <uDebug.h>
 
 
-void uDeadlineMonotonic1::addInitialize( uSequence<uBaseTaskDL> &taskList ) {
+template<typename ReadyQ> void uDeadlineMonotonic1Q<ReadyQ>::addInitialize( uSequence<uBaseTaskDL> &taskList ) {
 	uDEBUGPRT( uDebugPrt( "(uDeadlineMonotonic1 &)%p.addInitialize: enter\n", this ); );
 
 	uBaseTask &task = taskList.tail()->task();
@@ -83,7 +83,7 @@ void uDeadlineMonotonic1::addInitialize( uSequence<uBaseTaskDL> &taskList ) {
 	int tpri = getBasePriority( task );
 	bool flag = false;
 
-	for ( int i = 0; i < num_priorities; i += 1 ) {
+	for ( int i = 0; i < queues; i += 1 ) {
 	  if ( tpri == objects[i].priority ) {
 			flag = true;
 			setBaseQueue( task, i);
@@ -97,12 +97,12 @@ void uDeadlineMonotonic1::addInitialize( uSequence<uBaseTaskDL> &taskList ) {
 	} // for
 
 	if ( ! flag ) {
-		num_priorities += 1;
-		if ( num_priorities <= __U_MAX_NUMBER_PRIORITIES__ ) {
-			objects[num_priorities - 1].priority = tpri;
-			setBaseQueue( task, num_priorities - 1 );
+		queues += 1;
+		if ( queues <= __U_MAX_NUMBER_PRIORITIES__ ) {
+			objects[queues - 1].priority = tpri;
+			setBaseQueue( task, queues - 1 );
 			if ( queueNum == -1 ) {
-				setActiveQueue( task, num_priorities - 1 ); // should have at least t's serial on queue by now
+				setActiveQueue( task, queues - 1 ); // should have at least t's serial on queue by now
 			} else {
 				setActiveQueue( task, queueNum );
 			} // if
@@ -111,23 +111,27 @@ void uDeadlineMonotonic1::addInitialize( uSequence<uBaseTaskDL> &taskList ) {
 				   this, __U_MAX_NUMBER_PRIORITIES__ );
 		} // if
 	} // if
-} // uDeadlineMonotonic1::addInitialize
+} // uDeadlineMonotonic1Q::addInitialize
 
 
-void uDeadlineMonotonic1::removeInitialize( uSequence<uBaseTaskDL> & ) {
+template<typename ReadyQ> void uDeadlineMonotonic1Q<ReadyQ>::removeInitialize( uSequence<uBaseTaskDL> & ) {
 	// Although removing a task may leave a hole in the priorities, the hole should not affect the ability to schedule
 	// the task or the order the tasks execute. Therefore, no rescheduling is performed.
 
 //	addInitialize( taskList );
-} // uDeadlineMonotonic1::removeInitialize
+} // uDeadlineMonotonic1Q::removeInitialize
 
 
-void uDeadlineMonotonic1::rescheduleTask( uBaseTaskDL *taskNode, uBaseTaskSeq &taskList ) {
+template<typename ReadyQ> void uDeadlineMonotonic1Q<ReadyQ>::rescheduleTask( uBaseTaskDL *taskNode, uBaseTaskSeq &taskList ) {
 	//verCount += 1;
 	taskList.remove( taskNode );
 	taskList.addTail( taskNode );
 	addInitialize( taskList );
-} // uDeadlineMonotonic1::rescheduleTask
+} // uDeadlineMonotonic1Q::rescheduleTask
+
+
+template class uDeadlineMonotonic1Q< uPriorityScheduleQSeq<uBaseTaskSeq, uBaseTaskDL> >;
+template class uDeadlineMonotonic1Q< uBitmapPriorityScheduleQSeq<uBaseTaskSeq, uBaseTaskDL> >;
 
 
 // Local Variables: //
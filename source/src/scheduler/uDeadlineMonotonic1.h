@@ -30,14 +30,30 @@
 
 #include <uRealTime.h>
 #include <uHeapQ.h>
+#include <uBitmapQ.h>
 
 
-class uDeadlineMonotonic1 : public uPriorityScheduleQSeq<uBaseTaskSeq, uBaseTaskDL> {
+// Deadline monotonic scheduler over a priority ready queue, uPriorityScheduleQSeq (heap) or uBitmapPriorityScheduleQSeq
+// (bitmap). Both instances are compiled into the library.
+
+template<typename ReadyQ> class uDeadlineMonotonic1Q : public ReadyQ {
+	using ReadyQ::objects;
+	using ReadyQ::getBasePriority;
+	using ReadyQ::setBasePriority;
+	using ReadyQ::setActivePriority;
+	using ReadyQ::setBaseQueue;
+	using ReadyQ::setActiveQueue;
+
+	int queues;											// priority queues assigned, first is always non-real-time tasks
   public:
+	uDeadlineMonotonic1Q() : queues( 1 ) {}
 	void addInitialize( uSequence<uBaseTaskDL> &taskList );
 	void removeInitialize( uSequence<uBaseTaskDL> & );
 	void rescheduleTask( uBaseTaskDL *taskNode, uBaseTaskSeq &taskList );
-}; // uDeadlineMonotonic1
+}; // uDeadlineMonotonic1Q
+
+typedef uDeadlineMonotonic1Q< uPriorityScheduleQSeq<uBaseTaskSeq, uBaseTaskDL> > uDeadlineMonotonic1;
+typedef uDeadlineMonotonic1Q< uBitmapPriorityScheduleQSeq<uBaseTaskSeq, uBaseTaskDL> > uDeadlineMonotonicBitmap;
 
 
 // Local Variables: //
@@ -0,0 +1,82 @@
+//                              -*- Mode: C++ -*-
+//
+// uC++ Version 7.0.0, Copyright (C) Peter A. Buhr 2026
+//
+// uRingScheduler.cc -- FIFO ready queue stored in a circular array.
+//
+// Author           : agent
+// Created On       : Mon Oct 19 01:31:10 2026
+// Last Modified By : agent
+// Last Modified On : Mon Oct 19 06:02:50 2026
+// Update Count     : 2
+//
+// This  library is free  software; you  can redistribute  it and/or  modify it
+// under the terms of the GNU Lesser General Public License as published by the
+// Free Software  Foundation; either  version 2.1 of  the License, or  (at your
+// option) any later version.
+//
+// This library is distributed in the  hope that it will be useful, but WITHOUT
+// ANY  WARRANTY;  without even  the  implied  warranty  of MERCHANTABILITY  or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+// for more details.
+//
+// You should  have received a  copy of the  GNU Lesser General  Public License
+// along  with this library.
+//
+
+#define __U_KERNEL__
+#include <uC++.h>
+#include <uRingScheduler.h>
+
+
+//#include <uDebug.h>
+
+uRingScheduler::uRingScheduler( size_t size ) : list( size ) {}
+
+bool uRingScheduler::empty() const {
+	return list.empty() && overflow.empty();
+} // uRingScheduler::empty
+
+void uRingScheduler::add( uBaseTaskDL *node ) {
+	if ( UNLIKELY( list.full() || ! overflow.empty() ) ) { // no room => no allocation
+		overflow.addTail( node );
+	} else {
+		list.addTail( node );
+	} // if
+} // uRingScheduler::add
+
+uBaseTaskDL *uRingScheduler::drop() {
+	uBaseTaskDL *node = list.dropHead();
+	if ( UNLIKELY( ! overflow.empty() ) ) {				// room for oldest overflow task ?
+		if ( node == nullptr ) return overflow.dropHead();
+		list.addTail( overflow.dropHead() );
+	} // if
+	return node;
+} // uRingScheduler::drop
+
+void uRingScheduler::remove( uBaseTaskDL *node ) {
+	if ( list.has( node ) ) {
+		list.remove( node );
+	} else {
+		overflow.remove( node );
+	} // if
+} // uRingScheduler::remove
+
+void uRingScheduler::transfer( uBaseTaskSeq &from ) {
+	for ( uBaseTaskDL *node = from.dropHead(); node != nullptr; node = from.dropHead() ) add( node );
+} // uRingScheduler::transfer
+
+bool uRingScheduler::checkPriority( uBaseTaskDL &, uBaseTaskDL & ) { return false; }
+
+void uRingScheduler::resetPriority( uBaseTaskDL &, uBaseTaskDL & ) {}
+
+void uRingScheduler::addInitialize( uBaseTaskSeq & ) {};
+
+void uRingScheduler::removeInitialize( uBaseTaskSeq & ) {};
+
+void uRingScheduler::rescheduleTask( uBaseTaskDL *, uBaseTaskSeq & ) {};
+
+
+// Local Variables: //
+// compile-command: "make install" //
+// End: //
@@ -0,0 +1,59 @@
+//                              -*- Mode: C++ -*-
+//
+// uC++ Version 7.0.0, Copyright (C) Peter A. Buhr 2026
+//
+// uRingScheduler.h -- FIFO ready queue stored in a circular array.
+//
+// Author           : agent
+// Created On       : Mon Oct 19 01:31:10 2026
+// Last Modified By : agent
+// Last Modified On : Mon Oct 19 06:02:50 2026
+// Update Count     : 2
+//
+// This  library is free  software; you  can redistribute  it and/or  modify it
+// under the terms of the GNU Lesser General Public License as published by the
+// Free Software  Foundation; either  version 2.1 of  the License, or  (at your
+// option) any later version.
+//
+// This library is distributed in the  hope that it will be useful, but WITHOUT
+// ANY  WARRANTY;  without even  the  implied  warranty  of MERCHANTABILITY  or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+// for more details.
+//
+// You should  have received a  copy of the  GNU Lesser General  Public License
+// along  with this library.
+//
+
+
+#pragma once
+
+
+#include <uC++.h>
+#include <uRing.h>
+
+// Same scheduling as uDefaultScheduler, but adding and dropping a task only touches the ready queue's array and the
+// task's ready node, not the nodes of the neighbouring tasks. The ready queue is accessed in the kernel with interrupts
+// disabled, where the heap must not be called, so the array is never resized. When it is full, later tasks wait on an
+// intrusive sequence, and each drop moves the oldest of them into the array, which keeps FIFO order.
+
+class uRingScheduler : public uBaseSchedule<uBaseTaskDL> {
+	uRing<uBaseTaskDL> list;							// tasks awaiting execution
+	uSequence<uBaseTaskDL> overflow;					// tasks added after list is full, younger than tasks in list
+  public:
+	uRingScheduler( size_t size = 64 );					// array size
+	bool empty() const;
+	void add( uBaseTaskDL *node );
+	uBaseTaskDL *drop();
+	void remove( uBaseTaskDL *node );
+	void transfer( uBaseTaskSeq &from );
+	bool checkPriority( uBaseTaskDL &owner, uBaseTaskDL &calling );
+	void resetPriority( uBaseTaskDL &owner, uBaseTaskDL &calling );
+	void addInitialize( uBaseTaskSeq &taskList );
+	void removeInitialize( uBaseTaskSeq &taskList );
+	void rescheduleTask( uBaseTaskDL *taskNode, uBaseTaskSeq &taskList );
+}; // uRingScheduler
+
+
+// Local Variables: //
+// compile-command: "make install" //
+// End: //